@@ -2,7 +2,15 @@
 #include <string>
 #include <limits>
 #include <stdexcept>
+#include <iomanip>
+#include <vector>
+#include <fstream>
 #include "../../src/services/ServiceClient.h"
+#include "../../src/services/RpcServer.h"
+#include "../../src/persistence/Crc32c.h"
+#include "../../src/persistence/LzBlockFile.h"
+#include "../../src/persistence/MappedFile.h"
+#include "../../src/persistence/SnapshotVerifier.h"
 
 void clearInputBuffer() {
     std::cin.clear();
@@ -22,6 +30,7 @@ void displayAdminMenu() {
     std::cout << "9. Save Complete Election Data\n";
     std::cout << "10. Export to CSV Files\n";
     std::cout << "11. Load Election Data\n";
+    std::cout << "12. Import Voters from CSV\n";
     std::cout << "0. Exit\n";
     std::cout << "Choose an option: ";
 }
@@ -103,7 +112,7 @@ void saveElectionData(ServiceClient& client, int electionId) {
 void saveCompleteElectionData(ServiceClient& client, int electionId) {
     std::string filename;
     clearInputBuffer();
-    std::cout << "Enter filename for complete election data: ";
+    std::cout << "Enter filename for complete election data (end it in .cblz to compress): ";
     std::getline(std::cin, filename);
     
     ServiceResponse response = client.saveCompleteElectionData(electionId, filename);
@@ -141,8 +150,12 @@ void exportToCSV(ServiceClient& client, int electionId) {
     clearInputBuffer();
     std::cout << "Enter base filename for CSV export (without extension): ";
     std::getline(std::cin, baseFilename);
+    std::string answer;
+    std::cout << "Compress the files (.csv.cblz)? (y/N): ";
+    std::getline(std::cin, answer);
+    bool compressed = !answer.empty() && (answer[0] == 'y' || answer[0] == 'Y');
     
-    ServiceResponse response = client.exportElectionToCSV(electionId, baseFilename);
+    ServiceResponse response = client.exportElectionToCSV(electionId, baseFilename, compressed);
     if (response.success) {
         std::cout << "Election data exported to CSV files successfully.\n";
         std::cout << "Files created with base name: " << baseFilename << "\n";
@@ -151,7 +164,161 @@ void exportToCSV(ServiceClient& client, int electionId) {
     }
 }
 
-int main() {
+void importVotersFromCSV(ServiceClient& client, int electionId) {
+    std::string filename;
+    std::cout << "\n--- Import Voters from CSV ---\n";
+    clearInputBuffer();
+    std::cout << "Enter voter roll CSV filename (UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted): ";
+    std::getline(std::cin, filename);
+    
+    ServiceResponse response = client.importVotersFromCSV(electionId, filename);
+    if (response.success) {
+        std::cout << response.message << "\n";
+        for (const auto& line : response.data) {
+            std::cout << "  " << line << "\n";
+        }
+    } else {
+        std::cout << "Failed to import voters: " << response.message << "\n";
+    }
+}
+
+void displayUsage(const char* programName) {
+    std::cout << "Election Administration System\n\n";
+    std::cout << "Usage: " << programName << " [option]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  (no args)                Run the interactive administration menu\n";
+    std::cout << "  --verify <file>...       Check snapshot checksums without loading anything\n";
+    std::cout << "  --threads <count>        Threads used by --verify (default: all cores)\n";
+    std::cout << "  --decompress <in> <out>  Write the plain text of a .cblz snapshot or export\n";
+    std::cout << "  --connect [socket]       Administer the election of a running ClearBallotService --socket\n";
+    std::cout << "                           (default " << RpcServer::DEFAULT_SOCKET_PATH << ")\n";
+    std::cout << "  --help                   Show this help message\n";
+    std::cout << "\n";
+}
+
+// Returns true if every checksummed block in the file is intact
+bool verifySnapshot(const std::string& filename, const SnapshotVerifier::Options& options) {
+    std::cout << "Verifying " << filename << "...\n";
+    SnapshotVerifier::Report report = SnapshotVerifier(options).verifyFile(filename);
+    if (!report.fileOpened) {
+        std::cout << "  [ERROR] Could not open " << filename << "\n";
+        return false;
+    }
+    
+    double megabytes = report.bytes / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Size: " << megabytes << " MiB" << (report.compressed ? " (decompressed)" : "")
+              << ", blocks checked: " << report.blocksChecked;
+    if (report.blocksUnchecked > 0) {
+        std::cout << ", without checksum: " << report.blocksUnchecked;
+    }
+    std::cout << "\n";
+    if (report.seconds > 0.0) {
+        std::cout << "  Time: " << std::setprecision(3) << report.seconds << " s ("
+                  << std::setprecision(0) << megabytes / report.seconds << " MiB/s)\n";
+    }
+    
+    for (const auto& failure : report.failures) {
+        if (failure.truncated) {
+            std::cout << "  [TRUNCATED] " << failure.name << " at byte " << failure.offset
+                      << " (the file ends before it is complete)\n";
+            continue;
+        }
+        std::cout << "  [CORRUPT] " << failure.name << " at byte " << failure.offset
+                  << std::hex << " (expected " << failure.expected << ", computed " << failure.actual
+                  << ")" << std::dec << "\n";
+    }
+    std::cout << (report.ok() ? "  [OK] Snapshot is intact\n" : "  [FAILED] Do not restore from this file\n");
+    return report.ok();
+}
+
+// Decodes a block-compressed snapshot or CSV export to a plain file
+bool decompressFile(const std::string& input, const std::string& output) {
+    MappedFile file;
+    if (!file.open(input)) {
+        std::cout << "Error: Could not open " << input << "\n";
+        return false;
+    }
+    if (!LzBlockFile::isCompressed(file.contents())) {
+        std::cout << "Error: " << input << " is not a compressed file\n";
+        return false;
+    }
+    std::string contents;
+    if (!LzBlockFile::decompress(file.contents(), contents)) {
+        std::cout << "Error: " << input << " is damaged or truncated\n";
+        return false;
+    }
+    std::ofstream out(output, std::ios::binary);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    out.close();
+    if (!out) {
+        std::cout << "Error: Could not write " << output << "\n";
+        return false;
+    }
+    std::cout << "Decompressed " << input << " (" << file.size() << " bytes) to " << output
+              << " (" << contents.size() << " bytes)\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    // Offline verification mode: no service connection needed
+    std::vector<std::string> verifyFiles;
+    SnapshotVerifier::Options verifyOptions;
+    std::string socketPath;  // Empty: run a private in-process service
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            displayUsage(argv[0]);
+            return 0;
+        }
+        else if (arg == "--verify" && i + 1 < argc) {
+            verifyFiles.push_back(argv[++i]);
+            while (i + 1 < argc && argv[i + 1][0] != '-') {
+                verifyFiles.push_back(argv[++i]);
+            }
+        }
+        else if (arg == "--decompress" && i + 2 < argc) {
+            std::string input = argv[i + 1];
+            std::string output = argv[i + 2];
+            return decompressFile(input, output) ? 0 : 2;
+        }
+        else if (arg == "--connect") {
+            socketPath = RpcServer::DEFAULT_SOCKET_PATH;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                socketPath = argv[++i];
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            try {
+                long value = std::stol(argv[++i]);
+                if (value <= 0) {
+                    throw std::out_of_range("not positive");
+                }
+                verifyOptions.threads = static_cast<size_t>(value);
+            } catch (const std::exception&) {
+                std::cout << "Error: Invalid value for --threads: " << argv[i] << "\n\n";
+                displayUsage(argv[0]);
+                return 1;
+            }
+        }
+        else {
+            std::cout << "Error: Unknown option: " << arg << "\n\n";
+            displayUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (!verifyFiles.empty()) {
+        std::cout << "=== Snapshot Verification (CRC32C, "
+                  << (Crc32c::isHardwareAccelerated() ? "hardware" : "software") << ", "
+                  << verifyOptions.threads << " threads) ===\n";
+        bool allIntact = true;
+        for (const auto& filename : verifyFiles) {
+            allIntact = verifySnapshot(filename, verifyOptions) && allIntact;
+        }
+        return allIntact ? 0 : 2;
+    }
+    
     ServiceClient client;
     int electionId;
     
@@ -161,7 +328,8 @@ int main() {
     
     // Connect to the service
     std::cout << "Connecting to ClearBallot service...\n";
-    if (!client.connectToService()) {
+    bool connected = socketPath.empty() ? client.connectToService() : client.connectToService(socketPath);
+    if (!connected) {
         std::cout << "Error: Unable to connect to ClearBallot service.\n";
         std::cout << "Please ensure the service is running and try again.\n";
         return 1;
@@ -169,13 +337,17 @@ int main() {
     std::cout << "Successfully connected to ClearBallot service!\n\n";
     
     // Create or use default election
-    electionId = client.createElection("2024 Local Elections");
-    if (electionId <= 0) {
-        std::cout << "Error: Unable to create election.\n";
-        return 1;
+    if (socketPath.empty()) {
+        electionId = client.createElection("2024 Local Elections");
+        if (electionId <= 0) {
+            std::cout << "Error: Unable to create election.\n";
+            return 1;
+        }
+        std::cout << "Election created with ID: " << electionId << "\n";
+    } else {
+        electionId = -1;  // The service's default election, shared with every connected kiosk
+        std::cout << "Using the election shared by the service.\n";
     }
-    
-    std::cout << "Election created with ID: " << electionId << "\n";
     std::cout << "Administration interface ready.\n\n";
     
     int choice;
@@ -249,6 +421,9 @@ int main() {
             case 11:
                 loadElectionData(client, electionId);
                 break;
+            case 12:
+                importVotersFromCSV(client, electionId);
+                break;
             case 0:
                 std::cout << "Election administration session ended.\n";
                 std::cout << "Saving complete election state...\n";
@@ -0,0 +1,250 @@
+// Load test for the HTTP API: keep-alive connections, each keeping a window
+// of pipelined requests in flight, against an in-process ClearBallotService
+// (default) or a running "ClearBallotService --http" (--port).
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../../src/services/HttpServer.h"
+
+struct LoadOptions {
+    int port = 0;               // 0: start an in-process server
+    size_t connections = 8;
+    size_t pipeline = 16;       // Requests in flight per connection
+    double seconds = 5.0;
+    size_t workers = 0;         // In-process server threads, 0 = one per core
+    int voters = 2000;          // Registered up front in the in-process election
+};
+
+struct ConnectionStats {
+    uint64_t requests = 0;
+    uint64_t ok = 0;
+    uint64_t clientErrors = 0;
+    uint64_t serverErrors = 0;
+    uint64_t failures = 0;      // Connection errors or malformed responses
+    std::vector<double> batchMicros;
+};
+
+// Discards output while the in-process election prints per-vote messages
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+int connectTo(int port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return -1;
+    }
+    int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+// Mix of 1 vote : 2 status lookups : 1 results read, spread over the voter IDs
+std::string buildRequest(uint64_t sequence, int voters) {
+    int voterId = 100000000 + static_cast<int>(sequence % static_cast<uint64_t>(voters));
+    switch (sequence % 4) {
+        case 0: {
+            std::string body = "{\"voterId\":" + std::to_string(voterId) +
+                               ",\"candidateIndex\":" + std::to_string(sequence % 3) + "}";
+            return "POST /elections/default/votes HTTP/1.1\r\nHost: localhost\r\n"
+                   "Content-Type: application/json\r\nContent-Length: " +
+                   std::to_string(body.size()) + "\r\n\r\n" + body;
+        }
+        case 3:
+            return "GET /elections/default/results HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        default:
+            return "GET /elections/default/voters/" + std::to_string(voterId) +
+                   " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    }
+}
+
+// Reads responses until count have arrived; returns false on a broken connection
+bool readResponses(int fd, std::string& buffer, size_t count, ConnectionStats& stats) {
+    char chunk[64 * 1024];
+    while (count > 0) {
+        size_t headerEnd = buffer.find("\r\n\r\n");
+        if (headerEnd != std::string::npos) {
+            size_t lengthAt = buffer.find("Content-Length: ");
+            if (buffer.compare(0, 9, "HTTP/1.1 ") != 0 || lengthAt == std::string::npos || lengthAt > headerEnd) {
+                return false;
+            }
+            size_t length = std::stoul(buffer.substr(lengthAt + 16, 12));
+            size_t total = headerEnd + 4 + length;
+            if (buffer.size() >= total) {
+                int status = std::stoi(buffer.substr(9, 3));
+                ++stats.requests;
+                if (status < 300) {
+                    ++stats.ok;
+                } else if (status < 500) {
+                    ++stats.clientErrors;
+                } else {
+                    ++stats.serverErrors;
+                }
+                buffer.erase(0, total);
+                --count;
+                continue;
+            }
+        }
+        ssize_t bytes = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (bytes <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(bytes));
+    }
+    return true;
+}
+
+void runConnection(const LoadOptions& options, size_t index, std::atomic<bool>& stopFlag, ConnectionStats& stats) {
+    int fd = connectTo(options.port);
+    if (fd < 0) {
+        ++stats.failures;
+        return;
+    }
+    std::string buffer;
+    std::string batch;
+    uint64_t sequence = index * 7919;   // Different voters per connection
+    while (!stopFlag.load()) {
+        batch.clear();
+        for (size_t i = 0; i < options.pipeline; ++i) {
+            batch += buildRequest(sequence++, options.voters);
+        }
+        auto started = std::chrono::steady_clock::now();
+        if (::send(fd, batch.data(), batch.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(batch.size()) ||
+            !readResponses(fd, buffer, options.pipeline, stats)) {
+            ++stats.failures;
+            break;
+        }
+        stats.batchMicros.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - started).count());
+    }
+    ::close(fd);
+}
+
+bool parseArguments(int argc, char* argv[], LoadOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--port") options.port = std::stoi(value);
+            else if (arg == "--connections") options.connections = std::stoul(value);
+            else if (arg == "--pipeline") options.pipeline = std::stoul(value);
+            else if (arg == "--seconds") options.seconds = std::stod(value);
+            else if (arg == "--workers") options.workers = std::stoul(value);
+            else if (arg == "--voters") options.voters = std::stoi(value);
+            else return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return options.connections > 0 && options.pipeline > 0 && options.voters > 0 && options.seconds > 0;
+}
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cout << "Usage: " << argv[0] << " [--port <n>] [--connections <n>] [--pipeline <n>]"
+                  << " [--seconds <s>] [--workers <n>] [--voters <n>]\n"
+                  << "  Without --port an in-process service and server are started.\n";
+        return 1;
+    }
+
+    std::streambuf* console = std::cout.rdbuf();
+    NullBuffer quiet;
+    ClearBallotService service;
+    HttpServer server(service);
+    int electionId = -1;
+    if (options.port == 0) {
+        std::cout.rdbuf(&quiet);
+        service.startService();
+        electionId = service.getDefaultElection();
+        for (int i = 0; i < options.voters; ++i) {
+            service.registerVoter(electionId, VoterRegistrationData("Load", "Tester", "5555550100",
+                                  "1 Benchmark Way", std::to_string(100000000 + i), "30"));
+        }
+        HttpServer::Options serverOptions;
+        serverOptions.port = 0;
+        serverOptions.workerThreads = options.workers;
+        bool started = server.start(serverOptions);
+        std::cout.rdbuf(console);
+        if (!started) {
+            std::cout << "Could not start the HTTP server\n";
+            return 1;
+        }
+        options.port = server.getPort();
+        std::cout << "In-process server on port " << options.port << " with " << server.getWorkerCount()
+                  << " worker(s), " << options.voters << " registered voters\n";
+        std::cout.rdbuf(&quiet);
+    }
+
+    std::vector<ConnectionStats> stats(options.connections);
+    std::vector<std::thread> clients;
+    std::atomic<bool> stopFlag{false};
+    auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options.connections; ++i) {
+        clients.emplace_back(runConnection, std::cref(options), i, std::ref(stopFlag), std::ref(stats[i]));
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+    stopFlag.store(true);
+    for (auto& client : clients) {
+        client.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    server.stop();
+    if (electionId > 0) {
+        service.stopService();
+        std::remove(("election_" + std::to_string(electionId) + "_shutdown.txt").c_str());
+    }
+    std::cout.rdbuf(console);
+
+    ConnectionStats total;
+    for (const auto& s : stats) {
+        total.requests += s.requests;
+        total.ok += s.ok;
+        total.clientErrors += s.clientErrors;
+        total.serverErrors += s.serverErrors;
+        total.failures += s.failures;
+        total.batchMicros.insert(total.batchMicros.end(), s.batchMicros.begin(), s.batchMicros.end());
+    }
+    std::sort(total.batchMicros.begin(), total.batchMicros.end());
+    auto percentile = [&](double p) {
+        if (total.batchMicros.empty()) {
+            return 0.0;
+        }
+        return total.batchMicros[static_cast<size_t>(p * (total.batchMicros.size() - 1))];
+    };
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "Connections: " << options.connections << ", pipeline depth: " << options.pipeline
+              << ", duration: " << std::setprecision(1) << elapsed << " s\n" << std::setprecision(0);
+    std::cout << "Requests: " << total.requests << " (" << total.requests / elapsed << " req/s)\n";
+    std::cout << "  2xx: " << total.ok << ", 4xx: " << total.clientErrors
+              << ", 5xx: " << total.serverErrors << ", connection failures: " << total.failures << "\n";
+    std::cout << "Batch round trip (us): p50 " << percentile(0.50) << ", p99 " << percentile(0.99)
+              << ", max " << percentile(1.0) << "\n";
+    return total.failures == 0 && total.serverErrors == 0 ? 0 : 2;
+}
@@ -1,26 +1,76 @@
 #include "ClearBallotService.h"
+#include "HttpServer.h"
+#include "RpcServer.h"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 // Global service instance and control variables
 std::unique_ptr<ClearBallotService> g_service;
 std::atomic<bool> g_serviceRunning{false};
+std::atomic<int> g_shutdownSignal{0};
+ShutdownCoordinator::Options g_shutdownOptions;
+ClearBallotService::EvictionOptions g_evictionOptions;
+std::unique_ptr<RpcServer> g_rpcServer;
+std::string g_socketPath;  // Empty unless --socket was given
+std::unique_ptr<WorkStealingExecutor> g_rpcExecutor;
+WorkStealingExecutor::Options g_rpcExecutorOptions;
+bool g_rpcExecutorEnabled = false;  // --rpc-workers; otherwise the socket loop runs requests itself
+std::unique_ptr<HttpServer> g_httpServer;
+HttpServer::Options g_httpOptions;
+bool g_httpEnabled = false;
 
-// Signal handler for graceful shutdown
+// Signal handler for graceful shutdown. Only records the signal; the actual
+// shutdown runs on the watcher thread because saving elections is not
+// async-signal-safe.
 void signalHandler(int signum) {
-    std::cout << "\n[SERVICE] Received shutdown signal (" << signum << ")\n";
-    std::cout << "[SERVICE] Initiating graceful shutdown...\n";
-    
-    if (g_service && g_serviceRunning.load()) {
-        g_service->stopService();
-        g_serviceRunning.store(false);
+    g_shutdownSignal.store(signum);
+}
+
+// A flush abandoned at the shutdown deadline is still running on a detached
+// worker that writes through g_service and its entry mutexes. Destroying the
+// service, or running static destructors with std::exit, would pull them out
+// from under it, so the process ends at once instead.
+void exitIfFlushesAbandoned() {
+    if (g_service && g_service->hasAbandonedFlushes()) {
+        std::cout << "[SERVICE] Exiting with election(s) still being saved.\n" << std::flush;
+        std::_Exit(EXIT_FAILURE);
+    }
+}
+
+// Waits for a shutdown signal and performs the graceful shutdown outside signal context
+void shutdownWatcher() {
+    while (g_serviceRunning.load()) {
+        int signum = g_shutdownSignal.load();
+        if (signum != 0) {
+            std::cout << "\n[SERVICE] Received shutdown signal (" << signum << ")\n";
+            std::cout << "[SERVICE] Initiating graceful shutdown...\n";
+            
+            g_serviceRunning.store(false);
+            if (g_rpcServer) {
+                g_rpcServer->stop();
+            }
+            if (g_httpServer) {
+                g_httpServer->stop();
+            }
+            if (g_service) {
+                g_service->stopService();
+                exitIfFlushesAbandoned();
+            }
+            
+            std::cout << "[SERVICE] ClearBallot service stopped.\n";
+            std::exit(0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
-    
-    std::cout << "[SERVICE] ClearBallot service stopped.\n";
-    exit(0);
 }
 
 void displayServiceInfo() {
@@ -42,6 +92,7 @@ void displayServiceCommands() {
     std::cout << "[SERVICE] Available commands:\n";
     std::cout << "  status    - Show service status\n";
     std::cout << "  elections - List all active elections\n";
+    std::cout << "  memory    - Show estimated memory per election and category\n";
     std::cout << "  stop      - Stop the service\n";
     std::cout << "  help      - Show this help\n";
     std::cout << "  quit/exit - Stop the service\n\n";
@@ -55,6 +106,45 @@ void displayServiceStatus() {
     
     std::cout << "[STATUS] ClearBallot Service Status:\n";
     std::cout << "  Running: " << (g_service->isRunning() ? "YES" : "NO") << "\n";
+    if (g_rpcServer) {
+        std::cout << "  Socket: " << g_rpcServer->getSocketPath()
+                  << " (" << g_rpcServer->getConnectionCount() << " clients, "
+                  << g_rpcServer->getRequestsServed() << " requests served)\n";
+    }
+    if (g_rpcExecutor) {
+        std::cout << "  Socket workers: " << g_rpcExecutor->getWorkerCount() << " ("
+                  << g_rpcExecutor->getTasksExecuted() << " requests run, "
+                  << g_rpcExecutor->getTasksStolen() << " stolen)\n";
+    }
+    if (g_httpServer) {
+        std::cout << "  HTTP: port " << g_httpServer->getPort() << ", " << g_httpServer->getWorkerCount()
+                  << " workers (" << g_httpServer->getConnectionCount() << " clients, "
+                  << g_httpServer->getRequestsServed() << " requests served)\n";
+    }
+    
+    auto batching = g_service->getVoteBatchStats();
+    if (batching.batches > 0) {
+        std::cout << "  Votes: " << batching.votes << " in " << batching.batches
+                  << " batches (largest " << batching.largestBatch << ")\n";
+    }
+    
+    auto residency = g_service->getResidencyStats();
+    if (residency.evictions > 0) {
+        std::cout << "  Resident: " << residency.resident << " elections (~" << residency.residentBytes / 1024
+                  << " KiB), " << residency.evicted << " on disk (" << residency.evictions << " evictions, "
+                  << residency.reloads << " reloads)\n";
+    }
+    
+    const std::pair<OperationClass, const char*> classes[] = {
+        {OperationClass::Vote, "vote"}, {OperationClass::Read, "read"},
+        {OperationClass::Write, "write"}, {OperationClass::Bulk, "bulk"}};
+    for (const auto& entry : classes) {
+        auto admission = g_service->getAdmissionStats(entry.first);
+        if (admission.queued > 0 || admission.rejected > 0) {
+            std::cout << "  Admission (" << entry.second << "): " << admission.admitted << " admitted, "
+                      << admission.queued << " after queueing, " << admission.rejected << " refused\n";
+        }
+    }
     
     auto electionIds = g_service->getActiveElectionIds();
     std::cout << "  Active Elections: " << electionIds.size() << "\n";
@@ -85,15 +175,62 @@ void displayActiveElections() {
     
     std::cout << "[INFO] Active Elections:\n";
     for (int electionId : electionIds) {
-        auto election = g_service->getElection(electionId);
-        if (election) {
-            std::cout << "  ID " << electionId << ": " << election->getTitle() << "\n";
-            std::cout << "    Status: Active\n";
-        }
+        // By title only, so listing neither reloads evicted elections nor pins them in memory
+        std::cout << "  ID " << electionId << ": " << g_service->getElectionTitle(electionId) << "\n";
+        std::cout << "    Status: Active\n";
     }
     std::cout << "\n";
 }
 
+void displayMemoryUsage() {
+    if (!g_service) {
+        std::cout << "[ERROR] Service not initialized\n";
+        return;
+    }
+    
+    auto electionIds = g_service->getActiveElectionIds();
+    if (electionIds.empty()) {
+        std::cout << "[INFO] No active elections\n";
+        return;
+    }
+    
+    // Lines are "<Category>: <n> bytes"; shown in KiB, summed across elections
+    std::vector<std::pair<std::string, size_t>> totals;
+    std::cout << "[MEMORY] Estimated memory by election:\n";
+    for (int electionId : electionIds) {
+        ServiceResponse usage = g_service->getMemoryUsage(electionId);
+        if (!usage.success) {
+            continue;
+        }
+        std::cout << "  ID " << electionId << ": " << g_service->getElectionTitle(electionId) << "\n   ";
+        for (const auto& line : usage.data) {
+            size_t separator = line.find(": ");
+            if (separator == std::string::npos || line.size() < 6 || line.compare(line.size() - 6, 6, " bytes") != 0) {
+                std::cout << " " << line << ";";
+                continue;
+            }
+            std::string category = line.substr(0, separator);
+            size_t bytes = std::stoull(line.substr(separator + 2));
+            std::cout << " " << category << " " << (bytes + 1023) / 1024 << " KiB;";
+            auto total = std::find_if(totals.begin(), totals.end(),
+                                      [&](const auto& entry) { return entry.first == category; });
+            if (total == totals.end()) {
+                totals.emplace_back(category, bytes);
+            } else {
+                total->second += bytes;
+            }
+        }
+        std::cout << "\n";
+    }
+    
+    std::cout << "  All elections:";
+    for (const auto& total : totals) {
+        std::cout << " " << total.first << " " << (total.second + 1023) / 1024 << " KiB;";
+    }
+    auto residency = g_service->getResidencyStats();
+    std::cout << "\n  Resident: " << residency.resident << ", evicted to disk: " << residency.evicted << "\n\n";
+}
+
 void processServiceCommand(const std::string& command) {
     if (command == "status") {
         displayServiceStatus();
@@ -101,6 +238,9 @@ void processServiceCommand(const std::string& command) {
     else if (command == "elections") {
         displayActiveElections();
     }
+    else if (command == "memory") {
+        displayMemoryUsage();
+    }
     else if (command == "stop" || command == "quit" || command == "exit") {
         std::cout << "[SERVICE] Stopping service...\n";
         g_serviceRunning.store(false);
@@ -122,7 +262,17 @@ void serviceConsoleLoop() {
     
     while (g_serviceRunning.load()) {
         std::cout << "ClearBallot> ";
-        std::getline(std::cin, command);
+        if (!std::getline(std::cin, command)) {
+            // No console attached: keep serving socket clients until a shutdown signal
+            if (g_rpcServer || g_httpServer) {
+                std::cout << "\n[SERVICE] Console closed; serving network clients until stopped.\n";
+                while (g_serviceRunning.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                }
+            }
+            g_serviceRunning.store(false);
+            break;
+        }
         
         // Trim whitespace
         size_t start = command.find_first_not_of(" \t");
@@ -141,6 +291,8 @@ int runServiceInConsoleMode() {
     
     // Initialize service
     g_service = std::make_unique<ClearBallotService>();
+    g_service->setShutdownOptions(g_shutdownOptions);
+    g_service->setEvictionOptions(g_evictionOptions);
     
     if (!g_service->startService()) {
         std::cout << "[ERROR] Failed to start ClearBallot service\n";
@@ -155,8 +307,28 @@ int runServiceInConsoleMode() {
 #ifdef _WIN32
     signal(SIGBREAK, signalHandler); // Ctrl+Break on Windows
 #endif
+    std::thread watcher(shutdownWatcher);
     
     std::cout << "[SERVICE] ClearBallot service started successfully!\n";
+    if (!g_socketPath.empty()) {
+        if (g_rpcExecutorEnabled) {
+            g_rpcExecutor = std::make_unique<WorkStealingExecutor>(g_rpcExecutorOptions);
+            std::cout << "[SERVICE] Socket requests run on " << g_rpcExecutor->getWorkerCount()
+                      << " work-stealing worker(s)\n";
+        }
+        g_rpcServer = std::make_unique<RpcServer>(*g_service, g_rpcExecutor.get());
+        if (!g_rpcServer->start(g_socketPath)) {
+            std::cout << "[ERROR] Failed to open the service socket\n";
+            g_rpcServer.reset();
+        }
+    }
+    if (g_httpEnabled) {
+        g_httpServer = std::make_unique<HttpServer>(*g_service);
+        if (!g_httpServer->start(g_httpOptions)) {
+            std::cout << "[ERROR] Failed to start the HTTP server\n";
+            g_httpServer.reset();
+        }
+    }
     std::cout << "[SERVICE] Service is ready to accept connections.\n\n";
     
     // Create a demo election for testing
@@ -165,11 +337,23 @@ int runServiceInConsoleMode() {
     
     // Run interactive console
     serviceConsoleLoop();
+    g_serviceRunning.store(false);
+    watcher.join();
     
     // Cleanup
     std::cout << "[SERVICE] Shutting down...\n";
+    if (g_rpcServer) {
+        g_rpcServer->stop();
+        g_rpcServer.reset();
+    }
+    g_rpcExecutor.reset();
+    if (g_httpServer) {
+        g_httpServer->stop();
+        g_httpServer.reset();
+    }
     if (g_service) {
         g_service->stopService();
+        exitIfFlushesAbandoned();
         g_service.reset();
     }
     
@@ -205,6 +389,18 @@ void displayUsage(const char* programName) {
     std::cout << "  --console    Run in console mode\n";
     std::cout << "  --help       Show this help message\n";
     std::cout << "  --version    Show version information\n";
+    std::cout << "  --shutdown-deadline <seconds>  Limit for saving elections on shutdown (default 30)\n";
+    std::cout << "  --shutdown-workers <count>     Threads used to save elections (0 = all cores)\n";
+    std::cout << "  --compress-snapshots           Block-compress shutdown snapshots (*.txt.cblz)\n";
+    std::cout << "  --memory-budget <MiB>          Evict least recently used elections to disk beyond this\n";
+    std::cout << "  --spill-dir <path>             Directory for evicted elections (default .)\n";
+    std::cout << "  --socket [path]                Serve clients on a Unix socket (default "
+              << RpcServer::DEFAULT_SOCKET_PATH << ")\n";
+    std::cout << "  --rpc-workers <count>          Run socket requests on a work-stealing pool (0 = one per core)\n";
+    std::cout << "  --pin-workers                  Pin each --rpc-workers thread to its own CPU\n";
+    std::cout << "  --http [port]                  Serve the JSON API over HTTP/1.1 (default port 8080)\n";
+    std::cout << "  --http-bind <address>          Address for --http (default 127.0.0.1)\n";
+    std::cout << "  --http-workers <count>         HTTP worker threads (0 = one per core)\n";
 #ifdef _WIN32
     std::cout << "  --install    Install as Windows Service (future)\n";
     std::cout << "  --uninstall  Uninstall Windows Service (future)\n";
@@ -214,6 +410,7 @@ void displayUsage(const char* programName) {
     std::cout << "Examples:\n";
     std::cout << "  " << programName << "              # Run in console mode\n";
     std::cout << "  " << programName << " --console    # Run in console mode\n";
+    std::cout << "  " << programName << " --socket     # Share elections with ElectionAdmin/VoterInterface --connect\n";
 #ifdef _WIN32
     std::cout << "  " << programName << " --install    # Install Windows Service\n";
 #endif
@@ -224,8 +421,8 @@ int main(int argc, char* argv[]) {
     displayServiceInfo();
     
     // Parse command line arguments
-    if (argc > 1) {
-        std::string arg = argv[1];
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
         
         if (arg == "--help" || arg == "-h") {
             displayUsage(argv[0]);
@@ -236,7 +433,98 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         else if (arg == "--console") {
-            return runServiceInConsoleMode();
+            // Console mode is the default
+        }
+        else if (arg == "--socket") {
+            g_socketPath = RpcServer::DEFAULT_SOCKET_PATH;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                g_socketPath = argv[++i];
+            }
+        }
+        else if (arg == "--http") {
+            g_httpEnabled = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                try {
+                    int port = std::stoi(argv[++i]);
+                    if (port < 0 || port > 65535) {
+                        throw std::out_of_range("port");
+                    }
+                    g_httpOptions.port = static_cast<uint16_t>(port);
+                } catch (const std::exception&) {
+                    std::cout << "[ERROR] Invalid value for --http: " << argv[i] << "\n\n";
+                    displayUsage(argv[0]);
+                    return 1;
+                }
+            }
+        }
+        else if (arg == "--http-bind" && i + 1 < argc) {
+            g_httpOptions.bindAddress = argv[++i];
+        }
+        else if (arg == "--http-workers" && i + 1 < argc) {
+            try {
+                long value = std::stol(argv[++i]);
+                if (value < 0) {
+                    throw std::out_of_range("negative");
+                }
+                g_httpOptions.workerThreads = static_cast<size_t>(value);
+            } catch (const std::exception&) {
+                std::cout << "[ERROR] Invalid value for --http-workers: " << argv[i] << "\n\n";
+                displayUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--rpc-workers" && i + 1 < argc) {
+            try {
+                long value = std::stol(argv[++i]);
+                if (value < 0) {
+                    throw std::out_of_range("negative");
+                }
+                g_rpcExecutorOptions.workerThreads = static_cast<size_t>(value);
+                g_rpcExecutorEnabled = true;
+            } catch (const std::exception&) {
+                std::cout << "[ERROR] Invalid value for --rpc-workers: " << argv[i] << "\n\n";
+                displayUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--pin-workers") {
+            g_rpcExecutorOptions.pinThreads = true;
+        }
+        else if (arg == "--memory-budget" && i + 1 < argc) {
+            try {
+                long value = std::stol(argv[++i]);
+                if (value < 0) {
+                    throw std::out_of_range("negative");
+                }
+                g_evictionOptions.memoryBudgetBytes = static_cast<size_t>(value) * 1024 * 1024;
+            } catch (const std::exception&) {
+                std::cout << "[ERROR] Invalid value for --memory-budget: " << argv[i] << "\n\n";
+                displayUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--spill-dir" && i + 1 < argc) {
+            g_evictionOptions.spillDirectory = argv[++i];
+        }
+        else if (arg == "--compress-snapshots") {
+            g_shutdownOptions.compressSnapshots = true;
+        }
+        else if ((arg == "--shutdown-deadline" || arg == "--shutdown-workers") && i + 1 < argc) {
+            try {
+                long value = std::stol(argv[++i]);
+                if (value < 0) {
+                    throw std::out_of_range("negative");
+                }
+                if (arg == "--shutdown-deadline") {
+                    g_shutdownOptions.deadline = std::chrono::seconds(value);
+                } else {
+                    g_shutdownOptions.workerThreads = static_cast<size_t>(value);
+                }
+            } catch (const std::exception&) {
+                std::cout << "[ERROR] Invalid value for " << arg << ": " << argv[i] << "\n\n";
+                displayUsage(argv[0]);
+                return 1;
+            }
         }
 #ifdef _WIN32
         else if (arg == "--install") {
@@ -3,6 +3,7 @@
 #include <limits>
 #include <stdexcept>
 #include "../../src/services/ServiceClient.h"
+#include "../../src/services/RpcServer.h"
 
 void clearInputBuffer() {
     std::cin.clear();
@@ -152,7 +153,23 @@ void loadDemoElection(ServiceClient& client, int electionId) {
     std::cout << "Candidates and parties have been configured by election officials.\n\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    std::string socketPath;  // Empty: run a private in-process service
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--connect") {
+            socketPath = RpcServer::DEFAULT_SOCKET_PATH;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                socketPath = argv[++i];
+            }
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--connect [socket]]\n";
+            std::cout << "  --connect  Vote in the election of a running ClearBallotService --socket\n";
+            std::cout << "             (default " << RpcServer::DEFAULT_SOCKET_PATH << ")\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    
     ServiceClient client;
     int electionId;
     
@@ -162,35 +179,41 @@ int main() {
     
     // Connect to the service
     std::cout << "Connecting to ClearBallot service...\n";
-    if (!client.connectToService()) {
+    bool connected = socketPath.empty() ? client.connectToService() : client.connectToService(socketPath);
+    if (!connected) {
         std::cout << "Error: Unable to connect to ClearBallot service.\n";
         std::cout << "Please ensure the service is running and try again.\n";
         return 1;
     }
     std::cout << "Successfully connected to ClearBallot service!\n\n";
     
-    // Create or use default election
-    electionId = client.createElection("2024 Local Elections");
-    if (electionId <= 0) {
-        std::cout << "Error: Unable to create election.\n";
-        return 1;
-    }
-    
-    // Try to load admin-configured election data first
-    std::cout << "Checking for election configuration...\n";
-    ServiceResponse loadResponse = client.loadElectionData(electionId, "shared_election_data.txt");
-    
-    if (!loadResponse.success) {
-        // Try loading admin session data
-        loadResponse = client.loadElectionData(electionId, "admin_session_complete.txt");
-    }
-    
-    if (!loadResponse.success) {
-        std::cout << "No election configuration found. Loading demo election...\n";
-        // Load pre-configured election (simulating that admin has set it up)
-        loadDemoElection(client, electionId);
+    if (!socketPath.empty()) {
+        // The service's default election is shared with the admin console and other kiosks
+        electionId = -1;
     } else {
-        std::cout << "Election configuration loaded from previous session!\n";
+        // Create or use default election
+        electionId = client.createElection("2024 Local Elections");
+        if (electionId <= 0) {
+            std::cout << "Error: Unable to create election.\n";
+            return 1;
+        }
+        
+        // Try to load admin-configured election data first
+        std::cout << "Checking for election configuration...\n";
+        ServiceResponse loadResponse = client.loadElectionData(electionId, "shared_election_data.txt");
+        
+        if (!loadResponse.success) {
+            // Try loading admin session data
+            loadResponse = client.loadElectionData(electionId, "admin_session_complete.txt");
+        }
+        
+        if (!loadResponse.success) {
+            std::cout << "No election configuration found. Loading demo election...\n";
+            // Load pre-configured election (simulating that admin has set it up)
+            loadDemoElection(client, electionId);
+        } else {
+            std::cout << "Election configuration loaded from previous session!\n";
+        }
     }
     
     std::cout << "Election: 2024 Local Elections\n";
@@ -1,15 +1,15 @@
 #include "Candidate.h"
 #include "../regional/Region.h"
 
-Candidate::Candidate(const std::string& name) : name(name), party(nullptr), votes(0), assignedRegion(nullptr) {}
+Candidate::Candidate(const std::string& name) : name(name), party(nullptr), votes(0) {}
 
 Candidate::Candidate(const std::string& name, std::shared_ptr<Party> party) 
-    : name(name), party(party), votes(0), assignedRegion(nullptr) {}
+    : name(name), party(party), votes(0) {}
 
 Candidate::Candidate(const std::string& name, std::shared_ptr<Party> party, std::shared_ptr<Region> region) 
     : name(name), party(party), votes(0), assignedRegion(region) {}
 
-std::string Candidate::getName() const {
+const std::string& Candidate::getName() const {
     return name;
 }
 
@@ -30,7 +30,7 @@ int Candidate::getVoteCount() const {
 }
 
 std::shared_ptr<Region> Candidate::getRegion() const {
-    return assignedRegion;
+    return assignedRegion.lock();
 }
 
 void Candidate::setRegion(std::shared_ptr<Region> region) {
@@ -38,5 +38,5 @@ void Candidate::setRegion(std::shared_ptr<Region> region) {
 }
 
 bool Candidate::isInRegion(std::shared_ptr<Region> region) const {
-    return assignedRegion && region && assignedRegion == region;
+    return region && assignedRegion.lock() == region;
 }
\ No newline at end of file
@@ -14,7 +14,7 @@ class Candidate {
         // Constructor with region assignment
         Candidate(const std::string& name, std::shared_ptr<Party> party, std::shared_ptr<Region> region);
         
-        std::string getName() const;
+        const std::string& getName() const;
         std::shared_ptr<Party> getParty() const;
         void setParty(std::shared_ptr<Party> party);
         void receiveVote();
@@ -29,5 +29,5 @@ class Candidate {
         std::string name;
         std::shared_ptr<Party> party;
         int votes;
-        std::shared_ptr<Region> assignedRegion;
+        std::weak_ptr<Region> assignedRegion;   // Not owning; the region holds its candidates
 };
\ No newline at end of file
@@ -1,20 +1,166 @@
 #include "Election.h"
+#include "../persistence/CsvExportEngine.h"
+#include "../persistence/Crc32c.h"
+#include "../persistence/LzBlockFile.h"
+#include "../persistence/SnapshotVerifier.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 #include <iomanip>
 #include <map>
+#include <sstream>
+#include <array>
+#include <cstdio>
 
-Election::Election(const std::string& title) : title(title) {}
+// Collects the Voter<i>_* lines of one voter while a snapshot is parsed
+class SnapshotVoterLines {
+public:
+    enum Field { FIRST_NAME, LAST_NAME, PHONE, ADDRESS, UNIQUE_ID, AGE, HAS_VOTED, FIELD_COUNT };
+    
+    // Returns true once all fields of the current voter have been seen
+    bool add(std::string_view key, std::string_view value, size_t lineStart, size_t nextLineStart) {
+        static const std::array<std::string_view, FIELD_COUNT> names = {
+            "FirstName", "LastName", "Phone", "Address", "UniqueId", "Age", "HasVoted"
+        };
+        size_t underscorePos = key.find('_');
+        if (key.compare(0, 5, "Voter") != 0 || underscorePos == std::string_view::npos) {
+            return false;
+        }
+        std::string_view index = key.substr(5, underscorePos - 5);
+        auto found = std::find(names.begin(), names.end(), key.substr(underscorePos + 1));
+        if (found == names.end()) {
+            return false;
+        }
+        if (index != currentIndex) {
+            currentIndex = index;
+            seen = 0;
+        }
+        size_t field = static_cast<size_t>(found - names.begin());
+        values[field] = value;
+        lineStarts[field] = lineStart;
+        nextLineStarts[field] = nextLineStart;
+        seen |= 1u << field;
+        if (seen != (1u << FIELD_COUNT) - 1) {
+            return false;
+        }
+        currentIndex = std::string_view();
+        seen = 0;
+        return true;
+    }
+    
+    std::string_view get(Field field) const {
+        return values[field];
+    }
+    
+    // True when the four personal detail lines sit back to back in the order
+    // saveCompleteElectionData writes them, so the store can decode them in place
+    bool detailsInSnapshotOrder() const {
+        return nextLineStarts[FIRST_NAME] == lineStarts[LAST_NAME] &&
+               nextLineStarts[LAST_NAME] == lineStarts[PHONE] &&
+               nextLineStarts[PHONE] == lineStarts[ADDRESS];
+    }
+    
+    size_t detailsOffset() const {
+        return lineStarts[FIRST_NAME];
+    }
+
+private:
+    std::string_view currentIndex;
+    std::array<std::string_view, FIELD_COUNT> values;
+    std::array<size_t, FIELD_COUNT> lineStarts = {};
+    std::array<size_t, FIELD_COUNT> nextLineStarts = {};
+    unsigned seen = 0;
+};
+
+namespace {
+
+// Streams one snapshot section to the file and closes it with a Checksum
+// line covering every byte from the section's header line on
+class SnapshotBlockWriter {
+public:
+    SnapshotBlockWriter(std::ostream& file, const std::string& header) : file(file), crc(0) {
+        buffer << "[" << header << "]\n";
+    }
+    
+    std::ostream& out() {
+        return buffer;
+    }
+    
+    // Keeps the buffer bounded while long sections are written
+    void flushIfLarge() {
+        if (buffer.tellp() >= FLUSH_BYTES) {
+            flush();
+        }
+    }
+    
+    void finish() {
+        flush();
+        file << SnapshotVerifier::checksumLine(crc);
+    }
+
+private:
+    static constexpr std::streamoff FLUSH_BYTES = 256 * 1024;
+    
+    std::ostream& file;
+    std::ostringstream buffer;
+    uint32_t crc;
+    
+    void flush() {
+        std::string chunk = buffer.str();
+        crc = Crc32c::compute(chunk.data(), chunk.size(), crc);
+        file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        buffer.str(std::string());
+    }
+};
+
+// Next line of a snapshot without its terminator; advances position past it
+std::string_view nextSnapshotLine(std::string_view contents, size_t& position) {
+    size_t lineEnd = contents.find('\n', position);
+    if (lineEnd == std::string_view::npos) {
+        lineEnd = contents.size();
+    }
+    std::string_view line = contents.substr(position, lineEnd - position);
+    position = lineEnd + 1;
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);  // Snapshots written in text mode on Windows
+    }
+    return line;
+}
+
+// Heap blocks carry a header, and shared_ptr objects a control block; both are counted as two words
+const size_t ALLOCATION_OVERHEAD = 2 * sizeof(void*);
+
+size_t heapBytes(const std::string& text) {
+    // Short strings live inside the std::string object itself
+    static const size_t inlineCapacity = std::string().capacity();
+    return text.capacity() > inlineCapacity ? text.capacity() + 1 + ALLOCATION_OVERHEAD : 0;
+}
+
+template <typename Set>
+size_t hashIndexBytes(const Set& set, size_t valueBytes) {
+    return set.bucket_count() * sizeof(void*) + set.size() * (valueBytes + sizeof(void*) + ALLOCATION_OVERHEAD);
+}
+
+// Voters, or snapshot lines, handled between progress reports
+constexpr size_t PROGRESS_INTERVAL = 4096;
+// Rendered snapshots are written in slices of this size so progress can be reported
+constexpr size_t WRITE_SLICE_BYTES = 1024 * 1024;
+
+} // namespace
+
+Election::Election(const std::string& title)
+    : title(title),
+      voterStore(std::make_shared<VoterStore>()),
+      candidateArena(std::make_shared<ObjectArena<Candidate>>()) {}
 
 // Candidate management
 void Election::addCandidate(const std::string& name) {
-    candidates.push_back(std::make_unique<Candidate>(name));
+    candidates.push_back(candidateArena->create(name));
     std::cout << "Independent candidate '" << name << "' added successfully.\n";
 }
 
 void Election::addCandidate(const std::string& name, std::shared_ptr<Party> party) {
-    candidates.push_back(std::make_unique<Candidate>(name, party));
+    candidates.push_back(candidateArena->create(name, party));
     party->addMember(name);
     std::cout << "Candidate '" << name << "' added to party '" << party->getName() << "'.\n";
 }
@@ -57,13 +203,20 @@ std::shared_ptr<Region> Election::createRegion(const std::string& name, const st
         }
     }
     
+    if (regions.size() >= VoterStore::MAX_REGIONS) {
+        std::cout << "Error: An election can have at most " << VoterStore::MAX_REGIONS << " regions.\n";
+        return nullptr;
+    }
     auto region = std::make_shared<Region>(name, code);
+    region->attachVoterStore(voterStore);
     regions.push_back(region);
+    regionBlocks.emplace_back();
     std::cout << "Region '" << name << "' (Code: " << code << ") created successfully.\n";
     return region;
 }
 
 void Election::displayRegions() const {
+    ensureAllRegionsLoaded();
     if (regions.empty()) {
         std::cout << "No regions created.\n";
         return;
@@ -82,13 +235,15 @@ std::shared_ptr<Region> Election::getRegionByIndex(size_t index) const {
     if (index == 0 || index > regions.size()) {
         return nullptr;
     }
+    ensureRegionLoaded(index - 1);
     return regions[index - 1];
 }
 
 std::shared_ptr<Region> Election::getRegionByCode(const std::string& code) const {
-    for (const auto& region : regions) {
-        if (region->getCode() == code) {
-            return region;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (regions[i]->getCode() == code) {
+            ensureRegionLoaded(i);
+            return regions[i];
         }
     }
     return nullptr;
@@ -102,13 +257,14 @@ bool Election::addCandidateToRegion(const std::string& name, std::shared_ptr<Reg
     }
     
     // Check if candidate already exists in ANY region (global restriction)
+    ensureAllRegionsLoaded();
     if (globalCandidateRegistry.find(name) != globalCandidateRegistry.end()) {
         std::cout << "Error: Candidate '" << name << "' is already registered in another region.\n";
         std::cout << "Same candidate cannot be enlisted in multiple regions.\n";
         return false;
     }
     
-    auto candidate = std::make_shared<Candidate>(name, nullptr, region);
+    auto candidate = ObjectArena<Candidate>::share(candidateArena, candidateArena->create(name, nullptr, region));
     if (region->addCandidate(candidate)) {
         // Add to global registry
         globalCandidateRegistry[name].insert(region->getCode());
@@ -126,6 +282,7 @@ bool Election::addCandidateToRegion(const std::string& name, std::shared_ptr<Par
     }
     
     // Check if candidate already exists in ANY region (global restriction)
+    ensureAllRegionsLoaded();
     if (globalCandidateRegistry.find(name) != globalCandidateRegistry.end()) {
         std::cout << "Error: Candidate '" << name << "' is already registered in another region.\n";
         std::cout << "Same candidate cannot be enlisted in multiple regions.\n";
@@ -140,7 +297,7 @@ bool Election::addCandidateToRegion(const std::string& name, std::shared_ptr<Par
         return false;
     }
     
-    auto candidate = std::make_shared<Candidate>(name, party, region);
+    auto candidate = ObjectArena<Candidate>::share(candidateArena, candidateArena->create(name, party, region));
     if (region->addCandidate(candidate)) {
         party->addMember(name);
         // Add to global registry
@@ -159,44 +316,26 @@ bool Election::registerVoter(const std::string& firstName, const std::string& la
     
     std::cout << "\n=== Validating Voter Registration Data ===\n";
     
-    // Comprehensive input validation
-    std::string validationErrors = InputValidator::validateVoterInput(
-        firstName, lastName, phoneNumber, address, uniqueIdStr, ageStr);
+    // Comprehensive input validation; the checks also convert the ID and age
+    int uniqueId = 0, age = 0;
+    InputValidator::Failures failures = validationRules->checkVoterInput(
+        firstName, lastName, phoneNumber, address, uniqueIdStr, ageStr, &uniqueId, &age);
     
-    if (!validationErrors.empty()) {
-        std::cout << "\n[VALIDATION FAILED]\n" << validationErrors;
+    if (!failures.ok()) {
+        std::cout << "\n[VALIDATION FAILED]\n" << validationRules->describe(failures);
         std::cout << "\nPlease correct the above errors and try again.\n";
         return false;
     }
     
-    // Convert validated strings to appropriate types
-    int uniqueId, age;
-    try {
-        uniqueId = std::stoi(InputValidator::trim(uniqueIdStr));
-        age = std::stoi(InputValidator::trim(ageStr));
-    } catch (const std::exception&) {
-        std::cout << "[ERROR] Invalid number format in ID or age.\n";
-        return false;
-    }
-    
     // Check for duplicate voter ID
-    if (registeredVoterIds.count(uniqueId) > 0) {
+    if (isVoterRegistered(uniqueId)) {
         std::cout << "[ERROR] Voter with ID " << uniqueId << " already exists.\n";
         return false;
     }
     
     // All validations passed - register the voter
-    auto voter = std::make_unique<Voter>(
-        InputValidator::trim(firstName), 
-        InputValidator::trim(lastName), 
-        InputValidator::trim(phoneNumber), 
-        InputValidator::trim(address), 
-        uniqueId, 
-        age
-    );
-    
-    voters.push_back(std::move(voter));
-    registeredVoterIds.insert(uniqueId);
+    addVoter(InputValidator::trimView(firstName), InputValidator::trimView(lastName),
+             InputValidator::trimView(phoneNumber), InputValidator::trimView(address), uniqueId, age, nullptr);
     
     std::cout << "\n[SUCCESS] Voter '" << firstName << " " << lastName 
               << "' registered successfully with ID: " << uniqueId << "\n";
@@ -213,6 +352,20 @@ bool Election::registerVoter(const std::string& firstName, const std::string& la
                         std::to_string(uniqueId), std::to_string(age));
 }
 
+bool Election::importVoter(std::string_view firstName, std::string_view lastName,
+                           std::string_view phoneNumber, std::string_view address,
+                           int uniqueId, int age, bool hasVoted) {
+    if (isVoterRegistered(uniqueId)) {
+        return false;
+    }
+    
+    Voter* voter = voterStore->at(addVoter(firstName, lastName, phoneNumber, address, uniqueId, age, nullptr));
+    if (hasVoted) {
+        voter->markAsVoted();
+    }
+    return true;
+}
+
 // Regional voter registration
 bool Election::registerVoterInRegion(const std::string& firstName, const std::string& lastName,
                                      const std::string& phoneNumber, const std::string& address,
@@ -225,46 +378,30 @@ bool Election::registerVoterInRegion(const std::string& firstName, const std::st
     
     std::cout << "\n=== Validating Voter Registration Data for Region: " << region->getName() << " ===\n";
     
-    // Comprehensive input validation
-    std::string validationErrors = InputValidator::validateVoterInput(
-        firstName, lastName, phoneNumber, address, uniqueIdStr, ageStr);
+    // Comprehensive input validation; the checks also convert the ID and age
+    int uniqueId = 0, age = 0;
+    InputValidator::Failures failures = validationRules->checkVoterInput(
+        firstName, lastName, phoneNumber, address, uniqueIdStr, ageStr, &uniqueId, &age);
     
-    if (!validationErrors.empty()) {
-        std::cout << "\n[VALIDATION FAILED]\n" << validationErrors;
+    if (!failures.ok()) {
+        std::cout << "\n[VALIDATION FAILED]\n" << validationRules->describe(failures);
         std::cout << "\nPlease correct the above errors and try again.\n";
         return false;
     }
     
-    // Convert validated strings to appropriate types
-    int uniqueId, age;
-    try {
-        uniqueId = std::stoi(InputValidator::trim(uniqueIdStr));
-        age = std::stoi(InputValidator::trim(ageStr));
-    } catch (const std::exception&) {
-        std::cout << "[ERROR] Invalid number format in ID or age.\n";
-        return false;
-    }
-    
     // Check for duplicate voter ID globally
-    if (registeredVoterIds.count(uniqueId) > 0) {
+    if (isVoterRegistered(uniqueId)) {
         std::cout << "[ERROR] Voter with ID " << uniqueId << " already exists.\n";
         return false;
     }
     
     // Create voter with region assignment
-    auto voter = std::make_shared<Voter>(
-        InputValidator::trim(firstName), 
-        InputValidator::trim(lastName), 
-        InputValidator::trim(phoneNumber), 
-        InputValidator::trim(address), 
-        uniqueId, 
-        age,
-        region
-    );
-    
-    // Add voter to region
-    region->addVoter(voter);
-    registeredVoterIds.insert(uniqueId);
+    VoterStore::Position position = addVoter(InputValidator::trimView(firstName), InputValidator::trimView(lastName),
+                                             InputValidator::trimView(phoneNumber), InputValidator::trimView(address),
+                                             uniqueId, age, region);
+    
+    // The region lists the voter by its place in the election's store
+    region->addVoter(position);
     
     std::cout << "\n[SUCCESS] Voter '" << firstName << " " << lastName 
               << "' registered successfully in region '" << region->getName() 
@@ -282,6 +419,13 @@ bool Election::castVote(int voterId, int candidateIndex) {
         return false;
     }
     
+    // Regional voters choose among their region's candidates
+    if (auto region = voter->getRegion()) {
+        std::cout << "Voting failed: Voter " << voter->getFullName() << " is registered in region '"
+                  << region->getName() << "' and must vote there.\n";
+        return false;
+    }
+    
     // Check if voter has already voted
     if (voter->hasVoted()) {
         std::cout << "Voting failed: Voter " << voter->getFullName() << " has already voted.\n";
@@ -311,29 +455,14 @@ bool Election::castVoteInRegion(int voterId, int candidateIndex, std::shared_ptr
     }
     
     // Check if voter can vote in this region
-    if (!region->canVoterVoteInRegion(voterId)) {
+    Voter* voter = findVoterByUniqueId(voterId);
+    if (!voter || !voter->canVoteInRegion(region)) {
         std::cout << "Voting failed: Voter with ID " << voterId 
                   << " is not registered to vote in region '" << region->getName() << "'.\n";
         std::cout << "Voters can only vote in their assigned region.\n";
         return false;
     }
     
-    // Find voter in region
-    const auto& votersInRegion = region->getVoters();
-    std::shared_ptr<Voter> voter = nullptr;
-    for (const auto& v : votersInRegion) {
-        if (v->getUniqueId() == voterId) {
-            voter = v;
-            break;
-        }
-    }
-    
-    if (!voter) {
-        std::cout << "Voting failed: Voter with ID " << voterId 
-                  << " not found in region '" << region->getName() << "'.\n";
-        return false;
-    }
-    
     // Check if voter has already voted
     if (voter->hasVoted()) {
         std::cout << "Voting failed: Voter " << voter->getFullName() << " has already voted.\n";
@@ -377,17 +506,21 @@ void Election::displayCandidates() const {
 }
 
 void Election::displayVoters() const {
+    const auto& voters = getVoters();
     if (voters.empty()) {
         std::cout << "No voters registered.\n";
         return;
     }
     
     std::cout << "\n=== Registered Voters ===\n";
-    for (const auto& voter : voters) {
+    for (const Voter* voter : voters) {
         std::cout << "ID: " << voter->getUniqueId() 
                   << " | " << voter->getFullName() 
-                  << " | Age: " << voter->getAge()
-                  << " | Voted: " << (voter->hasVoted() ? "Yes" : "No") << "\n";
+                  << " | Age: " << voter->getAge();
+        if (auto region = voter->getRegion()) {
+            std::cout << " | Region: " << region->getCode();
+        }
+        std::cout << " | Voted: " << (voter->hasVoted() ? "Yes" : "No") << "\n";
     }
 }
 
@@ -406,7 +539,7 @@ void Election::displayResults() const {
     }
     
     std::cout << "Total votes cast: " << totalVotes << "\n";
-    std::cout << "Total registered voters: " << voters.size() << "\n\n";
+    std::cout << "Total registered voters: " << registeredVoterCount() << "\n\n";
     
     // Display results sorted by vote count
     std::vector<std::pair<int, std::string>> results;
@@ -510,7 +643,7 @@ void Election::saveResultsToFile(const std::string& filename) const {
     }
     
     file << "Total votes cast: " << totalVotes << "\n";
-    file << "Total registered voters: " << voters.size() << "\n\n";
+    file << "Total registered voters: " << registeredVoterCount() << "\n\n";
     
     for (const auto& candidate : candidates) {
         file << candidate->getName();
@@ -527,180 +660,345 @@ void Election::saveResultsToFile(const std::string& filename) const {
 }
 
 // Complete data persistence
-void Election::saveCompleteElectionData(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+bool Election::saveCompleteElectionData(const std::string& filename) const {
+    return saveCompleteElectionData(filename, isCompressedSnapshotName(filename));
+}
+
+bool Election::saveCompleteElectionData(const std::string& filename, bool compressed) const {
+    ensureAllRegionsLoaded();
+    return writeSnapshotFile(filename, compressed, [this](std::ostream& file) { writeSnapshot(file); });
+}
+
+std::string Election::renderCompleteElectionData(const Progress& progress) const {
+    ensureAllRegionsLoaded();
+    std::ostringstream text;
+    writeSnapshot(text, progress);
+    return std::move(text).str();
+}
+
+bool Election::saveRenderedElectionData(const std::string& filename, const std::string& contents,
+                                        const Progress& progress) {
+    return writeSnapshotFile(filename, isCompressedSnapshotName(filename), [&](std::ostream& file) {
+        for (size_t written = 0; written < contents.size() && file;) {
+            size_t slice = std::min(WRITE_SLICE_BYTES, contents.size() - written);
+            file.write(contents.data() + written, static_cast<std::streamsize>(slice));
+            written += slice;
+            if (progress) {
+                progress(written, contents.size());
+            }
+        }
+    });
+}
+
+bool Election::isCompressedSnapshotName(const std::string& filename) {
+    const std::string_view extension = LzBlockFile::FILE_EXTENSION;
+    return filename.size() > extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+bool Election::writeSnapshotFile(const std::string& filename, bool compressed,
+                                 const std::function<void(std::ostream&)>& writeContents) {
+    // Written beside the target and renamed over it: voters loaded from a snapshot read their
+    // details from its mapping, so the file they came from must never be rewritten in place.
+    // Binary mode keeps the region block offsets exact on every platform.
+    const std::string tempFilename = filename + ".tmp";
+    std::ofstream output(tempFilename, std::ios::binary);
+    if (!output.is_open()) {
         std::cout << "Error: Could not open file " << filename << " for writing.\n";
-        return;
+        return false;
+    }
+    // Offsets and checksums describe the uncompressed text either way
+    LzBlockStreamBuf compressor(output.rdbuf());
+    std::ostream file(compressed ? static_cast<std::streambuf*>(&compressor) : output.rdbuf());
+    writeContents(file);
+    
+    file.flush();
+    bool written = file.good() && (!compressed || compressor.finish());
+    output.close();
+    if (!written || !output) {
+        std::cout << "Error: Could not write " << filename << ".\n";
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(filename.c_str());  // rename does not replace on Windows; nothing is mapped there
+#endif
+    if (std::rename(tempFilename.c_str(), filename.c_str()) != 0) {
+        std::cout << "Error: Could not replace " << filename << ".\n";
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+    std::cout << "Complete election data saved to " << filename << "\n";
+    return true;
+}
+
+void Election::writeSnapshot(std::ostream& file, const Progress& progress) const {
+    // Regional voters are written with their region's block
+    std::vector<const Voter*> globalVoters;
+    for (const Voter* voter : voterStore->all()) {
+        if (!voter->getRegion()) {
+            globalVoters.push_back(voter);
+        }
     }
+    // Counted in global voters and region blocks rendered
+    const size_t totalWork = globalVoters.size() + regions.size();
     
     file << "COMPLETE_ELECTION_DATA\n";
     file << "======================\n\n";
     
     // Save election metadata
-    file << "[ELECTION_INFO]\n";
-    file << "Title=" << title << "\n";
-    file << "TotalCandidates=" << candidates.size() << "\n";
-    file << "TotalVoters=" << voters.size() << "\n";
-    file << "TotalParties=" << parties.size() << "\n\n";
+    {
+        SnapshotBlockWriter section(file, "ELECTION_INFO");
+        section.out() << "Title=" << title << "\n";
+        section.out() << "ValidationRules=" << validationRules->getName() << "\n";
+        section.out() << "TotalCandidates=" << candidates.size() << "\n";
+        section.out() << "TotalVoters=" << globalVoters.size() << "\n";
+        section.out() << "TotalParties=" << parties.size() << "\n";
+        section.finish();
+    }
+    file << "\n";
     
     // Save parties
-    file << "[PARTIES]\n";
-    for (size_t i = 0; i < parties.size(); ++i) {
-        file << "Party" << i << "=" << parties[i]->getName() << "\n";
-        file << "Party" << i << "_Members=";
-        const auto& members = parties[i]->getMembers();
-        for (size_t j = 0; j < members.size(); ++j) {
-            file << members[j];
-            if (j < members.size() - 1) file << ";";
+    {
+        SnapshotBlockWriter section(file, "PARTIES");
+        for (size_t i = 0; i < parties.size(); ++i) {
+            section.out() << "Party" << i << "=" << parties[i]->getName() << "\n";
+            section.out() << "Party" << i << "_Members=";
+            const auto& members = parties[i]->getMembers();
+            for (size_t j = 0; j < members.size(); ++j) {
+                section.out() << members[j];
+                if (j < members.size() - 1) section.out() << ";";
+            }
+            section.out() << "\n";
         }
-        file << "\n";
+        section.finish();
     }
     file << "\n";
     
     // Save candidates
-    file << "[CANDIDATES]\n";
-    for (size_t i = 0; i < candidates.size(); ++i) {
-        file << "Candidate" << i << "_Name=" << candidates[i]->getName() << "\n";
-        file << "Candidate" << i << "_Votes=" << candidates[i]->getVoteCount() << "\n";
-        if (candidates[i]->getParty()) {
-            file << "Candidate" << i << "_Party=" << candidates[i]->getParty()->getName() << "\n";
-        } else {
-            file << "Candidate" << i << "_Party=Independent\n";
+    {
+        SnapshotBlockWriter section(file, "CANDIDATES");
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            section.out() << "Candidate" << i << "_Name=" << candidates[i]->getName() << "\n";
+            section.out() << "Candidate" << i << "_Votes=" << candidates[i]->getVoteCount() << "\n";
+            if (candidates[i]->getParty()) {
+                section.out() << "Candidate" << i << "_Party=" << candidates[i]->getParty()->getName() << "\n";
+            } else {
+                section.out() << "Candidate" << i << "_Party=Independent\n";
+            }
         }
+        section.finish();
     }
     file << "\n";
     
     // Save voters
-    file << "[VOTERS]\n";
-    for (size_t i = 0; i < voters.size(); ++i) {
-        const auto& voter = voters[i];
-        file << "Voter" << i << "_FirstName=" << voter->getFirstName() << "\n";
-        file << "Voter" << i << "_LastName=" << voter->getLastName() << "\n";
-        file << "Voter" << i << "_Phone=" << voter->getPhoneNumber() << "\n";
-        file << "Voter" << i << "_Address=" << voter->getAddress() << "\n";
-        file << "Voter" << i << "_UniqueId=" << voter->getUniqueId() << "\n";
-        file << "Voter" << i << "_Age=" << voter->getAge() << "\n";
-        file << "Voter" << i << "_HasVoted=" << (voter->hasVoted() ? "1" : "0") << "\n";
+    {
+        SnapshotBlockWriter section(file, "VOTERS");
+        for (size_t i = 0; i < globalVoters.size(); ++i) {
+            const Voter* voter = globalVoters[i];
+            Voter::PhoneDigits phoneDigits;
+            VoterPiiStore::Record details = voter->getPersonalDetails(phoneDigits);
+            std::ostream& out = section.out();
+            out << "Voter" << i << "_FirstName=" << details.firstName << "\n";
+            out << "Voter" << i << "_LastName=" << details.lastName << "\n";
+            out << "Voter" << i << "_Phone=" << details.phoneNumber << "\n";
+            out << "Voter" << i << "_Address=" << details.address << "\n";
+            out << "Voter" << i << "_UniqueId=" << voter->getUniqueId() << "\n";
+            out << "Voter" << i << "_Age=" << voter->getAge() << "\n";
+            out << "Voter" << i << "_HasVoted=" << (voter->hasVoted() ? "1" : "0") << "\n";
+            section.flushIfLarge();
+            if (progress && (i + 1) % PROGRESS_INTERVAL == 0) {
+                progress(i + 1, totalWork);
+            }
+        }
+        section.finish();
     }
     file << "\n";
     
     // Save voting summary
-    file << "[VOTING_SUMMARY]\n";
-    int totalVotes = 0;
-    for (const auto& candidate : candidates) {
-        totalVotes += candidate->getVoteCount();
-    }
-    file << "TotalVotesCast=" << totalVotes << "\n";
-    file << "VoterTurnout=" << std::fixed << std::setprecision(2) 
-         << (voters.size() > 0 ? (static_cast<double>(totalVotes) / voters.size()) * 100.0 : 0.0) << "%\n";
-    
-    file.close();
-    std::cout << "Complete election data saved to " << filename << "\n";
-}
-
-void Election::exportToCSV(const std::string& baseFilename) const {
-    // Export candidates to CSV
-    std::ofstream candidatesFile(baseFilename + "_candidates.csv");
-    if (candidatesFile.is_open()) {
-        candidatesFile << "Index,Name,Party,Votes,VotePercentage\n";
+    {
+        SnapshotBlockWriter section(file, "VOTING_SUMMARY");
         int totalVotes = 0;
         for (const auto& candidate : candidates) {
             totalVotes += candidate->getVoteCount();
         }
+        section.out() << "TotalVotesCast=" << totalVotes << "\n";
+        section.out() << "VoterTurnout=" << std::fixed << std::setprecision(2) 
+                      << (globalVoters.size() > 0 ? (static_cast<double>(totalVotes) / globalVoters.size()) * 100.0 : 0.0) << "%\n";
+        section.finish();
+    }
+    
+    // Save regions: an index of block offsets followed by one self-contained block per region,
+    // so a loader can seek straight to the region it needs
+    if (!regions.empty()) {
+        std::vector<std::string> blocks;
+        blocks.reserve(regions.size());
+        for (const auto& region : regions) {
+            blocks.push_back(renderRegionBlock(*region));
+            if (progress) {
+                progress(globalVoters.size() + blocks.size(), totalWork);
+            }
+        }
         
-        for (size_t i = 0; i < candidates.size(); ++i) {
-            double percentage = totalVotes > 0 ? 
-                (static_cast<double>(candidates[i]->getVoteCount()) / totalVotes) * 100.0 : 0.0;
-            candidatesFile << i << ","
-                          << candidates[i]->getName() << ","
-                          << (candidates[i]->getParty() ? candidates[i]->getParty()->getName() : "Independent") << ","
-                          << candidates[i]->getVoteCount() << ","
-                          << std::fixed << std::setprecision(2) << percentage << "\n";
-        }
-        candidatesFile.close();
-        std::cout << "Candidates exported to " << baseFilename << "_candidates.csv\n";
-    }
-    
-    // Export voters to CSV
-    std::ofstream votersFile(baseFilename + "_voters.csv");
-    if (votersFile.is_open()) {
-        votersFile << "UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted\n";
-        for (const auto& voter : voters) {
-            votersFile << voter->getUniqueId() << ","
-                      << voter->getFirstName() << ","
-                      << voter->getLastName() << ","
-                      << voter->getAge() << ","
-                      << voter->getPhoneNumber() << ","
-                      << "\"" << voter->getAddress() << "\","  // Quoted for addresses with commas
-                      << (voter->hasVoted() ? "Yes" : "No") << "\n";
-        }
-        votersFile.close();
-        std::cout << "Voters exported to " << baseFilename << "_voters.csv\n";
-    }
-    
-    // Export parties to CSV
-    std::ofstream partiesFile(baseFilename + "_parties.csv");
-    if (partiesFile.is_open()) {
-        partiesFile << "PartyName,MemberCount,Members\n";
-        for (const auto& party : parties) {
-            partiesFile << party->getName() << ","
-                       << party->getMembers().size() << ",\"";
-            const auto& members = party->getMembers();
-            for (size_t i = 0; i < members.size(); ++i) {
-                partiesFile << members[i];
-                if (i < members.size() - 1) partiesFile << ";";
+        file << "\n";
+        {
+            SnapshotBlockWriter section(file, "REGIONS");
+            section.out() << "TotalRegions=" << regions.size() << "\n";
+            size_t offset = 0;
+            for (size_t i = 0; i < regions.size(); ++i) {
+                section.out() << "Region" << i << "_Code=" << regions[i]->getCode() << "\n";
+                section.out() << "Region" << i << "_Name=" << regions[i]->getName() << "\n";
+                section.out() << "Region" << i << "_Offset=" << offset << "\n";
+                section.out() << "Region" << i << "_Length=" << blocks[i].size() << "\n";
+                section.out() << "Region" << i << "_VoterIds=";
+                const char* separator = "";
+                for (const Voter* voter : regions[i]->getVoters()) {
+                    section.out() << separator << voter->getUniqueId();
+                    separator = ";";
+                }
+                section.out() << "\n";
+                section.flushIfLarge();
+                offset += blocks[i].size();
             }
-            partiesFile << "\"\n";
+            section.finish();
+        }
+        file << "\n[REGION_BLOCKS]\n";
+        for (const auto& block : blocks) {
+            file << block;
         }
-        partiesFile.close();
-        std::cout << "Parties exported to " << baseFilename << "_parties.csv\n";
+    }
+    // Marks the file as complete; a snapshot cut off at a block boundary lacks it
+    file << "\n" << SnapshotVerifier::END_LINE << "\n";
+    if (progress) {
+        progress(totalWork, totalWork);
+    }
+}
+
+void Election::exportToCSV(const std::string& baseFilename, bool compressed) const {
+    CsvExportEngine::Options options;
+    options.compressed = compressed;
+    CsvExportEngine engine(*this, options);
+    CsvExportEngine::Result result = engine.exportAll(baseFilename);
+    const std::string extension = engine.fileExtension();
+    
+    if (result.candidatesWritten) {
+        std::cout << "Candidates exported to " << baseFilename << "_candidates" << extension << "\n";
+    }
+    if (result.votersWritten) {
+        std::cout << "Voters exported to " << baseFilename << "_voters" << extension << "\n";
+    }
+    if (result.partiesWritten) {
+        std::cout << "Parties exported to " << baseFilename << "_parties" << extension << "\n";
     }
     
-    std::cout << "CSV files exported successfully!\n";
+    if (result.allWritten()) {
+        std::cout << "CSV files exported successfully!\n";
+    } else {
+        std::cout << "Error: Some CSV files could not be written for " << baseFilename << ".\n";
+    }
 }
 
 // Load complete election data from file
-bool Election::loadCompleteElectionData(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+bool Election::loadCompleteElectionData(const std::string& filename, const Progress& progress) {
+    MappedFile mapping;
+    if (!mapping.open(filename)) {
         std::cout << "Warning: Could not open file " << filename << " for reading.\n";
         return false;
     }
+    mapping.adviseSequential();
+    // A compressed snapshot is decoded into memory up front; loaded voters then
+    // read their details from the decoded copy instead of the mapping
+    if (!LzBlockFile::expand(mapping)) {
+        std::cout << "Error: " << filename << " is a damaged compressed snapshot. Nothing was loaded.\n";
+        return false;
+    }
     
-    std::string line;
+    // The mapping stays open as the cold store for loaded voters' personal details
+    auto snapshot = std::make_shared<VoterPiiStore>(std::move(mapping));
+    std::string_view contents = snapshot->snapshotContents();
+    
+    // Reject a torn or corrupted file before touching the current data. Region
+    // blocks are checked individually when they are loaded.
+    SnapshotVerifier::Report integrity = SnapshotVerifier().verifyBuffer(contents, true);
+    if (!integrity.ok()) {
+        const SnapshotVerifier::BlockFailure& failure = integrity.failures.front();
+        std::cout << "Error: " << filename << " failed its integrity check ("
+                  << (failure.truncated ? "the file is cut short at section " : "section ")
+                  << failure.name << (failure.truncated ? "" : " is corrupt") << "). Nothing was loaded.\n";
+        return false;
+    }
     std::string currentSection;
+    SnapshotVoterLines voterLines;
     
     // Clear existing data
+    std::lock_guard<std::mutex> regionLock(regionLoadMutex);
+    // The previous voters and candidates go with their arenas, except any a
+    // caller still holds through a region
     candidates.clear();
-    voters.clear();
+    validationRules = &ValidationRules::standard();   // Snapshots from before rules were saved
+    // Voters registered from now on keep their details beside the snapshot's
+    voterStore = std::make_shared<VoterStore>(snapshot);
+    candidateArena = std::make_shared<ObjectArena<Candidate>>();
     parties.clear();
-    registeredVoterIds.clear();
+    regions.clear();
+    regionBlocks.clear();
+    pendingVoterRegions.clear();
+    regionSnapshotFile.clear();
+    snapshotStore = snapshot;
+    pendingRegions = 0;
+    globalCandidateRegistry.clear();
     
     std::cout << "Loading election data from " << filename << "...\n";
     
-    while (std::getline(file, line)) {
+    // Reported in bytes parsed; region blocks are left for later, so reaching them ends the load
+    size_t position = 0;
+    size_t linesRead = 0;
+    while (position < contents.size()) {
+        size_t lineStart = position;
+        std::string_view line = nextSnapshotLine(contents, position);
+        if (progress && ++linesRead % PROGRESS_INTERVAL == 0) {
+            progress(std::min(position, contents.size()), contents.size());
+        }
+        
         // Skip empty lines and comments
         if (line.empty() || line[0] == '=' || line == "COMPLETE_ELECTION_DATA") {
             continue;
         }
         
+        // Region blocks are left in the mapping and parsed when each region is first used
+        if (line == "[REGION_BLOCKS]") {
+            regionSnapshotFile = filename;
+            regionBlocksBase = std::min(position, contents.size());
+            break;
+        }
+        
         // Check for section headers
         if (line.front() == '[' && line.back() == ']') {
-            currentSection = line.substr(1, line.length() - 2);
+            currentSection = std::string(line.substr(1, line.length() - 2));
             continue;
         }
         
         // Parse key=value pairs
         size_t equalPos = line.find('=');
-        if (equalPos == std::string::npos) continue;
+        if (equalPos == std::string_view::npos) continue;
+        
+        // Voter lines are read as views so personal details are never copied
+        if (currentSection == "VOTERS") {
+            if (voterLines.add(line.substr(0, equalPos), line.substr(equalPos + 1), lineStart, position)) {
+                createSnapshotVoter(voterLines, nullptr);
+            }
+            continue;
+        }
         
-        std::string key = line.substr(0, equalPos);
-        std::string value = line.substr(equalPos + 1);
+        std::string key(line.substr(0, equalPos));
+        std::string value(line.substr(equalPos + 1));
         
         if (currentSection == "ELECTION_INFO") {
             if (key == "Title") {
                 title = value;
+            } else if (key == "ValidationRules" && !setValidationRules(value)) {
+                std::cout << "Warning: Unknown validation rules '" << value << "'; using "
+                          << validationRules->getName() << ".\n";
             }
         }
         else if (currentSection == "PARTIES") {
@@ -720,7 +1018,7 @@ bool Election::loadCompleteElectionData(const std::string& filename) {
                 if (candidateIndex >= candidates.size()) {
                     candidates.resize(candidateIndex + 1);
                 }
-                candidates[candidateIndex] = std::make_unique<Candidate>(value);
+                candidates[candidateIndex] = candidateArena->create(value);
             }
             else if (key.find("_Votes") != std::string::npos) {
                 size_t candidateIndex = std::stoul(key.substr(9, key.find("_") - 9));
@@ -745,56 +1043,85 @@ bool Election::loadCompleteElectionData(const std::string& filename) {
                 }
             }
         }
-        else if (currentSection == "VOTERS") {
-            // Parse voter data - collect all fields for a voter
-            static std::map<int, std::map<std::string, std::string>> voterData;
-            
-            if (key.find("Voter") == 0) {
-                size_t underscorePos = key.find('_');
-                if (underscorePos != std::string::npos) {
-                    int voterIndex = std::stoi(key.substr(5, underscorePos - 5));
-                    std::string field = key.substr(underscorePos + 1);
-                    voterData[voterIndex][field] = value;
-                    
-                    // If we have all required fields, create the voter
-                    auto& data = voterData[voterIndex];
-                    if (data.count("FirstName") && data.count("LastName") && 
-                        data.count("Phone") && data.count("Address") && 
-                        data.count("UniqueId") && data.count("Age") && 
-                        data.count("HasVoted")) {
-                        
-                        int uniqueId = std::stoi(data["UniqueId"]);
-                        int age = std::stoi(data["Age"]);
-                        bool hasVoted = (data["HasVoted"] == "1");
-                        
-                        auto voter = std::make_unique<Voter>(
-                            data["FirstName"], data["LastName"], 
-                            data["Phone"], data["Address"], 
-                            uniqueId, age
-                        );
-                        
-                        if (hasVoted) {
-                            voter->markAsVoted();
+        else if (currentSection == "REGIONS") {
+            size_t underscorePos = key.find('_');
+            if (key.find("Region") == 0 && underscorePos != std::string::npos) {
+                size_t regionIndex = std::stoul(key.substr(6, underscorePos - 6));
+                std::string field = key.substr(underscorePos + 1);
+                if (regionIndex >= regions.size()) {
+                    regions.resize(regionIndex + 1);
+                    regionBlocks.resize(regionIndex + 1);
+                }
+                if (field == "Code") {
+                    regions[regionIndex] = std::make_shared<Region>("", value);
+                } else if (field == "Name" && regions[regionIndex]) {
+                    regions[regionIndex] = std::make_shared<Region>(value, regions[regionIndex]->getCode());
+                } else if (field == "Offset") {
+                    regionBlocks[regionIndex].offset = std::stoul(value);
+                } else if (field == "Length") {
+                    regionBlocks[regionIndex].length = std::stoul(value);
+                } else if (field == "VoterIds") {
+                    regionBlocks[regionIndex].indexed = true;
+                    std::string_view ids = line.substr(equalPos + 1);
+                    while (!ids.empty()) {
+                        size_t end = std::min(ids.find(';'), ids.size());
+                        int uniqueId = 0;
+                        if (AsciiClass::parseInt(ids.substr(0, end), uniqueId)) {
+                            pendingVoterRegions.emplace(static_cast<uint32_t>(uniqueId),
+                                                        static_cast<uint32_t>(regionIndex));
                         }
-                        
-                        registeredVoterIds.insert(uniqueId);
-                        voters.push_back(std::move(voter));
+                        ids.remove_prefix(std::min(end + 1, ids.size()));
                     }
                 }
             }
         }
     }
     
-    file.close();
-    
     // Remove null pointers from candidates and parties
     candidates.erase(std::remove(candidates.begin(), candidates.end(), nullptr), candidates.end());
     parties.erase(std::remove(parties.begin(), parties.end(), nullptr), parties.end());
     
+    // Keep only fully described regions; their blocks stay pending until first use
+    size_t kept = 0;
+    std::vector<size_t> keptIndex(regions.size(), NO_REGION);
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (regions[i] && !regionSnapshotFile.empty()) {
+            regions[i]->attachVoterStore(voterStore);
+            regions[kept] = regions[i];
+            regionBlocks[kept] = regionBlocks[i];
+            regionBlocks[kept].loaded = false;
+            keptIndex[i] = kept++;
+        }
+    }
+    for (auto it = pendingVoterRegions.begin(); it != pendingVoterRegions.end() && kept < keptIndex.size();) {
+        size_t index = it->second < keptIndex.size() ? keptIndex[it->second] : NO_REGION;
+        if (index == NO_REGION) {
+            it = pendingVoterRegions.erase(it);
+        } else {
+            it->second = static_cast<uint32_t>(index);
+            ++it;
+        }
+    }
+    regions.resize(kept);
+    regionBlocks.resize(kept);
+    pendingRegions = kept;
+    if (regions.empty()) {
+        snapshotStore.reset();  // The voter store keeps the mapping alive
+    }
+    
+    // The load pass touched every page; let details be paged back in only when asked for
+    snapshot->releaseSnapshotPages();
+    
     std::cout << "Election data loaded successfully!\n";
     std::cout << "Loaded: " << parties.size() << " parties, " 
               << candidates.size() << " candidates, " 
-              << voters.size() << " voters\n";
+              << voterStore->size() << " voters\n";
+    if (!regions.empty()) {
+        std::cout << "Regions: " << regions.size() << " (loaded on first use)\n";
+    }
+    if (progress) {
+        progress(contents.size(), contents.size());
+    }
     
     return true;
 }
@@ -804,9 +1131,89 @@ const std::string& Election::getTitle() const {
     return title;
 }
 
+const std::vector<Candidate*>& Election::getCandidates() const {
+    return candidates;
+}
+
+// Lists every voter, so every region block has to be read
+const std::vector<Voter*>& Election::getVoters() const {
+    ensureAllRegionsLoaded();
+    return voterStore->all();
+}
+
+const std::vector<std::shared_ptr<Party>>& Election::getParties() const {
+    return parties;
+}
+
+const ValidationRules& Election::getValidationRules() const {
+    return *validationRules;
+}
+
+bool Election::setValidationRules(std::string_view name) {
+    const ValidationRules* rules = ValidationRules::find(name);
+    if (!rules) {
+        return false;
+    }
+    validationRules = rules;
+    return true;
+}
+
+Election::MemoryUsage Election::getMemoryUsage() const {
+    MemoryUsage usage;
+    usage.other = sizeof(Election) + heapBytes(title);
+    
+    // The store and arena hold global and regional voters and candidates alike
+    usage.voters = voterStore->recordBytes();
+    const VoterPiiStore& details = voterStore->details();
+    usage.personalDetails = details.arenaBytes() + details.ownedSnapshotBytes();
+    usage.mappedSnapshot = details.mappedSnapshotBytes();
+    
+    usage.candidates = candidates.capacity() * sizeof(candidates[0]) + parties.capacity() * sizeof(parties[0]) +
+                       candidateArena->capacityBytes();
+    for (const auto& candidate : candidates) {
+        usage.candidates += heapBytes(candidate->getName());
+    }
+    for (const auto& party : parties) {
+        usage.candidates += sizeof(Party) + ALLOCATION_OVERHEAD + heapBytes(party->getName());
+        for (const auto& member : party->getMembers()) {
+            usage.candidates += sizeof(std::string) + heapBytes(member);
+        }
+    }
+    
+    usage.indexes = voterStore->indexBytes() + hashIndexBytes(pendingVoterRegions, 2 * sizeof(uint32_t));
+    usage.indexes += hashIndexBytes(globalCandidateRegistry, sizeof(std::string) + sizeof(std::unordered_set<std::string>));
+    for (const auto& entry : globalCandidateRegistry) {
+        usage.indexes += heapBytes(entry.first) + hashIndexBytes(entry.second, sizeof(std::string));
+    }
+    
+    usage.regions = regions.capacity() * sizeof(regions[0]) + regionBlocks.capacity() * sizeof(RegionBlock) +
+                    heapBytes(regionSnapshotFile);
+    for (const auto& region : regions) {
+        const auto& regionVoters = region->getVoters();
+        const auto& regionCandidates = region->getCandidates();
+        usage.regions += sizeof(Region) + ALLOCATION_OVERHEAD + heapBytes(region->getName()) +
+                         regionVoters.size() * sizeof(VoterStore::Position) +
+                         regionCandidates.capacity() * sizeof(regionCandidates[0]) +
+                         region->getParties().capacity() * sizeof(region->getParties()[0]);
+        for (const auto& candidate : regionCandidates) {
+            usage.candidates += heapBytes(candidate->getName());
+        }
+    }
+    return usage;
+}
+
+size_t Election::estimateMemoryUsage() const {
+    return getMemoryUsage().total();
+}
+
 // Validation helpers
+// Voters in regions still on disk are known from the region index; nothing is loaded
+// unless the snapshot predates it
 bool Election::isVoterRegistered(int uniqueId) const {
-    return registeredVoterIds.count(uniqueId) > 0;
+    if (voterStore->contains(uniqueId)) {
+        return true;
+    }
+    return pendingRegionOf(uniqueId) != NO_REGION || voterStore->contains(uniqueId);
 }
 
 bool Election::hasVoterVoted(int uniqueId) const {
@@ -824,6 +1231,7 @@ bool Election::canCandidateBeAddedToRegion(const std::string& candidateName, std
     if (!region) return false;
     
     // Check if candidate already exists in ANY region
+    ensureAllRegionsLoaded();
     if (globalCandidateRegistry.find(candidateName) != globalCandidateRegistry.end()) {
         return false;
     }
@@ -837,12 +1245,29 @@ bool Election::canCandidateBeAddedToRegion(const std::string& candidateName, std
 }
 
 // Helper methods
+// Stores the details and the voter record. Returns NONE for an ID already registered.
+VoterStore::Position Election::addVoter(std::string_view firstName, std::string_view lastName,
+                                        std::string_view phoneNumber, std::string_view address,
+                                        int uniqueId, int age, std::shared_ptr<Region> region) {
+    if (voterStore->contains(uniqueId)) {
+        return VoterStore::NONE;
+    }
+    auto piiRef = voterStore->details().append(firstName, lastName, phoneNumber, address);
+    return voterStore->add(piiRef, uniqueId, age, region);
+}
+
+// Only the block of the region holding the voter is read, and only when the
+// voter is not among those already loaded
 Voter* Election::findVoterByUniqueId(int uniqueId) {
-    auto it = std::find_if(voters.begin(), voters.end(),
-        [uniqueId](const std::unique_ptr<Voter>& voter) {
-            return voter->getUniqueId() == uniqueId;
-        });
-    return (it != voters.end()) ? it->get() : nullptr;
+    Voter* voter = voterStore->find(uniqueId);
+    if (!voter) {
+        size_t index = pendingRegionOf(uniqueId);
+        if (index != NO_REGION) {
+            ensureRegionLoaded(index);
+        }
+        voter = voterStore->find(uniqueId);
+    }
+    return voter;
 }
 
 std::shared_ptr<Candidate> Election::findCandidateInRegion(const std::string& candidateName, std::shared_ptr<Region> region) const {
@@ -855,4 +1280,208 @@ std::shared_ptr<Candidate> Election::findCandidateInRegion(const std::string& ca
         }
     }
     return nullptr;
+}
+
+// Lazy region loading
+bool Election::isRegionLoaded(const std::string& code) const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (regions[i]->getCode() == code) {
+            return regionBlocks[i].loaded;
+        }
+    }
+    return false;
+}
+
+size_t Election::getPendingRegionCount() const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    return pendingRegions;
+}
+
+size_t Election::loadPendingRegions() const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    size_t loadedCount = pendingRegions;
+    for (size_t i = 0; i < regions.size() && pendingRegions > 0; ++i) {
+        if (!regionBlocks[i].loaded) {
+            const_cast<Election*>(this)->loadRegionBlock(i);
+        }
+    }
+    return loadedCount;
+}
+
+void Election::ensureRegionLoaded(size_t index) const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    if (!regionBlocks[index].loaded) {
+        const_cast<Election*>(this)->loadRegionBlock(index);
+    }
+}
+
+void Election::ensureAllRegionsLoaded() const {
+    loadPendingRegions();
+}
+
+// The region whose pending block holds the voter, or NO_REGION. Blocks from a
+// snapshot without voter IDs in its region index are loaded instead, so the
+// caller must look in the store again.
+size_t Election::pendingRegionOf(int uniqueId) const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    if (pendingRegions == 0) {
+        return NO_REGION;
+    }
+    auto it = pendingVoterRegions.find(static_cast<uint32_t>(uniqueId));
+    if (it != pendingVoterRegions.end() && !regionBlocks[it->second].loaded) {
+        return it->second;
+    }
+    for (size_t i = 0; i < regions.size() && pendingRegions > 0; ++i) {
+        if (!regionBlocks[i].loaded && !regionBlocks[i].indexed) {
+            const_cast<Election*>(this)->loadRegionBlock(i);
+        }
+    }
+    return NO_REGION;
+}
+
+// Includes voters in regions still on disk without loading them
+size_t Election::registeredVoterCount() const {
+    std::lock_guard<std::mutex> lock(regionLoadMutex);
+    size_t count = voterStore->size();
+    for (const auto& entry : pendingVoterRegions) {
+        count += regionBlocks[entry.second].loaded ? 0 : 1;
+    }
+    return count;
+}
+
+std::string Election::renderRegionBlock(const Region& region) const {
+    std::ostringstream block;
+    block << "[REGION:" << region.getCode() << "]\n";
+    
+    const auto& regionCandidates = region.getCandidates();
+    for (size_t i = 0; i < regionCandidates.size(); ++i) {
+        block << "Candidate" << i << "_Name=" << regionCandidates[i]->getName() << "\n";
+        block << "Candidate" << i << "_Votes=" << regionCandidates[i]->getVoteCount() << "\n";
+        if (regionCandidates[i]->getParty()) {
+            block << "Candidate" << i << "_Party=" << regionCandidates[i]->getParty()->getName() << "\n";
+        } else {
+            block << "Candidate" << i << "_Party=Independent\n";
+        }
+    }
+    
+    const auto& regionVoters = region.getVoters();
+    for (size_t i = 0; i < regionVoters.size(); ++i) {
+        const auto& voter = regionVoters[i];
+        Voter::PhoneDigits phoneDigits;
+        VoterPiiStore::Record details = voter->getPersonalDetails(phoneDigits);
+        block << "Voter" << i << "_FirstName=" << details.firstName << "\n";
+        block << "Voter" << i << "_LastName=" << details.lastName << "\n";
+        block << "Voter" << i << "_Phone=" << details.phoneNumber << "\n";
+        block << "Voter" << i << "_Address=" << details.address << "\n";
+        block << "Voter" << i << "_UniqueId=" << voter->getUniqueId() << "\n";
+        block << "Voter" << i << "_Age=" << voter->getAge() << "\n";
+        block << "Voter" << i << "_HasVoted=" << (voter->hasVoted() ? "1" : "0") << "\n";
+    }
+    
+    std::string text = block.str();
+    text += SnapshotVerifier::checksumLine(Crc32c::compute(text.data(), text.size()));
+    text += "[END_REGION]\n";
+    return text;
+}
+
+// Called with regionLoadMutex held
+bool Election::loadRegionBlock(size_t index) {
+    RegionBlock& entry = regionBlocks[index];
+    entry.loaded = true;
+    std::shared_ptr<VoterPiiStore> snapshot = snapshotStore;
+    if (--pendingRegions == 0) {
+        snapshotStore.reset();  // The voter store keeps the mapping alive
+        pendingVoterRegions = {};
+    }
+    
+    const auto& region = regions[index];
+    std::string_view contents = snapshot ? snapshot->snapshotContents() : std::string_view();
+    size_t blockStart = regionBlocksBase + entry.offset;
+    size_t position = blockStart;
+    if (blockStart > contents.size() || entry.length > contents.size() - blockStart ||
+        nextSnapshotLine(contents, position) != "[REGION:" + region->getCode() + "]" ||
+        !SnapshotVerifier::verifyBlock(contents.substr(blockStart, entry.length))) {
+        std::cout << "Warning: Could not read data for region '" << region->getCode() 
+                  << "' from " << regionSnapshotFile << ".\n";
+        return false;
+    }
+    size_t blockEnd = blockStart + entry.length;
+    
+    std::shared_ptr<Candidate> candidate;
+    SnapshotVoterLines voterLines;
+    auto flushCandidate = [&]() {
+        if (candidate) {
+            region->restoreCandidate(candidate);
+            globalCandidateRegistry[candidate->getName()].insert(region->getCode());
+            candidate.reset();
+        }
+    };
+    
+    while (position < blockEnd) {
+        size_t lineStart = position;
+        std::string_view line = nextSnapshotLine(contents, position);
+        if (line == "[END_REGION]") {
+            break;
+        }
+        size_t equalPos = line.find('=');
+        if (equalPos == std::string_view::npos) {
+            continue;
+        }
+        std::string_view key = line.substr(0, equalPos);
+        std::string_view value = line.substr(equalPos + 1);
+        
+        if (key.compare(0, 9, "Candidate") == 0) {
+            std::string_view field = key.substr(key.find('_') + 1);
+            if (field == "Name") {
+                flushCandidate();
+                candidate = ObjectArena<Candidate>::share(
+                    candidateArena, candidateArena->create(std::string(value), nullptr, region));
+            } else if (field == "Votes" && candidate) {
+                int votes = std::stoi(std::string(value));
+                for (int i = 0; i < votes; ++i) {
+                    candidate->receiveVote();
+                }
+            } else if (field == "Party" && candidate && value != "Independent") {
+                for (const auto& party : parties) {
+                    if (party && party->getName() == value) {
+                        candidate->setParty(party);
+                        party->addMember(candidate->getName());
+                        break;
+                    }
+                }
+            }
+        } else if (voterLines.add(key, value, lineStart, position)) {
+            VoterStore::Position voterPosition = createSnapshotVoter(voterLines, region);
+            if (voterPosition != VoterStore::NONE) {
+                region->restoreVoter(voterPosition);
+            }
+        }
+    }
+    flushCandidate();
+    return true;
+}
+
+// Details stay in the mapped snapshot when their lines are in the standard layout.
+// Returns NONE for an ID the store already holds.
+VoterStore::Position Election::createSnapshotVoter(const SnapshotVoterLines& lines,
+                                                   std::shared_ptr<Region> region) {
+    int uniqueId = std::stoi(std::string(lines.get(SnapshotVoterLines::UNIQUE_ID)));
+    int age = std::stoi(std::string(lines.get(SnapshotVoterLines::AGE)));
+    if (voterStore->contains(uniqueId)) {
+        return VoterStore::NONE;
+    }
+    
+    VoterStore::Position position;
+    if (lines.detailsInSnapshotOrder()) {
+        position = voterStore->add(VoterPiiStore::snapshotRecord(lines.detailsOffset()), uniqueId, age, region);
+    } else {
+        position = addVoter(lines.get(SnapshotVoterLines::FIRST_NAME), lines.get(SnapshotVoterLines::LAST_NAME),
+                            lines.get(SnapshotVoterLines::PHONE), lines.get(SnapshotVoterLines::ADDRESS),
+                            uniqueId, age, region);
+    }
+    if (position != VoterStore::NONE && lines.get(SnapshotVoterLines::HAS_VOTED) == "1") {
+        voterStore->at(position)->markAsVoted();
+    }
+    return position;
 }
\ No newline at end of file
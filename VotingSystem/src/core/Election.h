@@ -1,13 +1,23 @@
 #pragma once
+#include <functional>
+#include <iosfwd>
 #include <vector>
 #include <memory>
+#include <string_view>
 #include <unordered_set>
 #include <unordered_map>
+#include <mutex>
 #include "Candidate.h"
+#include "ObjectArena.h"
 #include "Voter.h"
+#include "VoterStore.h"
 #include "party.h"
 #include "../regional/Region.h"
 #include "../validation/InputValidator.h"
+#include "../validation/ValidationRules.h"
+#include "../persistence/VoterPiiStore.h"
+
+class SnapshotVoterLines;
 
 class Election {
     public:
@@ -45,6 +55,12 @@ class Election {
                            const std::string& phoneNumber, const std::string& address,
                            int uniqueId, int age);
         
+        // Bulk import of an already validated voter (no console output per voter).
+        // Returns false if the ID is already registered.
+        bool importVoter(std::string_view firstName, std::string_view lastName,
+                         std::string_view phoneNumber, std::string_view address,
+                         int uniqueId, int age, bool hasVoted);
+        
         // Regional voting functionality
         bool castVoteInRegion(int voterId, int candidateIndex, std::shared_ptr<Region> region);
         bool castVote(int voterId, int candidateIndex);  // Legacy method
@@ -60,11 +76,58 @@ class Election {
         
         // Getters
         const std::string& getTitle() const;
+        // Voters and candidates live in the election's arenas; pointers stay
+        // valid until the election is destroyed or loads another snapshot.
+        // getVoters() lists every voter, regional ones included.
+        const std::vector<Candidate*>& getCandidates() const;
+        const std::vector<Voter*>& getVoters() const;
+        const std::vector<std::shared_ptr<Party>>& getParties() const;
+        
+        // The jurisdiction whose rules voter registration and imports check
+        // against; "standard" unless set. Saved with the election.
+        const ValidationRules& getValidationRules() const;
+        bool setValidationRules(std::string_view name);  // False, and unchanged, if the name is unknown
+        
+        // Approximate bytes held, by category. Allocator and control-block
+        // overheads are estimated, so the figures are for capacity planning
+        // and eviction budgets rather than exact accounting.
+        struct MemoryUsage {
+            size_t voters = 0;           // Voter records and the lists holding them
+            size_t personalDetails = 0;  // Names, phone numbers and addresses held in memory
+            size_t candidates = 0;       // Candidates and parties with their names
+            size_t regions = 0;          // Region objects, names and member lists
+            size_t indexes = 0;          // Voter ID sets and the candidate registry
+            size_t other = 0;            // The election object itself and its title
+            size_t mappedSnapshot = 0;   // File-backed snapshot pages; reclaimable, not in total()
+            
+            size_t total() const {
+                return voters + personalDetails + candidates + regions + indexes + other;
+            }
+        };
+        MemoryUsage getMemoryUsage() const;
+        size_t estimateMemoryUsage() const;  // getMemoryUsage().total()
         
-        // Complete data persistence
-        void saveCompleteElectionData(const std::string& filename) const;
-        bool loadCompleteElectionData(const std::string& filename);
-        void exportToCSV(const std::string& baseFilename) const;
+        // Called now and then during long operations with the work done so far out of total
+        using Progress = std::function<void(size_t done, size_t total)>;
+        
+        // Complete data persistence. Files named *.cblz are written block-compressed;
+        // loading accepts either form. A failed save leaves any earlier file in place,
+        // and a failed load leaves the election as it was.
+        bool saveCompleteElectionData(const std::string& filename) const;
+        bool saveCompleteElectionData(const std::string& filename, bool compressed) const;
+        bool loadCompleteElectionData(const std::string& filename, const Progress& progress = nullptr);
+        // The same snapshot in two steps, so a caller holding the election's lock
+        // can release it before the file is compressed and written. Rendering
+        // reports voters and regions written; saving reports bytes.
+        std::string renderCompleteElectionData(const Progress& progress = nullptr) const;
+        static bool saveRenderedElectionData(const std::string& filename, const std::string& contents,
+                                             const Progress& progress = nullptr);
+        
+        // Region blocks from a loaded snapshot are read on first access to the region
+        bool isRegionLoaded(const std::string& code) const;
+        size_t getPendingRegionCount() const;
+        size_t loadPendingRegions() const;  // Returns the number of regions loaded
+        void exportToCSV(const std::string& baseFilename, bool compressed = false) const;
         
         // Validation helpers
         bool isVoterRegistered(int uniqueId) const;
@@ -74,14 +137,49 @@ class Election {
 
     private:
         std::string title;
-        std::vector<std::unique_ptr<Candidate>> candidates;  // Global candidate list for legacy support
-        std::vector<std::unique_ptr<Voter>> voters;  // Global voter list for legacy support
+        const ValidationRules* validationRules = &ValidationRules::standard();
+        // Every voter, global or regional; regions hold views of their members
+        std::shared_ptr<VoterStore> voterStore;
+        // Every candidate, global or regional; regions hold them through share()
+        std::shared_ptr<ObjectArena<Candidate>> candidateArena;
+        std::vector<Candidate*> candidates;  // Global candidate list for legacy support
         std::vector<std::shared_ptr<Party>> parties;
         std::vector<std::shared_ptr<Region>> regions;
-        std::unordered_set<int> registeredVoterIds; // For quick duplicate checking
         std::unordered_map<std::string, std::unordered_set<std::string>> globalCandidateRegistry; // candidateName -> regions where registered
         
+        // Location of each region's block in the snapshot it was loaded from (parallel to regions)
+        struct RegionBlock {
+            size_t offset = 0;
+            size_t length = 0;
+            bool loaded = true;
+            bool indexed = false;   // Its voters' IDs are in pendingVoterRegions
+        };
+        std::vector<RegionBlock> regionBlocks;
+        // Voter ID -> region index for voters whose region block is still on disk,
+        // read from the snapshot's region index so lookups load only that block
+        std::unordered_map<uint32_t, uint32_t> pendingVoterRegions;
+        std::string regionSnapshotFile;
+        std::shared_ptr<VoterPiiStore> snapshotStore;  // Mapped snapshot the pending blocks are read from
+        size_t regionBlocksBase = 0;
+        size_t pendingRegions = 0;
+        mutable std::mutex regionLoadMutex;
+        
         // Helper methods
+        VoterStore::Position addVoter(std::string_view firstName, std::string_view lastName,
+                                      std::string_view phoneNumber, std::string_view address,
+                                      int uniqueId, int age, std::shared_ptr<Region> region);
         Voter* findVoterByUniqueId(int uniqueId);
         std::shared_ptr<Candidate> findCandidateInRegion(const std::string& candidateName, std::shared_ptr<Region> region) const;
+        std::string renderRegionBlock(const Region& region) const;
+        void writeSnapshot(std::ostream& file, const Progress& progress = nullptr) const;
+        static bool isCompressedSnapshotName(const std::string& filename);
+        static bool writeSnapshotFile(const std::string& filename, bool compressed,
+                                      const std::function<void(std::ostream&)>& writeContents);
+        bool loadRegionBlock(size_t index);
+        VoterStore::Position createSnapshotVoter(const SnapshotVoterLines& lines, std::shared_ptr<Region> region);
+        void ensureRegionLoaded(size_t index) const;
+        void ensureAllRegionsLoaded() const;
+        static constexpr size_t NO_REGION = SIZE_MAX;
+        size_t pendingRegionOf(int uniqueId) const;
+        size_t registeredVoterCount() const;
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Election-scoped storage for objects an election creates one at a time and
+// drops all together (voters, candidates). Objects are placed back to back in
+// chunks that grow geometrically, so creating one is a bump of an index rather
+// than a heap allocation, and dropping the arena frees a handful of chunks
+// instead of one block per object. Objects never move and are never freed
+// individually; pointers stay valid for the lifetime of the arena.
+//
+// Shared handles for code that holds objects by shared_ptr (regions) are made
+// with share(), which aliases the arena's own control block: the handle keeps
+// the whole arena alive and costs no allocation of its own.
+template <typename T>
+class ObjectArena {
+public:
+    static constexpr size_t MAX_CHUNK_OBJECTS = 4096;
+
+    ObjectArena() : chunkCapacity(0), chunkUsed(0), count(0) {}
+
+    ~ObjectArena() {
+        // Trivially destructible objects need no pass at all
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                size_t used = i + 1 == chunks.size() ? chunkUsed : chunkSizes[i];
+                for (size_t j = 0; j < used; ++j) {
+                    reinterpret_cast<T*>(&chunks[i][j])->~T();
+                }
+            }
+        }
+    }
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (chunks.empty() || chunkUsed == chunkCapacity) {
+            // A small election stays small; a large one settles on big chunks
+            chunkCapacity = std::max<size_t>(16, std::min(MAX_CHUNK_OBJECTS, count));
+            chunks.emplace_back(new Slot[chunkCapacity]);
+            chunkSizes.push_back(chunkCapacity);
+            chunkUsed = 0;
+        }
+        T* object = new (&chunks.back()[chunkUsed]) T(std::forward<Args>(args)...);
+        ++chunkUsed;
+        ++count;
+        return object;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Bytes reserved for objects, used or not
+    size_t capacityBytes() const {
+        size_t slots = 0;
+        for (size_t chunkSize : chunkSizes) {
+            slots += chunkSize;
+        }
+        return slots * sizeof(Slot);
+    }
+
+    // A shared_ptr to an object of the arena that shares ownership of the arena itself
+    static std::shared_ptr<T> share(const std::shared_ptr<ObjectArena>& arena, T* object) {
+        return std::shared_ptr<T>(arena, object);
+    }
+
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    std::vector<size_t> chunkSizes;
+    size_t chunkCapacity;
+    size_t chunkUsed;
+    size_t count;
+};
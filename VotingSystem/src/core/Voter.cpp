@@ -1,42 +1,56 @@
 #include "Voter.h"
+#include "VoterStore.h"
 #include "../regional/Region.h"
+#include <algorithm>
 
-Voter::Voter(const std::string& firstName, const std::string& lastName, 
-             const std::string& phoneNumber, const std::string& address, 
-             int uniqueId, int age)
-    : firstName(firstName), lastName(lastName), phoneNumber(phoneNumber), 
-      address(address), uniqueId(uniqueId), age(age), voted(false), assignedRegion(nullptr) {
+namespace {
+
+uint8_t toStoredAge(int age) {
+    return static_cast<uint8_t>(std::min(std::max(age, 0), 255));
 }
 
-Voter::Voter(const std::string& firstName, const std::string& lastName, 
-             const std::string& phoneNumber, const std::string& address, 
-             int uniqueId, int age, std::shared_ptr<Region> region)
-    : firstName(firstName), lastName(lastName), phoneNumber(phoneNumber), 
-      address(address), uniqueId(uniqueId), age(age), voted(false), assignedRegion(region) {
+} // namespace
+
+Voter::Voter(const VoterStore& store, VoterPiiStore::Ref piiRef, int uniqueId, int age, RegionIndex region)
+    : store(&store), piiRef(piiRef), uniqueId(static_cast<uint32_t>(uniqueId)), region(region),
+      age(toStoredAge(age)), voted(false) {
 }
 
 std::string Voter::getFirstName() const {
-    return firstName;
+    PhoneDigits digits;
+    return std::string(getPersonalDetails(digits).firstName);
 }
 
 std::string Voter::getLastName() const {
-    return lastName;
+    PhoneDigits digits;
+    return std::string(getPersonalDetails(digits).lastName);
 }
 
 std::string Voter::getFullName() const {
-    return firstName + " " + lastName;
+    PhoneDigits digits;
+    VoterPiiStore::Record details = getPersonalDetails(digits);
+    std::string fullName;
+    fullName.reserve(details.firstName.size() + 1 + details.lastName.size());
+    fullName.append(details.firstName).append(" ").append(details.lastName);
+    return fullName;
 }
 
 std::string Voter::getPhoneNumber() const {
-    return phoneNumber;
+    PhoneDigits digits;
+    return std::string(getPersonalDetails(digits).phoneNumber);
 }
 
 std::string Voter::getAddress() const {
-    return address;
+    PhoneDigits digits;
+    return std::string(getPersonalDetails(digits).address);
+}
+
+VoterPiiStore::Record Voter::getPersonalDetails(PhoneDigits& phoneDigits) const {
+    return store->details().get(piiRef, phoneDigits);
 }
 
 int Voter::getUniqueId() const {
-    return uniqueId;
+    return static_cast<int>(uniqueId);
 }
 
 int Voter::getAge() const {
@@ -56,13 +70,9 @@ bool Voter::isEligible() const {
 }
 
 std::shared_ptr<Region> Voter::getRegion() const {
-    return assignedRegion;
-}
-
-void Voter::setRegion(std::shared_ptr<Region> region) {
-    assignedRegion = region;
+    return region == NO_REGION ? nullptr : store->region(region);
 }
 
 bool Voter::canVoteInRegion(std::shared_ptr<Region> region) const {
-    return assignedRegion && region && assignedRegion == region;
+    return region && getRegion() == region;
 }
\ No newline at end of file
@@ -1,34 +1,40 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
+#include "../persistence/VoterPiiStore.h"
 
-// Forward declaration
+// Forward declarations
 class Region;
+class VoterStore;
 
+// A voter's record in its election's VoterStore (see VoterStore::add). The
+// record holds what voting uses; personal details and the region are read
+// through the store.
 class Voter {
 public:
-    Voter(const std::string& firstName, const std::string& lastName, 
-          const std::string& phoneNumber, const std::string& address, 
-          int uniqueId, int age);
-    
-    // Constructor with region assignment
-    Voter(const std::string& firstName, const std::string& lastName, 
-          const std::string& phoneNumber, const std::string& address, 
-          int uniqueId, int age, std::shared_ptr<Region> region);
+    using RegionIndex = uint16_t;
+    static constexpr RegionIndex NO_REGION = UINT16_MAX;
+    using PhoneDigits = VoterPiiStore::PhoneDigits;
+
+    Voter(const VoterStore& store, VoterPiiStore::Ref piiRef, int uniqueId, int age,
+          RegionIndex region = NO_REGION);
 
-    // Getters
+    // Getters - personal details are decoded from the cold store on each call
     std::string getFirstName() const;
     std::string getLastName() const;
     std::string getFullName() const;
     std::string getPhoneNumber() const;
     std::string getAddress() const;
+    // Views valid while the voter exists, except a packed phone number, which is written to phoneDigits
+    VoterPiiStore::Record getPersonalDetails(PhoneDigits& phoneDigits) const;
     int getUniqueId() const;
     int getAge() const;
     bool hasVoted() const;
     
     // Region-related methods
     std::shared_ptr<Region> getRegion() const;
-    void setRegion(std::shared_ptr<Region> region);
     bool canVoteInRegion(std::shared_ptr<Region> region) const;
 
     // Voting functionality
@@ -36,12 +42,12 @@ public:
     bool isEligible() const;
 
 private:
-    std::string firstName;
-    std::string lastName;
-    std::string phoneNumber;
-    std::string address;
-    int uniqueId;
-    int age;
+    // Widest first, so the record has no padding: 24 bytes on 64-bit targets
+    const VoterStore* store;    // Holds the details store and the region table
+    VoterPiiStore::Ref piiRef;
+    // Hot fields used by voting, packed: IDs are 9 digits and ages at most 120
+    uint32_t uniqueId;
+    RegionIndex region;
+    uint8_t age;
     bool voted;
-    std::shared_ptr<Region> assignedRegion;
-};
\ No newline at end of file
+};
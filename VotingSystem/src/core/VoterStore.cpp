@@ -0,0 +1,53 @@
+#include "VoterStore.h"
+
+namespace {
+
+// Heap blocks carry a header; counted as two words, as elsewhere in the estimates
+const size_t ALLOCATION_OVERHEAD = 2 * sizeof(void*);
+
+} // namespace
+
+VoterStore::VoterStore(std::shared_ptr<VoterPiiStore> piiStore) : piiStore(std::move(piiStore)) {}
+
+VoterStore::Position VoterStore::add(VoterPiiStore::Ref piiRef, int uniqueId, int age,
+                                     const std::shared_ptr<Region>& region) {
+    Position position = static_cast<Position>(voters.size());
+    Voter::RegionIndex regionIndex = Voter::NO_REGION;
+    if (region) {
+        auto known = regionIndexes.find(region.get());
+        if (known != regionIndexes.end()) {
+            regionIndex = known->second;
+        } else if (regions.size() < MAX_REGIONS) {
+            regionIndex = static_cast<Voter::RegionIndex>(regions.size());
+            regions.push_back(region);
+            regionIndexes.emplace(region.get(), regionIndex);
+        } else {
+            return NONE;
+        }
+    }
+    if (position == NONE || !index.emplace(static_cast<uint32_t>(uniqueId), position).second) {
+        return NONE;
+    }
+    voters.push_back(arena.create(*this, piiRef, uniqueId, age, regionIndex));
+    return position;
+}
+
+std::shared_ptr<Region> VoterStore::region(Voter::RegionIndex index) const {
+    return index < regions.size() ? regions[index].lock() : nullptr;
+}
+
+Voter* VoterStore::find(int uniqueId) const {
+    auto it = index.find(static_cast<uint32_t>(uniqueId));
+    return it != index.end() ? voters[it->second] : nullptr;
+}
+
+size_t VoterStore::recordBytes() const {
+    return voters.capacity() * sizeof(Voter*) + arena.capacityBytes();
+}
+
+size_t VoterStore::indexBytes() const {
+    return index.bucket_count() * sizeof(void*) +
+           index.size() * (sizeof(uint32_t) + sizeof(Position) + sizeof(void*) + ALLOCATION_OVERHEAD) +
+           regions.capacity() * sizeof(regions[0]) + regionIndexes.bucket_count() * sizeof(void*) +
+           regionIndexes.size() * (sizeof(void*) + sizeof(Voter::RegionIndex) + sizeof(void*) + ALLOCATION_OVERHEAD);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "ObjectArena.h"
+#include "Voter.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Every voter of an election, global and regional alike, in registration
+// order with one ID index over all of them. A voter's region is an attribute
+// of the voter; a region's voters are the positions of its members in this
+// store, read through a View. Lookups, votes, displays and saves therefore
+// have one path whichever way a voter was registered.
+//
+// The store also holds what its voters share: the cold store of their
+// personal details and the table of their regions. A voter keeps only a
+// pointer to the store and indexes into these.
+class VoterStore {
+public:
+    using Position = uint32_t;
+    static constexpr Position NONE = UINT32_MAX;
+
+    // A subset of the store (a region's voters) given by positions, read as Voter pointers
+    class View {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Voter*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Voter* const*;
+            using reference = Voter*;
+
+            Iterator(const VoterStore* store, const Position* position) : store(store), position(position) {}
+            Voter* operator*() const { return store->at(*position); }
+            Iterator& operator++() { ++position; return *this; }
+            bool operator==(const Iterator& other) const { return position == other.position; }
+            bool operator!=(const Iterator& other) const { return position != other.position; }
+
+        private:
+            const VoterStore* store;
+            const Position* position;
+        };
+
+        View(const VoterStore* store, const std::vector<Position>* positions) : store(store), positions(positions) {}
+
+        size_t size() const { return store ? positions->size() : 0; }
+        bool empty() const { return size() == 0; }
+        Voter* operator[](size_t index) const { return store->at((*positions)[index]); }
+        Iterator begin() const { return Iterator(store, store ? positions->data() : nullptr); }
+        Iterator end() const { return Iterator(store, store ? positions->data() + positions->size() : nullptr); }
+
+    private:
+        const VoterStore* store;
+        const std::vector<Position>* positions;
+    };
+
+    // Details of voters added later are appended to piiStore
+    explicit VoterStore(std::shared_ptr<VoterPiiStore> piiStore = std::make_shared<VoterPiiStore>());
+
+    VoterStore(const VoterStore&) = delete;
+    VoterStore& operator=(const VoterStore&) = delete;
+
+    // Returns the new voter's position, or NONE (and stores nothing) if the ID is
+    // taken or the store already holds voters of MAX_REGIONS regions
+    Position add(VoterPiiStore::Ref piiRef, int uniqueId, int age,
+                 const std::shared_ptr<Region>& region = nullptr);
+
+    VoterPiiStore& details() { return *piiStore; }
+    const VoterPiiStore& details() const { return *piiStore; }
+    static constexpr size_t MAX_REGIONS = Voter::NO_REGION;
+    std::shared_ptr<Region> region(Voter::RegionIndex index) const;
+
+    Voter* find(int uniqueId) const;
+    bool contains(int uniqueId) const { return index.count(static_cast<uint32_t>(uniqueId)) > 0; }
+    Voter* at(Position position) const { return voters[position]; }
+    size_t size() const { return voters.size(); }
+    const std::vector<Voter*>& all() const { return voters; }
+
+    // Voter records and the list of them, and the ID index
+    size_t recordBytes() const;
+    size_t indexBytes() const;
+
+private:
+    std::shared_ptr<VoterPiiStore> piiStore;
+    ObjectArena<Voter> arena;
+    std::vector<Voter*> voters;
+    std::unordered_map<uint32_t, Position> index;   // Keyed by the packed ID, as held in Voter
+    // Regions own the store, so the store must not own them back
+    std::vector<std::weak_ptr<Region>> regions;
+    std::unordered_map<const Region*, Voter::RegionIndex> regionIndexes;
+};
@@ -2,7 +2,7 @@
 
 Party::Party(const std::string& name) : name(name) {}
 
-std::string Party::getName() const {
+const std::string& Party::getName() const {
     return name;
 }
 
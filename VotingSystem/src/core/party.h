@@ -6,7 +6,7 @@ class Party {
     public:
         Party(const std::string& name);
 
-        std::string getName() const;
+        const std::string& getName() const;
         void addMember(const std::string& memberName);
         const std::vector<std::string>& getMembers() const;
 
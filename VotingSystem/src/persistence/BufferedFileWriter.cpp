@@ -0,0 +1,130 @@
+#include "BufferedFileWriter.h"
+#include "LzBlockFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+BufferedFileWriter::BufferedFileWriter(const std::string& filename, size_t bufferSize, bool compressed)
+    : file(std::fopen(filename.c_str(), "wb")), target(nullptr), buffer(bufferSize < 64 ? 64 : bufferSize),
+      used(0), failed(false), compressed(compressed) {
+    if (file) {
+        // We do our own buffering; avoid a second copy through stdio
+        std::setvbuf(file, nullptr, _IONBF, 0);
+        if (compressed && std::fwrite(LzBlockFile::MAGIC.data(), 1, LzBlockFile::MAGIC.size(), file)
+                              != LzBlockFile::MAGIC.size()) {
+            failed = true;
+        }
+    }
+}
+
+BufferedFileWriter::BufferedFileWriter(std::string* target, size_t bufferSize)
+    : file(nullptr), target(target), buffer(bufferSize < 64 ? 64 : bufferSize),
+      used(0), failed(false), compressed(false) {}
+
+BufferedFileWriter::~BufferedFileWriter() {
+    close();
+}
+
+bool BufferedFileWriter::isOpen() const {
+    return file != nullptr || target != nullptr;
+}
+
+void BufferedFileWriter::flush() {
+    if (!isOpen() || used == 0) {
+        used = 0;
+        return;
+    }
+    writeOut(buffer.data(), used);
+    used = 0;
+}
+
+void BufferedFileWriter::writeOut(const char* data, size_t size) {
+    if (target) {
+        target->append(data, size);
+        return;
+    }
+    if (!compressed) {
+        if (std::fwrite(data, 1, size, file) != size) {
+            failed = true;
+        }
+        return;
+    }
+    for (size_t offset = 0; offset < size; offset += LzBlockFile::BLOCK_SIZE) {
+        size_t length = std::min(LzBlockFile::BLOCK_SIZE, size - offset);
+        encoded.clear();
+        LzBlockFile::appendBlock(std::string_view(data + offset, length), encoded);
+        if (std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size()) {
+            failed = true;
+        }
+    }
+}
+
+void BufferedFileWriter::reserve(size_t bytes) {
+    if (buffer.size() - used < bytes) {
+        flush();
+    }
+}
+
+void BufferedFileWriter::write(std::string_view text) {
+    if (text.size() > buffer.size() - used) {
+        flush();
+        if (text.size() >= buffer.size()) {
+            // Larger than the whole buffer: hand it to the OS directly
+            if (isOpen()) {
+                writeOut(text.data(), text.size());
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void BufferedFileWriter::put(char c) {
+    reserve(1);
+    buffer[used++] = c;
+}
+
+void BufferedFileWriter::writeInteger(long long value) {
+    reserve(24);
+    char* begin = buffer.data() + used;
+    auto result = std::to_chars(begin, begin + 24, value);
+    used += static_cast<size_t>(result.ptr - begin);
+}
+
+void BufferedFileWriter::writeHundredths(long long hundredths) {
+    if (hundredths < 0) {
+        put('-');
+        hundredths = -hundredths;
+    }
+    writeInteger(hundredths / 100);
+    reserve(3);
+    long long fraction = hundredths % 100;
+    buffer[used++] = '.';
+    buffer[used++] = static_cast<char>('0' + fraction / 10);
+    buffer[used++] = static_cast<char>('0' + fraction % 10);
+}
+
+bool BufferedFileWriter::close() {
+    if (target) {
+        flush();
+        target = nullptr;
+        return true;
+    }
+    if (!file) {
+        return false;
+    }
+    flush();
+    if (compressed) {
+        encoded.clear();
+        LzBlockFile::appendEndMarker(encoded);
+        if (std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size()) {
+            failed = true;
+        }
+    }
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Output file with a large user-space buffer. Numbers are formatted with
+// std::to_chars straight into the buffer, so no stream state or locale is
+// consulted per value. A compressed writer stores the file in the
+// LzBlockFile container, compressing each buffer as it is flushed. A writer
+// built on a string appends the plain text to it instead of a file.
+class BufferedFileWriter {
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;  // 1 MiB
+
+    explicit BufferedFileWriter(const std::string& filename,
+                                size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                                bool compressed = false);
+    // Appends to *target until closed
+    explicit BufferedFileWriter(std::string* target, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~BufferedFileWriter();
+
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    bool isOpen() const;
+
+    void write(std::string_view text);
+    void put(char c);
+    void writeInteger(long long value);
+
+    // Writes value/100 with exactly two decimals (e.g. 1234 -> "12.34")
+    void writeHundredths(long long hundredths);
+
+    // Flushes and closes the file; returns false if any write failed
+    bool close();
+
+private:
+    std::FILE* file;
+    std::string* target;   // In-memory output, or nullptr
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;
+    bool compressed;
+    std::string encoded;   // Scratch space for compressed blocks
+
+    void flush();
+    void writeOut(const char* data, size_t size);
+    void reserve(size_t bytes);
+};
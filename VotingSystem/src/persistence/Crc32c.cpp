@@ -0,0 +1,162 @@
+#include "Crc32c.h"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CLEARBALLOT_X86_CRC 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CLEARBALLOT_ARM_CRC 1
+#include <arm_acle.h>
+#endif
+
+namespace {
+
+const uint32_t POLYNOMIAL = 0x82F63B78;  // Reflected Castagnoli polynomial
+
+std::array<uint32_t, 256> makeTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value >> 1) ^ ((value & 1) ? POLYNOMIAL : 0);
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+const std::array<uint32_t, 256> TABLE = makeTable();
+
+uint32_t computeSoftware(const unsigned char* p, size_t length, uint32_t state) {
+    for (size_t i = 0; i < length; ++i) {
+        state = TABLE[(state ^ p[i]) & 0xFF] ^ (state >> 8);
+    }
+    return state;
+}
+
+#if defined(CLEARBALLOT_X86_CRC) && defined(__GNUC__)
+#define CLEARBALLOT_HAVE_HW_CRC 1
+__attribute__((target("sse4.2")))
+uint32_t computeHardware(const unsigned char* p, size_t length, uint32_t state) {
+    uint64_t state64 = state;
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        state64 = _mm_crc32_u64(state64, word);
+        p += 8;
+        length -= 8;
+    }
+    state = static_cast<uint32_t>(state64);
+    while (length > 0) {
+        state = _mm_crc32_u8(state, *p++);
+        --length;
+    }
+    return state;
+}
+
+bool detectHardware() {
+    __builtin_cpu_init();   // May run during static initialization
+    return __builtin_cpu_supports("sse4.2");
+}
+#elif defined(CLEARBALLOT_ARM_CRC)
+#define CLEARBALLOT_HAVE_HW_CRC 1
+uint32_t computeHardware(const unsigned char* p, size_t length, uint32_t state) {
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        state = __crc32cd(state, word);
+        p += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        state = __crc32cb(state, *p++);
+        --length;
+    }
+    return state;
+}
+
+bool detectHardware() {
+    return true;   // Guaranteed by __ARM_FEATURE_CRC32
+}
+#endif
+
+#ifdef CLEARBALLOT_HAVE_HW_CRC
+const bool HARDWARE = detectHardware();
+#else
+const bool HARDWARE = false;
+#endif
+
+// GF(2) matrix helpers for combine(), as in zlib's crc32_combine
+uint32_t matrixTimes(const uint32_t* matrix, uint32_t vector) {
+    uint32_t sum = 0;
+    while (vector) {
+        if (vector & 1) {
+            sum ^= *matrix;
+        }
+        vector >>= 1;
+        ++matrix;
+    }
+    return sum;
+}
+
+void matrixSquare(uint32_t* square, const uint32_t* matrix) {
+    for (int n = 0; n < 32; ++n) {
+        square[n] = matrixTimes(matrix, matrix[n]);
+    }
+}
+
+} // namespace
+
+uint32_t Crc32c::compute(const void* data, size_t length, uint32_t crc) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint32_t state = ~crc;
+#ifdef CLEARBALLOT_HAVE_HW_CRC
+    if (HARDWARE) {
+        return ~computeHardware(p, length, state);
+    }
+#endif
+    return ~computeSoftware(p, length, state);
+}
+
+uint32_t Crc32c::combine(uint32_t crcA, uint32_t crcB, size_t lengthB) {
+    if (lengthB == 0) {
+        return crcA;
+    }
+
+    uint32_t even[32];   // Operator for 2^n zero bits, n even
+    uint32_t odd[32];    // Operator for 2^n zero bits, n odd
+
+    // Operator for one zero bit
+    odd[0] = POLYNOMIAL;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; ++n) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    matrixSquare(even, odd);   // Two zero bits
+    matrixSquare(odd, even);   // Four zero bits
+
+    // Apply lengthB zero bytes to crcA
+    do {
+        matrixSquare(even, odd);
+        if (lengthB & 1) {
+            crcA = matrixTimes(even, crcA);
+        }
+        lengthB >>= 1;
+        if (lengthB == 0) {
+            break;
+        }
+        matrixSquare(odd, even);
+        if (lengthB & 1) {
+            crcA = matrixTimes(odd, crcA);
+        }
+        lengthB >>= 1;
+    } while (lengthB != 0);
+
+    return crcA ^ crcB;
+}
+
+bool Crc32c::isHardwareAccelerated() {
+    return HARDWARE;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// CRC32C (Castagnoli) as used by iSCSI and ext4. Uses the SSE4.2 or ARMv8
+// CRC instructions when the CPU has them, with a table-driven fallback.
+class Crc32c {
+public:
+    // Extends crc (the checksum of the preceding bytes, 0 for none) over data
+    static uint32_t compute(const void* data, size_t length, uint32_t crc = 0);
+
+    // Checksum of A followed by B, given the checksums of each and B's length.
+    // Lets large buffers be checksummed in parallel pieces.
+    static uint32_t combine(uint32_t crcA, uint32_t crcB, size_t lengthB);
+
+    static bool isHardwareAccelerated();
+};
@@ -0,0 +1,286 @@
+#include "CsvExportEngine.h"
+#include "LzBlockFile.h"
+#include "../core/Election.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+
+namespace {
+
+constexpr uint64_t BYTE_ONES = 0x0101010101010101ULL;
+constexpr uint64_t BYTE_HIGHS = 0x8080808080808080ULL;
+
+// Non-zero if any byte of word equals c (classic SWAR zero-byte test)
+inline uint64_t containsByte(uint64_t word, unsigned char c) {
+    uint64_t x = word ^ (BYTE_ONES * c);
+    return (x - BYTE_ONES) & ~x & BYTE_HIGHS;
+}
+
+inline bool isSpecial(char c) {
+    return c == ',' || c == '"' || c == '\r' || c == '\n';
+}
+
+std::string extensionFor(bool compressed) {
+    std::string extension = ".csv";
+    if (compressed) {
+        extension += LzBlockFile::FILE_EXTENSION;
+    }
+    return extension;
+}
+
+// Voter rows emitted between progress reports
+constexpr size_t PROGRESS_ROWS = 4096;
+// Slice of rendered text written between progress reports
+constexpr size_t PROGRESS_BYTES = 1024 * 1024;
+
+bool writeText(const std::string& filename, const std::string& text, const CsvExportEngine::Options& options,
+               bool reportProgress = false) {
+    BufferedFileWriter out(filename, options.bufferSize, options.compressed);
+    if (!out.isOpen()) {
+        return false;
+    }
+    if (!reportProgress || !options.progress) {
+        out.write(text);
+        return out.close();
+    }
+    std::string_view rest = text;
+    while (!rest.empty()) {
+        size_t slice = std::min(PROGRESS_BYTES, rest.size());
+        out.write(rest.substr(0, slice));
+        rest.remove_prefix(slice);
+        options.progress(text.size() - rest.size(), text.size());
+    }
+    return out.close();
+}
+
+long long percentageHundredths(int votes, long long totalVotes) {
+    if (totalVotes <= 0) {
+        return 0;
+    }
+    return std::llround(static_cast<double>(votes) * 10000.0 / static_cast<double>(totalVotes));
+}
+
+} // namespace
+
+CsvExportEngine::CsvExportEngine(const Election& election)
+    : election(election), options() {}
+
+CsvExportEngine::CsvExportEngine(const Election& election, const Options& options)
+    : election(election), options(options) {}
+
+std::string CsvExportEngine::fileExtension() const {
+    return extensionFor(options.compressed);
+}
+
+bool CsvExportEngine::needsQuoting(std::string_view field) {
+    const char* p = field.data();
+    size_t remaining = field.size();
+
+    // Eight bytes per step; names and addresses rarely contain specials
+    while (remaining >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        if (containsByte(word, ',') | containsByte(word, '"') |
+            containsByte(word, '\r') | containsByte(word, '\n')) {
+            return true;
+        }
+        p += 8;
+        remaining -= 8;
+    }
+    while (remaining-- > 0) {
+        if (isSpecial(*p++)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CsvExportEngine::writeField(BufferedFileWriter& out, std::string_view field, bool forceQuotes) {
+    if (!forceQuotes && !needsQuoting(field)) {
+        out.write(field);
+        return;
+    }
+
+    out.put('"');
+    size_t start = 0;
+    while (start < field.size()) {
+        const void* quote = std::memchr(field.data() + start, '"', field.size() - start);
+        if (!quote) {
+            out.write(field.substr(start));
+            break;
+        }
+        size_t quotePos = static_cast<size_t>(static_cast<const char*>(quote) - field.data());
+        // Emit through the quote, then double it
+        out.write(field.substr(start, quotePos - start + 1));
+        out.put('"');
+        start = quotePos + 1;
+    }
+    out.put('"');
+}
+
+bool CsvExportEngine::writeCandidates(const std::string& filename) const {
+    BufferedFileWriter out(filename, options.bufferSize, options.compressed);
+    if (!out.isOpen()) {
+        return false;
+    }
+    emitCandidates(out);
+    return out.close();
+}
+
+void CsvExportEngine::emitCandidates(BufferedFileWriter& out) const {
+    const auto& candidates = election.getCandidates();
+    long long totalVotes = 0;
+    for (const auto& candidate : candidates) {
+        totalVotes += candidate->getVoteCount();
+    }
+
+    out.write("Index,Name,Party,Votes,VotePercentage\n");
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto& candidate = candidates[i];
+        out.writeInteger(static_cast<long long>(i));
+        out.put(',');
+        writeField(out, candidate->getName());
+        out.put(',');
+        if (candidate->getParty()) {
+            writeField(out, candidate->getParty()->getName());
+        } else {
+            out.write("Independent");
+        }
+        out.put(',');
+        out.writeInteger(candidate->getVoteCount());
+        out.put(',');
+        out.writeHundredths(percentageHundredths(candidate->getVoteCount(), totalVotes));
+        out.put('\n');
+    }
+}
+
+bool CsvExportEngine::writeVoters(const std::string& filename, size_t* rowsWritten) const {
+    BufferedFileWriter out(filename, options.bufferSize, options.compressed);
+    if (!out.isOpen()) {
+        return false;
+    }
+    emitVoters(out);
+    if (rowsWritten) {
+        *rowsWritten = election.getVoters().size();
+    }
+    return out.close();
+}
+
+void CsvExportEngine::emitVoters(BufferedFileWriter& out) const {
+    const auto& voters = election.getVoters();
+    out.write("UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted\n");
+    Voter::PhoneDigits phoneDigits;
+    size_t rows = 0;
+    for (const auto& voter : voters) {
+        VoterPiiStore::Record details = voter->getPersonalDetails(phoneDigits);
+        out.writeInteger(voter->getUniqueId());
+        out.put(',');
+        writeField(out, details.firstName);
+        out.put(',');
+        writeField(out, details.lastName);
+        out.put(',');
+        out.writeInteger(voter->getAge());
+        out.put(',');
+        writeField(out, details.phoneNumber);
+        out.put(',');
+        writeField(out, details.address, true);  // Addresses are always quoted
+        out.write(voter->hasVoted() ? ",Yes\n" : ",No\n");
+        if (options.progress && ++rows % PROGRESS_ROWS == 0) {
+            options.progress(rows, voters.size());
+        }
+    }
+    if (options.progress) {
+        options.progress(voters.size(), voters.size());
+    }
+}
+
+bool CsvExportEngine::writeParties(const std::string& filename) const {
+    BufferedFileWriter out(filename, options.bufferSize, options.compressed);
+    if (!out.isOpen()) {
+        return false;
+    }
+    emitParties(out);
+    return out.close();
+}
+
+void CsvExportEngine::emitParties(BufferedFileWriter& out) const {
+    out.write("PartyName,MemberCount,Members\n");
+    std::string memberList;
+    for (const auto& party : election.getParties()) {
+        const auto& members = party->getMembers();
+        memberList.clear();
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (i > 0) memberList += ';';
+            memberList += members[i];
+        }
+
+        writeField(out, party->getName());
+        out.put(',');
+        out.writeInteger(static_cast<long long>(members.size()));
+        out.put(',');
+        writeField(out, memberList, true);  // Member lists are always quoted
+        out.put('\n');
+    }
+}
+
+CsvExportEngine::Rendered CsvExportEngine::render() const {
+    Rendered rendered;
+    BufferedFileWriter candidates(&rendered.candidates, options.bufferSize);
+    emitCandidates(candidates);
+    candidates.close();
+    BufferedFileWriter voters(&rendered.voters, options.bufferSize);
+    emitVoters(voters);
+    voters.close();
+    BufferedFileWriter parties(&rendered.parties, options.bufferSize);
+    emitParties(parties);
+    parties.close();
+    rendered.voterRows = election.getVoters().size();
+    return rendered;
+}
+
+CsvExportEngine::Result CsvExportEngine::writeRendered(const std::string& baseFilename, const Rendered& rendered,
+                                                       const Options& options) {
+    Result result;
+    const std::string extension = extensionFor(options.compressed);
+    // Compressing the voter roll dominates; the small files are written alongside it
+    auto candidates = std::async(options.concurrentFiles ? std::launch::async : std::launch::deferred, [&]() {
+        return writeText(baseFilename + "_candidates" + extension, rendered.candidates, options);
+    });
+    auto parties = std::async(options.concurrentFiles ? std::launch::async : std::launch::deferred, [&]() {
+        return writeText(baseFilename + "_parties" + extension, rendered.parties, options);
+    });
+    result.votersWritten = writeText(baseFilename + "_voters" + extension, rendered.voters, options, true);
+    result.voterRows = result.votersWritten ? rendered.voterRows : 0;
+    result.candidatesWritten = candidates.get();
+    result.partiesWritten = parties.get();
+    return result;
+}
+
+CsvExportEngine::Result CsvExportEngine::exportAll(const std::string& baseFilename) const {
+    Result result;
+    const std::string extension = fileExtension();
+    const std::string candidatesFile = baseFilename + "_candidates" + extension;
+    const std::string votersFile = baseFilename + "_voters" + extension;
+    const std::string partiesFile = baseFilename + "_parties" + extension;
+
+    if (!options.concurrentFiles) {
+        result.candidatesWritten = writeCandidates(candidatesFile);
+        result.votersWritten = writeVoters(votersFile, &result.voterRows);
+        result.partiesWritten = writeParties(partiesFile);
+        return result;
+    }
+
+    // The voter roll dominates; the small files are written alongside it
+    auto candidates = std::async(std::launch::async, [this, &candidatesFile]() {
+        return writeCandidates(candidatesFile);
+    });
+    auto parties = std::async(std::launch::async, [this, &partiesFile]() {
+        return writeParties(partiesFile);
+    });
+    result.votersWritten = writeVoters(votersFile, &result.voterRows);
+    result.candidatesWritten = candidates.get();
+    result.partiesWritten = parties.get();
+    return result;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include "BufferedFileWriter.h"
+
+class Election;
+
+// Writes the candidate, voter and party CSV files for an election.
+// Fields are escaped per RFC 4180 and the three files are produced
+// concurrently, each through its own large output buffer.
+class CsvExportEngine {
+public:
+    struct Options {
+        size_t bufferSize = BufferedFileWriter::DEFAULT_BUFFER_SIZE;
+        bool concurrentFiles = true;
+        bool compressed = false;   // LzBlockFile container, named *.csv.cblz
+        // Told voter rows emitted out of all voters, and bytes of the voters file
+        // written by writeRendered; the other two files are small
+        std::function<void(size_t done, size_t total)> progress;
+    };
+
+    struct Result {
+        bool candidatesWritten = false;
+        bool votersWritten = false;
+        bool partiesWritten = false;
+        size_t voterRows = 0;
+
+        bool allWritten() const { return candidatesWritten && votersWritten && partiesWritten; }
+    };
+
+    // The three files' contents, rendered in memory so a caller holding the
+    // election's lock can release it before anything touches the disk
+    struct Rendered {
+        std::string candidates;
+        std::string voters;
+        std::string parties;
+        size_t voterRows = 0;
+    };
+
+    explicit CsvExportEngine(const Election& election);
+    CsvExportEngine(const Election& election, const Options& options);
+
+    // Writes <base>_candidates.csv, <base>_voters.csv and <base>_parties.csv
+    Result exportAll(const std::string& baseFilename) const;
+    Rendered render() const;
+    // Writes rendered contents to the files exportAll would, compressing them
+    // if the options say so
+    static Result writeRendered(const std::string& baseFilename, const Rendered& rendered,
+                                const Options& options);
+    // ".csv", or ".csv.cblz" for compressed exports
+    std::string fileExtension() const;
+
+    bool writeCandidates(const std::string& filename) const;
+    bool writeVoters(const std::string& filename, size_t* rowsWritten = nullptr) const;
+    bool writeParties(const std::string& filename) const;
+
+    // True if the field contains a comma, double quote, CR or LF
+    static bool needsQuoting(std::string_view field);
+
+    // Writes a field, quoting it when required (or always, if forceQuotes)
+    // and doubling embedded double quotes
+    static void writeField(BufferedFileWriter& out, std::string_view field, bool forceQuotes = false);
+
+private:
+    const Election& election;
+    Options options;
+
+    void emitCandidates(BufferedFileWriter& out) const;
+    void emitVoters(BufferedFileWriter& out) const;
+    void emitParties(BufferedFileWriter& out) const;
+};
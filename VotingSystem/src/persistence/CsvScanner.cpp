@@ -0,0 +1,267 @@
+#include "CsvScanner.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CLEARBALLOT_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline unsigned countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+uint64_t classifyScalar(const char* p) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < 64; ++i) {
+        char c = p[i];
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            bits |= uint64_t(1) << i;
+        }
+    }
+    return bits;
+}
+
+#ifdef CLEARBALLOT_X86_SIMD
+uint64_t classifySse2(const char* p) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, quote)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+        bits |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << (16 * i);
+    }
+    return bits;
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+uint64_t classifyAvx2(const char* p) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < 2; ++i) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * i));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, quote)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+        bits |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hits))) << (32 * i);
+    }
+    return bits;
+}
+#define CLEARBALLOT_HAVE_AVX2 1
+#endif
+#endif
+
+CsvScanner::SimdLevel detectSimdLevel() {
+#ifdef CLEARBALLOT_HAVE_AVX2
+    __builtin_cpu_init();   // May run during static initialization
+    if (__builtin_cpu_supports("avx2")) {
+        return CsvScanner::SimdLevel::AVX2;
+    }
+#endif
+#ifdef CLEARBALLOT_X86_SIMD
+    return CsvScanner::SimdLevel::SSE2;   // Part of the x86-64 baseline
+#else
+    return CsvScanner::SimdLevel::Scalar;
+#endif
+}
+
+using ClassifyFunction = uint64_t (*)(const char*);
+
+ClassifyFunction selectClassifier(CsvScanner::SimdLevel level) {
+    switch (level) {
+#ifdef CLEARBALLOT_HAVE_AVX2
+        case CsvScanner::SimdLevel::AVX2:
+            return classifyAvx2;
+#endif
+#ifdef CLEARBALLOT_X86_SIMD
+        case CsvScanner::SimdLevel::SSE2:
+            return classifySse2;
+#endif
+        default:
+            return classifyScalar;
+    }
+}
+
+const ClassifyFunction activeClassifier = selectClassifier(detectSimdLevel());
+
+} // namespace
+
+CsvScanner::CsvScanner(std::string_view input)
+    : data(input.data()), size(input.size()), cursor(0), blockStart(0), mask(0),
+      recordNumber(0), malformed(false) {
+    if (size > 0) {
+        loadBlock(0);
+    }
+}
+
+CsvScanner::SimdLevel CsvScanner::activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const char* CsvScanner::simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+uint64_t CsvScanner::classifyBlock(const char* block, SimdLevel level) {
+    if (level == SimdLevel::AVX2 && activeSimdLevel() != SimdLevel::AVX2) {
+        level = activeSimdLevel();   // Never run instructions the CPU lacks
+    }
+    return selectClassifier(level)(block);
+}
+
+void CsvScanner::loadBlock(size_t offset) {
+    if (offset + BLOCK_SIZE <= size) {
+        mask = activeClassifier(data + offset);
+        return;
+    }
+    // Final partial block: classify a zero-padded copy
+    char tail[BLOCK_SIZE] = {};
+    std::memcpy(tail, data + offset, size - offset);
+    mask = activeClassifier(tail);
+}
+
+size_t CsvScanner::nextStructural() {
+    while (mask == 0) {
+        blockStart += BLOCK_SIZE;
+        if (blockStart >= size) {
+            return size;
+        }
+        loadBlock(blockStart);
+    }
+    size_t index = blockStart + countTrailingZeros(mask);
+    mask &= mask - 1;
+    return index;
+}
+
+std::string_view CsvScanner::unescape(std::string_view quoted, size_t fieldIndex) {
+    while (unescaped.size() <= fieldIndex) {
+        unescaped.emplace_back();
+    }
+    std::string& out = unescaped[fieldIndex];
+    out.clear();
+    for (size_t i = 0; i < quoted.size(); ++i) {
+        out += quoted[i];
+        if (quoted[i] == '"' && i + 1 < quoted.size() && quoted[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return out;
+}
+
+bool CsvScanner::nextRow(std::vector<std::string_view>& fields) {
+    fields.clear();
+    malformed = false;
+    if (cursor >= size) {
+        return false;
+    }
+    ++recordNumber;
+
+    size_t fieldStart = cursor;
+    while (true) {
+        size_t delimiter;
+
+        if (fieldStart < size && data[fieldStart] == '"') {
+            nextStructural();   // The opening quote itself
+            bool hasEscapes = false;
+            size_t closing = size;
+            while (true) {
+                size_t index = nextStructural();
+                if (index >= size) {
+                    break;
+                }
+                if (data[index] != '"') {
+                    continue;   // Commas and line breaks are data inside quotes
+                }
+                if (index + 1 < size && data[index + 1] == '"') {
+                    nextStructural();
+                    hasEscapes = true;
+                    continue;
+                }
+                closing = index;
+                break;
+            }
+
+            if (closing >= size) {
+                malformed = true;
+                fields.emplace_back(data + fieldStart + 1, size - fieldStart - 1);
+                cursor = size;
+                return true;
+            }
+
+            std::string_view content(data + fieldStart + 1, closing - fieldStart - 1);
+            fields.push_back(hasEscapes ? unescape(content, fields.size()) : content);
+
+            // Anything between the closing quote and the delimiter is ignored
+            delimiter = nextStructural();
+            while (delimiter < size && data[delimiter] == '"') {
+                delimiter = nextStructural();
+            }
+        } else {
+            delimiter = nextStructural();
+            // A stray quote inside an unquoted field is kept literally
+            while (delimiter < size && data[delimiter] == '"') {
+                delimiter = nextStructural();
+            }
+            fields.emplace_back(data + fieldStart, delimiter - fieldStart);
+        }
+
+        if (delimiter >= size) {
+            cursor = size;
+            return true;
+        }
+
+        char c = data[delimiter];
+        if (c == ',') {
+            fieldStart = delimiter + 1;
+            continue;
+        }
+
+        // Row terminator: LF, CR or CRLF
+        cursor = delimiter + 1;
+        if (c == '\r' && cursor < size && data[cursor] == '\n') {
+            nextStructural();
+            ++cursor;
+        }
+        return true;
+    }
+}
+
+size_t CsvScanner::getRecordNumber() const {
+    return recordNumber;
+}
+
+bool CsvScanner::lastRowMalformed() const {
+    return malformed;
+}
+
+size_t CsvScanner::getPosition() const {
+    return std::min(cursor, size);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Zero-copy RFC 4180 row scanner.
+//
+// Input is classified 64 bytes at a time into a bitmask of structural
+// characters (comma, double quote, CR, LF) using AVX2 or SSE2 where the CPU
+// supports it and a scalar loop otherwise. Parsing then jumps from one
+// structural character to the next instead of visiting every byte.
+//
+// Fields are returned as views into the input. Only quoted fields that
+// contain doubled quotes are unescaped, into scratch storage owned by the
+// scanner; all views stay valid until the next call to nextRow().
+class CsvScanner {
+public:
+    enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+    explicit CsvScanner(std::string_view input);
+
+    // Reads the next row into fields; returns false at end of input
+    bool nextRow(std::vector<std::string_view>& fields);
+
+    // 1-based index of the row most recently returned (header included)
+    size_t getRecordNumber() const;
+
+    // True if the last row contained a quoted field with no closing quote
+    bool lastRowMalformed() const;
+
+    // Bytes of input consumed so far, up to the start of the next row
+    size_t getPosition() const;
+
+    // Instruction set chosen for classification on this machine
+    static SimdLevel activeSimdLevel();
+    static const char* simdLevelName(SimdLevel level);
+
+    // Bitmask of structural characters in a 64-byte block (bit i = byte i),
+    // computed with the given instruction set; exposed for testing
+    static uint64_t classifyBlock(const char* block, SimdLevel level);
+
+private:
+    static const size_t BLOCK_SIZE = 64;
+
+    const char* data;
+    size_t size;
+    size_t cursor;          // Start of the next row
+    size_t blockStart;      // Offset of the block described by mask
+    uint64_t mask;          // Unconsumed structural characters in the block
+    size_t recordNumber;
+    bool malformed;
+    std::deque<std::string> unescaped;    // Per-field scratch; deque keeps earlier views stable
+
+    size_t nextStructural();
+    void loadBlock(size_t offset);
+    std::string_view unescape(std::string_view quoted, size_t fieldIndex);
+};
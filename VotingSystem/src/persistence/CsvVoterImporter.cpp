@@ -0,0 +1,305 @@
+#include "CsvVoterImporter.h"
+#include "CsvScanner.h"
+#include "LzBlockFile.h"
+#include "MappedFile.h"
+#include "../core/Election.h"
+#include "../validation/InputValidator.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+
+namespace {
+
+enum Column { UNIQUE_ID, FIRST_NAME, LAST_NAME, AGE, PHONE, ADDRESS, HAS_VOTED, COLUMN_COUNT };
+
+const std::array<std::string_view, COLUMN_COUNT> COLUMN_NAMES = {
+    "UniqueId", "FirstName", "LastName", "Age", "Phone", "Address", "HasVoted"
+};
+
+bool isColumnName(std::string_view value) {
+    for (std::string_view name : COLUMN_NAMES) {
+        if (value == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseVotedFlag(std::string_view value, bool& hasVoted) {
+    if (value == "Yes" || value == "1") {
+        hasVoted = true;
+        return true;
+    }
+    if (value == "No" || value == "0" || value.empty()) {
+        hasVoted = false;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+CsvVoterImporter::CsvVoterImporter(Election& election) : election(election) {}
+
+CsvVoterImporter::RowError CsvVoterImporter::validateRecord(const ValidationRules& rules,
+                                                            const VoterRecordView& record,
+                                                            int& uniqueId, int& age, bool& hasVoted) {
+    return finishRecord(rules.checkVoterInput(record.firstName, record.lastName, record.phone, record.address,
+                                              record.uniqueId, record.age, &uniqueId, &age),
+                        record, hasVoted);
+}
+
+CsvVoterImporter::RowError CsvVoterImporter::finishRecord(const InputValidator::Failures& failures,
+                                                          const VoterRecordView& record, bool& hasVoted) {
+    using Field = InputValidator::Field;
+    using Problem = InputValidator::Problem;
+
+    if (!failures.ok()) {
+        // Reported in column order
+        if (failures.get(Field::UniqueId) != Problem::None) return RowError::InvalidId;
+        if (failures.get(Field::FirstName) != Problem::None) return RowError::InvalidFirstName;
+        if (failures.get(Field::LastName) != Problem::None) return RowError::InvalidLastName;
+        if (failures.get(Field::Age) != Problem::None) return RowError::InvalidAge;
+        if (failures.get(Field::Phone) != Problem::None) return RowError::InvalidPhone;
+        return RowError::InvalidAddress;
+    }
+    if (!parseVotedFlag(InputValidator::trimView(record.hasVoted), hasVoted)) {
+        return RowError::InvalidVotedFlag;
+    }
+    return RowError::None;
+}
+
+const char* CsvVoterImporter::describe(RowError error) {
+    switch (error) {
+        case RowError::None: return "OK";
+        case RowError::WrongFieldCount: return "wrong number of fields";
+        case RowError::Malformed: return "unterminated quoted field";
+        case RowError::InvalidId: return "invalid unique ID";
+        case RowError::InvalidFirstName: return "invalid first name";
+        case RowError::InvalidLastName: return "invalid last name";
+        case RowError::InvalidAge: return "invalid age";
+        case RowError::InvalidPhone: return "invalid phone number";
+        case RowError::InvalidAddress: return "invalid address";
+        case RowError::InvalidVotedFlag: return "HasVoted must be Yes/No";
+        case RowError::Duplicate: return "voter ID already registered";
+    }
+    return "unknown error";
+}
+
+void CsvVoterImporter::StagedRoll::clear(const ValidationRules& stagingRules) {
+    csv = std::string_view();
+    rules = &stagingRules;
+    result = Result();
+    rows.clear();
+    unescapedFields.clear();
+    rejections.clear();
+}
+
+CsvVoterImporter::Result CsvVoterImporter::importFile(const std::string& filename) {
+    StagedRoll roll;
+    stageFile(roll, filename, election.getValidationRules());
+    return apply(roll);
+}
+
+CsvVoterImporter::Result CsvVoterImporter::importBuffer(std::string_view csv) {
+    StagedRoll roll;
+    stageBuffer(roll, csv, election.getValidationRules());
+    return apply(roll);
+}
+
+void CsvVoterImporter::stageFile(StagedRoll& roll, const std::string& filename, const ValidationRules& rules,
+                                 const Progress& progress) {
+    roll.clear(rules);
+    if (!roll.file.open(filename)) {
+        return;
+    }
+    roll.file.adviseSequential();
+    if (!LzBlockFile::expand(roll.file)) {
+        roll.result.fileOpened = true;
+        roll.result.errors.push_back("Compressed file is damaged; nothing was imported");
+        return;
+    }
+    stageBuffer(roll, roll.file.contents(), rules, progress);
+}
+
+void CsvVoterImporter::stageBuffer(StagedRoll& roll, std::string_view csv, const ValidationRules& rules,
+                                   const Progress& progress) {
+    roll.clear(rules);
+    roll.csv = csv;
+    Result& result = roll.result;
+    result.fileOpened = true;
+    result.bytesScanned = csv.size();
+    auto started = std::chrono::steady_clock::now();
+
+    CsvScanner scanner(csv);
+    std::vector<std::string_view> fields;
+    fields.reserve(COLUMN_COUNT + 1);
+
+    // Default layout is the exportToCSV column order; a header row may reorder it
+    std::array<size_t, COLUMN_COUNT> columnIndex = {0, 1, 2, 3, 4, 5, 6};
+    size_t expectedFields = COLUMN_COUNT;
+    bool firstRow = true;
+
+    auto reportError = [&roll](size_t recordNumber, RowError error) {
+        ++roll.result.rejected;
+        if (roll.rejections.size() < MAX_REPORTED_ERRORS) {
+            roll.rejections.emplace_back(recordNumber, error);
+        }
+    };
+
+    // Well-formed rows are held back until NAME_BATCH_ROWS have been read, so
+    // their names can be checked by column; rows are still staged and
+    // reported in file order
+    std::vector<VoterRecordView> batch;
+    std::vector<size_t> batchRecordNumbers;
+    std::vector<std::string_view> firstNames, lastNames;
+    // Unescaped quoted fields live in the scanner only until its next row
+    auto keep = [&csv, &roll](std::string_view field) {
+        if (field.data() >= csv.data() && field.data() + field.size() <= csv.data() + csv.size()) {
+            return field;
+        }
+        roll.unescapedFields.emplace_back(field);
+        return std::string_view(roll.unescapedFields.back());
+    };
+    batch.reserve(NAME_BATCH_ROWS);
+    batchRecordNumbers.reserve(NAME_BATCH_ROWS);
+    firstNames.reserve(NAME_BATCH_ROWS);
+    lastNames.reserve(NAME_BATCH_ROWS);
+
+    auto stageBatch = [&]() {
+        InputValidator::RowBitmap namesValid = rules.checkNames(firstNames.data(), batch.size());
+        namesValid &= rules.checkNames(lastNames.data(), batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const VoterRecordView& record = batch[i];
+            StagedRoll::Row row;
+            // Rows with a bad name take the full check, which says which field failed first
+            RowError error = namesValid.test(i)
+                ? finishRecord(rules.checkVoterFields(record.phone, record.address, record.uniqueId, record.age,
+                                                      &row.uniqueId, &row.age),
+                               record, row.hasVoted)
+                : validateRecord(rules, record, row.uniqueId, row.age, row.hasVoted);
+            if (error != RowError::None) {
+                reportError(batchRecordNumbers[i], error);
+                continue;
+            }
+
+            row.firstName = InputValidator::trimView(record.firstName);
+            row.lastName = InputValidator::trimView(record.lastName);
+            row.phone = InputValidator::trimView(record.phone);
+            row.address = InputValidator::trimView(record.address);
+            row.recordNumber = batchRecordNumbers[i];
+            roll.rows.push_back(row);
+        }
+        batch.clear();
+        batchRecordNumbers.clear();
+        firstNames.clear();
+        lastNames.clear();
+    };
+
+    while (scanner.nextRow(fields)) {
+        if (fields.size() == 1 && InputValidator::trimView(fields[0]).empty()) {
+            continue;   // Blank line
+        }
+
+        if (firstRow) {
+            firstRow = false;
+            if (isColumnName(InputValidator::trimView(fields[0]))) {
+                bool complete = true;
+                for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+                    size_t found = fields.size();
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        if (InputValidator::trimView(fields[i]) == COLUMN_NAMES[column]) {
+                            found = i;
+                            break;
+                        }
+                    }
+                    complete = complete && found < fields.size();
+                    columnIndex[column] = found;
+                }
+                if (!complete) {
+                    result.errors.push_back("Header is missing required voter columns");
+                    return;
+                }
+                expectedFields = fields.size();
+                continue;
+            }
+        }
+
+        ++result.rowsRead;
+        if (progress && result.rowsRead % PROGRESS_ROWS == 0) {
+            progress(scanner.getPosition(), csv.size());
+        }
+        if (scanner.lastRowMalformed() || fields.size() != expectedFields) {
+            // Earlier rows are staged first, so rows stay in file order
+            stageBatch();
+            reportError(scanner.getRecordNumber(),
+                        scanner.lastRowMalformed() ? RowError::Malformed : RowError::WrongFieldCount);
+            continue;
+        }
+
+        VoterRecordView record;
+        record.uniqueId = keep(fields[columnIndex[UNIQUE_ID]]);
+        record.firstName = keep(fields[columnIndex[FIRST_NAME]]);
+        record.lastName = keep(fields[columnIndex[LAST_NAME]]);
+        record.age = keep(fields[columnIndex[AGE]]);
+        record.phone = keep(fields[columnIndex[PHONE]]);
+        record.address = keep(fields[columnIndex[ADDRESS]]);
+        record.hasVoted = keep(fields[columnIndex[HAS_VOTED]]);
+        batch.push_back(record);
+        batchRecordNumbers.push_back(scanner.getRecordNumber());
+        firstNames.push_back(record.firstName);
+        lastNames.push_back(record.lastName);
+        if (batch.size() == NAME_BATCH_ROWS) {
+            stageBatch();
+        }
+    }
+    stageBatch();
+    if (progress) {
+        progress(csv.size(), csv.size());
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+CsvVoterImporter::Result CsvVoterImporter::apply(StagedRoll& roll, const Progress& progress) {
+    // Staging errors that concern the whole file leave no rows to revalidate
+    const ValidationRules& rules = election.getValidationRules();
+    if (roll.rules != &rules && roll.result.fileOpened && roll.result.errors.empty()) {
+        stageBuffer(roll, roll.csv, rules);
+    }
+    auto started = std::chrono::steady_clock::now();
+    Result result = roll.result;
+
+    // Duplicates come to light only now; they join the staging rejections in row order
+    std::vector<std::pair<size_t, RowError>> rejections = roll.rejections;
+    size_t duplicatesReported = 0;
+    for (size_t i = 0; i < roll.rows.size(); ++i) {
+        const StagedRoll::Row& row = roll.rows[i];
+        if (election.importVoter(row.firstName, row.lastName, row.phone, row.address,
+                                 row.uniqueId, row.age, row.hasVoted)) {
+            ++result.imported;
+        } else {
+            ++result.rejected;
+            if (duplicatesReported < MAX_REPORTED_ERRORS) {
+                rejections.emplace_back(row.recordNumber, RowError::Duplicate);
+                ++duplicatesReported;
+            }
+        }
+        if (progress && (i + 1) % PROGRESS_ROWS == 0) {
+            progress(i + 1, roll.rows.size());
+        }
+    }
+    std::stable_sort(rejections.begin(), rejections.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < rejections.size() && result.errors.size() < MAX_REPORTED_ERRORS; ++i) {
+        result.errors.push_back("Row " + std::to_string(rejections[i].first) + ": " +
+                                describe(rejections[i].second));
+    }
+    if (progress) {
+        progress(roll.rows.size(), roll.rows.size());
+    }
+
+    result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
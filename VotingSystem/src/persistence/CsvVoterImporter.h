@@ -0,0 +1,126 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+#include "../validation/InputValidator.h"
+
+class Election;
+class ValidationRules;
+
+// One voter row as views into the input buffer
+struct VoterRecordView {
+    std::string_view uniqueId;
+    std::string_view firstName;
+    std::string_view lastName;
+    std::string_view age;
+    std::string_view phone;
+    std::string_view address;
+    std::string_view hasVoted;
+};
+
+// Bulk loader for voter rolls in the column layout written by
+// Election::exportToCSV (UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted).
+// The file is memory-mapped (or decoded, for a compressed *.csv.cblz export)
+// and scanned with CsvScanner; rows are validated and registered directly from
+// field views, with the names of each batch of rows checked a column at a time.
+// Reading and validating (staging) is kept apart from registering (applying),
+// so a caller that guards the election with a lock needs it only to apply.
+class CsvVoterImporter {
+public:
+    enum class RowError {
+        None,
+        WrongFieldCount,
+        Malformed,
+        InvalidId,
+        InvalidFirstName,
+        InvalidLastName,
+        InvalidAge,
+        InvalidPhone,
+        InvalidAddress,
+        InvalidVotedFlag,
+        Duplicate
+    };
+
+    struct Result {
+        bool fileOpened = false;
+        size_t rowsRead = 0;       // Data rows, header excluded
+        size_t imported = 0;
+        size_t rejected = 0;
+        size_t bytesScanned = 0;
+        double seconds = 0.0;
+        std::vector<std::string> errors;   // First MAX_REPORTED_ERRORS problems
+    };
+
+    static const size_t MAX_REPORTED_ERRORS = 20;
+
+    // Told the work done out of total: bytes scanned while staging, rows while applying
+    using Progress = std::function<void(size_t done, size_t total)>;
+
+    // A roll read and validated but not yet registered. Its rows view the
+    // roll's contents, which it owns when staged from a file, so it stays
+    // where it was made.
+    class StagedRoll {
+    public:
+        StagedRoll() = default;
+        StagedRoll(const StagedRoll&) = delete;
+        StagedRoll& operator=(const StagedRoll&) = delete;
+
+    private:
+        friend class CsvVoterImporter;
+
+        struct Row {
+            std::string_view firstName;   // Trimmed, as are the other details
+            std::string_view lastName;
+            std::string_view phone;
+            std::string_view address;
+            int uniqueId = 0;
+            int age = 0;
+            bool hasVoted = false;
+            size_t recordNumber = 0;
+        };
+
+        MappedFile file;
+        std::string_view csv;
+        const ValidationRules* rules = nullptr;   // The rows were validated under these
+        Result result;     // Counts so far; errors holds only problems with the file as a whole
+        std::vector<Row> rows;
+        std::deque<std::string> unescapedFields;   // Quoted fields the scanner had to rewrite
+        std::vector<std::pair<size_t, RowError>> rejections;   // First MAX_REPORTED_ERRORS, by record
+
+        void clear(const ValidationRules& rules);
+    };
+
+    explicit CsvVoterImporter(Election& election);
+
+    // Stage and apply in one call
+    Result importFile(const std::string& filename);
+    Result importBuffer(std::string_view csv);
+
+    // Staging touches no election. A buffer staged with stageBuffer must outlive the roll.
+    static void stageFile(StagedRoll& roll, const std::string& filename, const ValidationRules& rules,
+                          const Progress& progress = nullptr);
+    static void stageBuffer(StagedRoll& roll, std::string_view csv, const ValidationRules& rules,
+                            const Progress& progress = nullptr);
+    // Registers the staged rows, restaging first if the election's rules have
+    // changed since; rejections from both steps are reported in row order
+    Result apply(StagedRoll& roll, const Progress& progress = nullptr);
+
+    // Validates a row under the given rules and converts its numeric fields
+    static RowError validateRecord(const ValidationRules& rules, const VoterRecordView& record,
+                                   int& uniqueId, int& age, bool& hasVoted);
+    static const char* describe(RowError error);
+
+private:
+    static const size_t NAME_BATCH_ROWS = 1024;
+    static const size_t PROGRESS_ROWS = 4096;   // Rows handled between progress reports
+
+    // The rest of validateRecord, once the fields have been checked
+    static RowError finishRecord(const InputValidator::Failures& failures, const VoterRecordView& record,
+                                 bool& hasVoted);
+
+    Election& election;
+};
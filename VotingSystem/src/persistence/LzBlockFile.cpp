@@ -0,0 +1,198 @@
+#include "LzBlockFile.h"
+#include "Crc32c.h"
+#include "LzCodec.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+const size_t BLOCK_HEADER_SIZE = 12;
+
+void writeUint32(char* p, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+void appendUint32(std::string& out, uint32_t value) {
+    char bytes[4];
+    writeUint32(bytes, value);
+    out.append(bytes, sizeof(bytes));
+}
+
+uint32_t readUint32(const char* p) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(p);
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) |
+           (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+struct EncodedBlock {
+    std::string_view payload;
+    size_t rawOffset;
+    uint32_t rawSize;
+    uint32_t crc;
+    bool stored;
+};
+
+} // namespace
+
+bool LzBlockFile::isCompressed(std::string_view contents) {
+    return contents.substr(0, MAGIC.size()) == MAGIC;
+}
+
+void LzBlockFile::appendBlock(std::string_view raw, std::string& out) {
+    size_t headerAt = out.size();
+    appendUint32(out, static_cast<uint32_t>(raw.size()));
+    appendUint32(out, 0);
+    appendUint32(out, Crc32c::compute(raw.data(), raw.size()));
+
+    size_t payloadAt = out.size();
+    LzCodec::compress(raw, out);
+    uint32_t storedSize = static_cast<uint32_t>(out.size() - payloadAt);
+    if (storedSize >= raw.size()) {
+        out.resize(payloadAt);
+        out.append(raw.data(), raw.size());
+        storedSize = static_cast<uint32_t>(raw.size()) | STORED_FLAG;
+    }
+    writeUint32(&out[headerAt + 4], storedSize);
+}
+
+void LzBlockFile::appendEndMarker(std::string& out) {
+    appendUint32(out, 0);
+    appendUint32(out, 0);
+    appendUint32(out, 0);
+}
+
+bool LzBlockFile::decompress(std::string_view contents, std::string& out, size_t threads) {
+    if (!isCompressed(contents)) {
+        return false;
+    }
+
+    // Walk the headers first so every block knows where its output goes
+    std::vector<EncodedBlock> blocks;
+    size_t position = MAGIC.size();
+    size_t rawTotal = 0;
+    while (true) {
+        if (contents.size() - position < BLOCK_HEADER_SIZE) {
+            return false;   // Truncated before the end marker
+        }
+        uint32_t rawSize = readUint32(contents.data() + position);
+        uint32_t storedSize = readUint32(contents.data() + position + 4);
+        uint32_t crc = readUint32(contents.data() + position + 8);
+        position += BLOCK_HEADER_SIZE;
+        if (rawSize == 0) {
+            break;
+        }
+
+        // Sizes are bounded before anything is allocated from them, so a damaged
+        // header fails here rather than asking for gigabytes
+        bool stored = (storedSize & STORED_FLAG) != 0;
+        size_t payloadSize = storedSize & ~STORED_FLAG;
+        if (rawSize > BLOCK_SIZE || payloadSize > LzCodec::maxCompressedSize(rawSize) ||
+            contents.size() - position < payloadSize || (stored && payloadSize != rawSize)) {
+            return false;
+        }
+        blocks.push_back({contents.substr(position, payloadSize), rawTotal, rawSize, crc, stored});
+        position += payloadSize;
+        rawTotal += rawSize;
+    }
+
+    out.assign(rawTotal, '\0');
+    std::atomic<bool> intact(true);
+    runParallel(threads, blocks.size(), [&](size_t index) {
+        const EncodedBlock& block = blocks[index];
+        char* target = &out[0] + block.rawOffset;
+        if (block.stored) {
+            std::memcpy(target, block.payload.data(), block.rawSize);
+        } else if (!LzCodec::decompress(block.payload, target, block.rawSize)) {
+            intact = false;
+            return;
+        }
+        if (Crc32c::compute(target, block.rawSize) != block.crc) {
+            intact = false;
+        }
+    });
+    if (!intact) {
+        out.clear();
+    }
+    return intact;
+}
+
+bool LzBlockFile::expand(MappedFile& file) {
+    if (!isCompressed(file.contents())) {
+        return true;
+    }
+    std::string raw;
+    if (!decompress(file.contents(), raw)) {
+        return false;
+    }
+    file.assign(std::move(raw));
+    return true;
+}
+
+LzBlockStreamBuf::LzBlockStreamBuf(std::streambuf* sink) : sink(sink), failed(false), finished(false) {
+    block.resize(LzBlockFile::BLOCK_SIZE);
+    setp(block.data(), block.data() + block.size());
+    encoded.assign(LzBlockFile::MAGIC.data(), LzBlockFile::MAGIC.size());   // Goes out with the first block
+}
+
+LzBlockStreamBuf::int_type LzBlockStreamBuf::overflow(int_type c) {
+    if (finished) {
+        return traits_type::eof();
+    }
+    flushBlock();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return failed ? traits_type::eof() : traits_type::not_eof(c);
+}
+
+std::streamsize LzBlockStreamBuf::xsputn(const char* data, std::streamsize count) {
+    if (finished) {
+        return 0;
+    }
+    std::streamsize written = 0;
+    while (written < count) {
+        std::streamsize room = epptr() - pptr();
+        if (room == 0) {
+            flushBlock();
+            continue;
+        }
+        std::streamsize step = std::min(room, count - written);
+        std::memcpy(pptr(), data + written, static_cast<size_t>(step));
+        pbump(static_cast<int>(step));
+        written += step;
+    }
+    return failed ? 0 : written;
+}
+
+bool LzBlockStreamBuf::finish() {
+    if (!finished) {
+        flushBlock();
+        LzBlockFile::appendEndMarker(encoded);
+        writeEncoded();
+        finished = true;
+    }
+    return !failed && sink->pubsync() == 0;
+}
+
+void LzBlockStreamBuf::flushBlock() {
+    size_t used = static_cast<size_t>(pptr() - pbase());
+    if (used > 0) {
+        LzBlockFile::appendBlock(std::string_view(pbase(), used), encoded);
+        writeEncoded();
+    }
+    setp(block.data(), block.data() + block.size());
+}
+
+void LzBlockStreamBuf::writeEncoded() {
+    std::streamsize size = static_cast<std::streamsize>(encoded.size());
+    if (sink->sputn(encoded.data(), size) != size) {
+        failed = true;
+    }
+    encoded.clear();
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class MappedFile;
+
+// Container for block-compressed files (snapshots and CSV exports).
+//
+//   "CBLZ0001"                                     8-byte magic
+//   { rawSize, storedSize, crc32c } payload        one entry per block
+//   { 0, 0, 0 }                                    end marker
+//
+// The three header fields are little-endian uint32. Each block is compressed
+// independently with LzCodec, so blocks can be decoded in parallel; a block
+// that does not shrink is stored raw (STORED_FLAG set in storedSize). The
+// CRC32C of the raw bytes is checked on decode and the end marker exposes
+// truncated files. A block never holds more than BLOCK_SIZE raw bytes.
+class LzBlockFile {
+public:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+    static constexpr uint32_t STORED_FLAG = 0x80000000u;
+    static constexpr std::string_view MAGIC = "CBLZ0001";
+    static constexpr std::string_view FILE_EXTENSION = ".cblz";
+
+    static bool isCompressed(std::string_view contents);
+
+    // Appends one encoded block (header and payload) to out
+    static void appendBlock(std::string_view raw, std::string& out);
+    static void appendEndMarker(std::string& out);
+
+    // Decodes a whole container into out; false if it is corrupt or truncated
+    static bool decompress(std::string_view contents, std::string& out,
+                           size_t threads = std::thread::hardware_concurrency());
+
+    // Replaces a compressed file's contents with the decoded bytes, so callers
+    // can read compressed and plain files alike. Plain files are left as they are.
+    // Returns false if the file is compressed but cannot be decoded.
+    static bool expand(MappedFile& file);
+};
+
+// Output stream buffer that writes the block container to another stream
+// buffer. Nothing reaches the sink until the first block is full or finish()
+// writes the last block and the end marker.
+class LzBlockStreamBuf : public std::streambuf {
+public:
+    explicit LzBlockStreamBuf(std::streambuf* sink);
+
+    bool finish();
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+
+private:
+    std::streambuf* sink;
+    std::vector<char> block;
+    std::string encoded;
+    bool failed;
+    bool finished;
+
+    void flushBlock();
+    void writeEncoded();
+};
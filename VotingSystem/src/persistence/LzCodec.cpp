@@ -0,0 +1,236 @@
+#include "LzCodec.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 65535;
+const size_t LAST_LITERALS = 5;     // A block always ends with at least this many literals
+const size_t MATCH_FIND_LIMIT = 12; // No match may start this close to the end
+const unsigned HASH_BITS = 16;
+const unsigned SKIP_TRIGGER = 6;    // Probe less often the longer nothing matches
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashOf(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Index of the first differing byte in two unequal 8-byte words read from memory
+inline size_t firstDifferentByte(uint64_t diff) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return static_cast<size_t>(__builtin_clzll(diff)) / 8;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, diff);
+    return static_cast<size_t>(index) / 8;
+#else
+    return static_cast<size_t>(__builtin_ctzll(diff)) / 8;
+#endif
+}
+
+// Length of the common prefix of p and ref, stopping at limit
+size_t matchLength(const uint8_t* p, const uint8_t* ref, const uint8_t* limit) {
+    const uint8_t* start = p;
+    while (p + 8 <= limit) {
+        uint64_t diff = read64(p) ^ read64(ref);
+        if (diff != 0) {
+            return static_cast<size_t>(p - start) + firstDifferentByte(diff);
+        }
+        p += 8;
+        ref += 8;
+    }
+    while (p < limit && *p == *ref) {
+        ++p;
+        ++ref;
+    }
+    return static_cast<size_t>(p - start);
+}
+
+inline uint8_t* writeLengthExtension(uint8_t* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+uint8_t* writeLiterals(uint8_t* op, uint8_t& token, const uint8_t* literals, size_t length) {
+    if (length >= 15) {
+        token = 15 << 4;
+        op = writeLengthExtension(op, length - 15);
+    } else {
+        token = static_cast<uint8_t>(length << 4);
+    }
+    std::memcpy(op, literals, length);
+    return op + length;
+}
+
+inline bool readLengthExtension(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t LzCodec::maxCompressedSize(size_t inputSize) {
+    return inputSize + inputSize / 255 + 16;
+}
+
+void LzCodec::compress(std::string_view input, std::string& out) {
+    size_t outStart = out.size();
+    out.resize(outStart + maxCompressedSize(input.size()));
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(input.data());
+    const uint8_t* end = base + input.size();
+    const uint8_t* ip = base;
+    const uint8_t* anchor = base;
+    uint8_t* op = reinterpret_cast<uint8_t*>(&out[outStart]);
+
+    if (input.size() > MATCH_FIND_LIMIT) {
+        const uint8_t* matchFindLimit = end - MATCH_FIND_LIMIT;
+        const uint8_t* matchLimit = end - LAST_LITERALS;
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+        unsigned misses = 0;
+
+        ++ip;
+        while (ip < matchFindLimit) {
+            uint32_t sequence = read32(ip);
+            uint32_t& slot = table[hashOf(sequence)];
+            const uint8_t* ref = base + slot;
+            slot = static_cast<uint32_t>(ip - base);
+
+            if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_OFFSET || read32(ref) != sequence) {
+                ip += 1 + (misses++ >> SKIP_TRIGGER);
+                continue;
+            }
+            misses = 0;
+
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            size_t length = MIN_MATCH + matchLength(ip + MIN_MATCH, ref + MIN_MATCH, matchLimit);
+
+            uint8_t* token = op++;
+            op = writeLiterals(op, *token, anchor, static_cast<size_t>(ip - anchor));
+            size_t offset = static_cast<size_t>(ip - ref);
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            if (length - MIN_MATCH >= 15) {
+                *token |= 15;
+                op = writeLengthExtension(op, length - MIN_MATCH - 15);
+            } else {
+                *token |= static_cast<uint8_t>(length - MIN_MATCH);
+            }
+
+            ip += length;
+            anchor = ip;
+            if (ip < matchFindLimit) {
+                table[hashOf(read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - base);
+            }
+        }
+    }
+
+    uint8_t* token = op++;
+    op = writeLiterals(op, *token, anchor, static_cast<size_t>(end - anchor));
+    out.resize(static_cast<size_t>(reinterpret_cast<char*>(op) - &out[0]));
+}
+
+bool LzCodec::decompress(std::string_view input, char* output, size_t outputSize) {
+    if (input.empty()) {
+        return outputSize == 0;
+    }
+
+    const uint8_t* ip = reinterpret_cast<const uint8_t*>(input.data());
+    const uint8_t* inputEnd = ip + input.size();
+    uint8_t* op = reinterpret_cast<uint8_t*>(output);
+    uint8_t* outputStart = op;
+    uint8_t* outputEnd = op + outputSize;
+
+    while (true) {
+        if (ip >= inputEnd) {
+            return false;
+        }
+        uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals < 15 && inputEnd - ip >= 16 && outputEnd - op >= 16) {
+            // Short run with room to spare: one fixed-size copy instead of a variable one
+            std::memcpy(op, ip, 16);
+        } else {
+            if (literals == 15 && !readLengthExtension(ip, inputEnd, literals)) {
+                return false;
+            }
+            if (literals > static_cast<size_t>(inputEnd - ip) || literals > static_cast<size_t>(outputEnd - op)) {
+                return false;
+            }
+            std::memcpy(op, ip, literals);
+        }
+        op += literals;
+        ip += literals;
+        if (ip == inputEnd) {
+            break;  // The final sequence carries literals only
+        }
+
+        if (inputEnd - ip < 2) {
+            return false;
+        }
+        size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - outputStart)) {
+            return false;
+        }
+
+        size_t length = token & 15;
+        if (length == 15 && !readLengthExtension(ip, inputEnd, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (length > static_cast<size_t>(outputEnd - op)) {
+            return false;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= 8 && static_cast<size_t>(outputEnd - op) >= length + 8) {
+            // Eight bytes at a time; the overshoot lands in space the next sequence overwrites
+            uint8_t* copyEnd = op + length;
+            do {
+                std::memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            } while (op < copyEnd);
+            op = copyEnd;
+        } else {
+            for (size_t i = 0; i < length; ++i) {
+                op[i] = match[i];   // Overlapping copies repeat the pattern
+            }
+            op += length;
+        }
+    }
+    return op == outputEnd;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Byte-oriented LZ77 block codec in the LZ4 style: each sequence is a token
+// (literal and match length nibbles), the literals, a 16-bit back offset and
+// optional length extension bytes. Compression is greedy with a single hash
+// probe per position; decompression is a bounds-checked copy loop that never
+// reads or writes outside the buffers it is given.
+class LzCodec {
+public:
+    // Worst-case compressed size for an input of the given length
+    static size_t maxCompressedSize(size_t inputSize);
+
+    // Appends the compressed form of input to out
+    static void compress(std::string_view input, std::string& out);
+
+    // Decodes input into exactly outputSize bytes at output.
+    // Returns false if the data is malformed or does not fill the output.
+    static bool decompress(std::string_view input, char* output, size_t outputSize);
+};
@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CLEARBALLOT_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), length(0), mapped(false) {}
+
+MappedFile::MappedFile(const std::string& filename) : MappedFile() {
+    open(filename);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : MappedFile() {
+    moveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::moveFrom(MappedFile& other) noexcept {
+    mapped = other.mapped;
+    length = other.length;
+    if (mapped) {
+        data = other.data;
+    } else {
+        fallback = std::move(other.fallback);
+        data = fallback.data();
+    }
+    other.data = nullptr;
+    other.length = 0;
+    other.mapped = false;
+    other.fallback.clear();
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+#ifdef CLEARBALLOT_HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        // mmap rejects empty ranges; an empty file is still a valid open
+        ::close(fd);
+        data = fallback.data();
+        return true;
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address != MAP_FAILED) {
+        data = static_cast<const char*>(address);
+        mapped = true;
+        return true;
+    }
+    length = 0;
+#endif
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    fallback = contents.str();
+    data = fallback.data();
+    length = fallback.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef CLEARBALLOT_HAVE_MMAP
+    if (mapped && data) {
+        ::munmap(const_cast<char*>(data), length);
+    }
+#endif
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    fallback.clear();
+}
+
+void MappedFile::assign(std::string contents) {
+    close();
+    fallback = std::move(contents);
+    data = fallback.data();
+    length = fallback.size();
+}
+
+bool MappedFile::isOpen() const {
+    return data != nullptr;
+}
+
+bool MappedFile::isMapped() const {
+    return mapped;
+}
+
+std::string_view MappedFile::contents() const {
+    return std::string_view(data ? data : "", length);
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+void MappedFile::adviseSequential() const {
+#ifdef CLEARBALLOT_HAVE_MMAP
+    if (mapped && data) {
+        ::madvise(const_cast<char*>(data), length, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void MappedFile::releaseResidentPages() const {
+#ifdef CLEARBALLOT_HAVE_MMAP
+    if (mapped && data) {
+        ::madvise(const_cast<char*>(data), length, MADV_DONTNEED);
+    }
+#endif
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Read-only view of a whole file. On POSIX systems the file is memory-mapped
+// and paged in on demand; elsewhere it is read into memory once.
+class MappedFile {
+public:
+    MappedFile();
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& filename);
+    void close();
+    // Replaces the view with an owned buffer, e.g. a decompressed file
+    void assign(std::string contents);
+
+    bool isOpen() const;
+    bool isMapped() const;   // False when the contents are held in memory instead
+    std::string_view contents() const;
+    size_t size() const;
+
+    // Hint that the contents will be read front to back
+    void adviseSequential() const;
+    // Drop the pages from this process; they are read back from the file on next access
+    void releaseResidentPages() const;
+
+private:
+    const char* data;
+    size_t length;
+    bool mapped;
+    std::string fallback;   // Used when mapping is unavailable
+
+    void moveFrom(MappedFile& other) noexcept;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Runs work(i) for every i in [0, itemCount) on up to threadCount threads.
+// Items are handed out one at a time, so uneven items balance themselves.
+template <typename Work>
+void runParallel(size_t threadCount, size_t itemCount, Work work) {
+    threadCount = std::max<size_t>(1, std::min(threadCount, itemCount));
+    if (threadCount == 1) {
+        for (size_t i = 0; i < itemCount; ++i) {
+            work(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (size_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < itemCount; i = next++) {
+                work(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
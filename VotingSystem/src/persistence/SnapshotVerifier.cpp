@@ -0,0 +1,288 @@
+#include "SnapshotVerifier.h"
+#include "Crc32c.h"
+#include "LzBlockFile.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+struct Marker {
+    enum Type { Header, Checksum, RegionBlocks };
+    Type type;
+    size_t offset;              // Start of the line
+    std::string_view text;      // Header name or checksum digits
+};
+
+struct Block {
+    std::string_view name;
+    size_t offset;
+    size_t length;
+    uint32_t expected;
+};
+
+struct Chunk {
+    size_t block;
+    size_t offset;
+    size_t length;
+};
+
+bool parseChecksum(std::string_view digits, uint32_t& value) {
+    auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value, 16);
+    return result.ec == std::errc() && result.ptr == digits.data() + digits.size();
+}
+
+const char* findBytes(const char* haystack, size_t length, std::string_view needle) {
+#if defined(__GLIBC__) || defined(__APPLE__)
+    return static_cast<const char*>(memmem(haystack, length, needle.data(), needle.size()));
+#else
+    const char* last = haystack + length;
+    const char* hit = std::search(haystack, last,
+                                  std::boyer_moore_horspool_searcher<const char*>(needle.data(), needle.data() + needle.size()));
+    return hit == last ? nullptr : hit;
+#endif
+}
+
+std::string_view lineAt(std::string_view contents, size_t position) {
+    size_t lineEnd = contents.find('\n', position);
+    if (lineEnd == std::string_view::npos) {
+        lineEnd = contents.size();
+    }
+    std::string_view line = contents.substr(position, lineEnd - position);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+// Whether the last line of the file is the end line
+bool endsWithEndLine(std::string_view contents) {
+    while (!contents.empty() && (contents.back() == '\n' || contents.back() == '\r')) {
+        contents.remove_suffix(1);
+    }
+    const std::string_view end = SnapshotVerifier::END_LINE;
+    return contents.size() >= end.size() && contents.substr(contents.size() - end.size()) == end &&
+           (contents.size() == end.size() || contents[contents.size() - end.size() - 1] == '\n');
+}
+
+// Structural lines whose first byte lies in [begin, end). Headers and checksum
+// lines are rare, so the scan jumps between '[' bytes and "Checksum=" matches
+// (memchr/memmem speed) instead of walking every line.
+void scanRange(std::string_view contents, size_t begin, size_t end, bool stopAtRegionBlocks,
+               std::vector<Marker>& markers) {
+    const std::string_view key = SnapshotVerifier::CHECKSUM_KEY;
+    const char* base = contents.data();
+    auto atLineStart = [&](size_t position) {
+        return position == 0 || base[position - 1] == '\n';
+    };
+    auto nextBracket = [&](size_t from) {
+        const void* hit = from < end ? std::memchr(base + from, '[', end - from) : nullptr;
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - base) : end;
+    };
+    auto nextChecksum = [&](size_t from) {
+        // The match may run past end as long as it starts before it
+        size_t limit = std::min(contents.size(), end + key.size() - 1);
+        const char* hit = from < limit ? findBytes(base + from, limit - from, key) : nullptr;
+        return hit ? static_cast<size_t>(hit - base) : end;
+    };
+
+    size_t bracket = nextBracket(begin);
+    size_t checksum = nextChecksum(begin);
+    while (bracket < end || checksum < end) {
+        if (bracket < checksum) {
+            size_t position = bracket;
+            bracket = nextBracket(position + 1);
+            if (!atLineStart(position)) {
+                continue;
+            }
+            std::string_view line = lineAt(contents, position);
+            if (line.back() != ']') {
+                continue;
+            }
+            std::string_view name = line.substr(1, line.size() - 2);
+            if (name == "REGION_BLOCKS") {
+                markers.push_back({Marker::RegionBlocks, position, name});
+                if (stopAtRegionBlocks) {
+                    return;
+                }
+            } else if (name != "END_REGION" && line != SnapshotVerifier::END_LINE) {
+                markers.push_back({Marker::Header, position, name});
+            }
+        } else {
+            size_t position = checksum;
+            checksum = nextChecksum(position + 1);
+            if (atLineStart(position)) {
+                markers.push_back({Marker::Checksum, position, lineAt(contents, position).substr(key.size())});
+            }
+        }
+    }
+}
+
+} // namespace
+
+SnapshotVerifier::SnapshotVerifier() : SnapshotVerifier(Options()) {}
+
+SnapshotVerifier::SnapshotVerifier(const Options& options) : options(options) {
+    if (this->options.chunkSize == 0) {
+        this->options.chunkSize = Options().chunkSize;
+    }
+}
+
+SnapshotVerifier::Report SnapshotVerifier::verifyFile(const std::string& filename) const {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return Report();
+    }
+    if (!LzBlockFile::isCompressed(file.contents())) {
+        return verifyBuffer(file.contents());
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    std::string contents;
+    if (!LzBlockFile::decompress(file.contents(), contents, options.threads)) {
+        Report report;
+        report.fileOpened = true;
+        report.compressed = true;
+        report.bytes = file.size();
+        report.failures.push_back({"compressed container", 0, 0, 0});
+        return report;
+    }
+    Report report = verifyBuffer(contents);
+    report.compressed = true;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+SnapshotVerifier::Report SnapshotVerifier::verifyBuffer(std::string_view contents, bool stopAtRegionBlocks) const {
+    Report report;
+    report.fileOpened = true;
+    report.bytes = contents.size();
+    auto started = std::chrono::steady_clock::now();
+
+    // Pass 1: find structural lines. Slices are scanned in parallel unless the
+    // caller only wants the part before [REGION_BLOCKS].
+    size_t sliceCount = stopAtRegionBlocks ? 1 : std::max<size_t>(1, contents.size() / options.chunkSize);
+    sliceCount = std::min(sliceCount, std::max<size_t>(1, options.threads) * 4);
+    std::vector<std::vector<Marker>> sliceMarkers(sliceCount);
+    runParallel(options.threads, sliceCount, [&](size_t slice) {
+        size_t begin = contents.size() * slice / sliceCount;
+        size_t end = contents.size() * (slice + 1) / sliceCount;
+        scanRange(contents, begin, end, stopAtRegionBlocks, sliceMarkers[slice]);
+    });
+
+    // Pair each header with the checksum line that closes it
+    std::vector<Block> blocks;
+    std::vector<const Marker*> unclosed;
+    bool checksummed = false;
+    const Marker* open = nullptr;
+    bool stopped = false;
+    for (const auto& markers : sliceMarkers) {
+        for (const auto& marker : markers) {
+            if (marker.type == Marker::Checksum) {
+                checksummed = true;
+                uint32_t expected = 0;
+                if (open && parseChecksum(marker.text, expected)) {
+                    blocks.push_back({open->text, open->offset, marker.offset - open->offset, expected});
+                } else if (open) {
+                    report.failures.push_back({std::string(open->text), open->offset, 0, 0});
+                }
+                open = nullptr;
+                continue;
+            }
+            if (open) {
+                unclosed.push_back(open);
+            }
+            open = marker.type == Marker::Header ? &marker : nullptr;
+            if (marker.type == Marker::RegionBlocks && stopAtRegionBlocks) {
+                stopped = true;
+                break;
+            }
+        }
+        if (stopped) {
+            break;
+        }
+    }
+    if (open) {
+        unclosed.push_back(open);
+    }
+    // Files from before checksums have none at all; once there are checksums,
+    // a block without one or a missing end line is a torn write
+    if (checksummed) {
+        for (const Marker* header : unclosed) {
+            report.failures.push_back({std::string(header->text), header->offset, 0, 0, true});
+        }
+        if (!endsWithEndLine(contents)) {
+            report.failures.push_back({std::string(END_LINE.substr(1, END_LINE.size() - 2)), contents.size(),
+                                       0, 0, true});
+        }
+    } else {
+        report.blocksUnchecked = unclosed.size();
+    }
+
+    // Pass 2: checksum every block in chunks, then combine the pieces in order
+    std::vector<Chunk> chunks;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        size_t offset = 0;
+        do {
+            size_t length = std::min(options.chunkSize, blocks[b].length - offset);
+            chunks.push_back({b, blocks[b].offset + offset, length});
+            offset += length;
+        } while (offset < blocks[b].length);
+    }
+    // Small sections each make a chunk of their own; only bytes justify threads
+    size_t checkedBytes = 0;
+    for (const auto& block : blocks) {
+        checkedBytes += block.length;
+    }
+    size_t crcThreads = std::min(options.threads, checkedBytes / options.chunkSize + 1);
+    std::vector<uint32_t> chunkCrcs(chunks.size());
+    runParallel(crcThreads, chunks.size(), [&](size_t i) {
+        chunkCrcs[i] = Crc32c::compute(contents.data() + chunks[i].offset, chunks[i].length);
+    });
+
+    std::vector<uint32_t> blockCrcs(blocks.size(), 0);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        uint32_t& crc = blockCrcs[chunks[i].block];
+        crc = Crc32c::combine(crc, chunkCrcs[i], chunks[i].length);
+    }
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        ++report.blocksChecked;
+        if (blockCrcs[b] != blocks[b].expected) {
+            report.failures.push_back({std::string(blocks[b].name), blocks[b].offset,
+                                       blocks[b].expected, blockCrcs[b]});
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+bool SnapshotVerifier::verifyBlock(std::string_view block) {
+    size_t lineStart = block.rfind(std::string("\n") + std::string(CHECKSUM_KEY));
+    if (lineStart == std::string_view::npos) {
+        return true;   // Written before checksums existed
+    }
+    ++lineStart;
+
+    size_t digitsStart = lineStart + CHECKSUM_KEY.size();
+    size_t digitsEnd = block.find_first_of("\r\n", digitsStart);
+    if (digitsEnd == std::string_view::npos) {
+        digitsEnd = block.size();
+    }
+    uint32_t expected = 0;
+    return parseChecksum(block.substr(digitsStart, digitsEnd - digitsStart), expected) &&
+           Crc32c::compute(block.data(), lineStart) == expected;
+}
+
+std::string SnapshotVerifier::checksumLine(uint32_t crc) {
+    static const char digits[] = "0123456789abcdef";
+    std::string line(CHECKSUM_KEY);
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        line += digits[(crc >> shift) & 0xF];
+    }
+    line += '\n';
+    return line;
+}
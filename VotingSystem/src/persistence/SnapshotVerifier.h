@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Integrity checking for complete election snapshots. Every section and region
+// block ends with a "Checksum=xxxxxxxx" line holding the CRC32C of all bytes
+// from the block's [HEADER] line up to the checksum line, and the file ends
+// with an [END_SNAPSHOT] line. In a file with any checksum, a block without
+// one or a missing end line means the file was cut short.
+//
+// Verification runs in two parallel passes: worker threads find block
+// boundaries in separate slices of the file, then checksum fixed-size chunks
+// of every block and the partial checksums are combined per block.
+class SnapshotVerifier {
+public:
+    struct Options {
+        size_t threads = std::thread::hardware_concurrency();
+        size_t chunkSize = 4 * 1024 * 1024;
+    };
+
+    struct BlockFailure {
+        std::string name;       // Header without brackets, e.g. VOTERS or REGION:NORTH
+        size_t offset = 0;
+        uint32_t expected = 0;
+        uint32_t actual = 0;
+        bool truncated = false;   // No checksum line, or no end line; nothing to compare
+    };
+
+    struct Report {
+        bool fileOpened = false;
+        bool compressed = false;      // Decoded from an LzBlockFile container first
+        size_t bytes = 0;             // Uncompressed size
+        size_t blocksChecked = 0;
+        size_t blocksUnchecked = 0;   // No Checksum line in a file written before checksums existed
+        std::vector<BlockFailure> failures;
+        double seconds = 0.0;
+
+        bool ok() const { return fileOpened && failures.empty(); }
+    };
+
+    static constexpr std::string_view CHECKSUM_KEY = "Checksum=";
+    static constexpr std::string_view END_LINE = "[END_SNAPSHOT]";
+
+    SnapshotVerifier();
+    explicit SnapshotVerifier(const Options& options);
+
+    // Compressed snapshots are decoded first; a damaged container is a failure
+    Report verifyFile(const std::string& filename) const;
+    // With stopAtRegionBlocks, only the sections before [REGION_BLOCKS] are read
+    Report verifyBuffer(std::string_view contents, bool stopAtRegionBlocks = false) const;
+
+    // Checks one region block ([REGION:...] through [END_REGION])
+    static bool verifyBlock(std::string_view block);
+    // "Checksum=xxxxxxxx\n" for the given CRC
+    static std::string checksumLine(uint32_t crc);
+
+private:
+    Options options;
+};
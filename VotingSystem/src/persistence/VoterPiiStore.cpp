@@ -0,0 +1,160 @@
+#include "VoterPiiStore.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const unsigned PHONE_COUNT_SHIFT = 59;          // Digit count in the top five bits, digits below
+const uint32_t PACKED_PHONE_LENGTH = UINT32_MAX;  // In place of a length: eight packed bytes follow
+
+// Arena records are four (uint32 length, bytes) pairs; a packed phone number
+// is PACKED_PHONE_LENGTH followed by the uint64 value
+void writeField(char*& out, std::string_view field) {
+    uint32_t length = static_cast<uint32_t>(field.size());
+    std::memcpy(out, &length, sizeof(length));
+    out += sizeof(length);
+    std::memcpy(out, field.data(), field.size());
+    out += field.size();
+}
+
+std::string_view readField(const char*& in) {
+    uint32_t length;
+    std::memcpy(&length, in, sizeof(length));
+    in += sizeof(length);
+    std::string_view field(in, length);
+    in += length;
+    return field;
+}
+
+// Value of the key=value line starting at offset; advances offset past the line
+std::string_view readSnapshotValue(std::string_view contents, size_t& offset) {
+    size_t lineEnd = contents.find('\n', offset);
+    if (lineEnd == std::string_view::npos) {
+        lineEnd = contents.size();
+    }
+    std::string_view line = contents.substr(offset, lineEnd - offset);
+    offset = lineEnd + 1;
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    size_t equalPos = line.find('=');
+    return equalPos == std::string_view::npos ? std::string_view() : line.substr(equalPos + 1);
+}
+
+} // namespace
+
+uint64_t VoterPiiStore::packPhoneNumber(std::string_view phoneNumber) {
+    if (phoneNumber.empty() || phoneNumber.size() > MAX_PACKED_PHONE_DIGITS) {
+        return 0;
+    }
+    uint64_t digits = 0;
+    for (char c : phoneNumber) {
+        if (c < '0' || c > '9') {
+            return 0;
+        }
+        digits = digits * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return (static_cast<uint64_t>(phoneNumber.size()) << PHONE_COUNT_SHIFT) | digits;
+}
+
+std::string_view VoterPiiStore::unpackPhoneNumber(uint64_t packedPhone, PhoneDigits& digits) {
+    size_t count = static_cast<size_t>(packedPhone >> PHONE_COUNT_SHIFT);
+    uint64_t value = packedPhone & ((uint64_t(1) << PHONE_COUNT_SHIFT) - 1);
+    count = std::min(count, digits.size());
+    for (size_t i = count; i > 0; --i) {
+        digits[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return std::string_view(digits.data(), count);
+}
+
+VoterPiiStore::VoterPiiStore() : chunkCapacity(0), chunkUsed(0), totalCapacity(0) {}
+
+VoterPiiStore::VoterPiiStore(MappedFile snapshot)
+    : snapshot(std::move(snapshot)), chunkCapacity(0), chunkUsed(0), totalCapacity(0) {}
+
+char* VoterPiiStore::reserve(size_t bytes, Ref& ref) {
+    if (chunks.empty() || chunkUsed + bytes > chunkCapacity) {
+        // Grow geometrically so a store holding a single voter stays small
+        chunkCapacity = std::max(bytes, std::min(MAX_CHUNK_SIZE, totalCapacity));
+        chunks.emplace_back(new char[chunkCapacity]);
+        totalCapacity += chunkCapacity;
+        chunkUsed = 0;
+    }
+    ref = (static_cast<Ref>(chunks.size() - 1) << 32) | chunkUsed;
+    char* out = chunks.back().get() + chunkUsed;
+    chunkUsed += bytes;
+    return out;
+}
+
+VoterPiiStore::Ref VoterPiiStore::append(std::string_view firstName, std::string_view lastName,
+                                         std::string_view phoneNumber, std::string_view address) {
+    uint64_t packedPhone = packPhoneNumber(phoneNumber);
+    size_t bytes = 4 * sizeof(uint32_t) + firstName.size() + lastName.size() +
+                   (packedPhone ? sizeof(packedPhone) : phoneNumber.size()) + address.size();
+    Ref ref;
+    char* out = reserve(bytes, ref);
+    writeField(out, firstName);
+    writeField(out, lastName);
+    if (packedPhone) {
+        std::memcpy(out, &PACKED_PHONE_LENGTH, sizeof(PACKED_PHONE_LENGTH));
+        std::memcpy(out + sizeof(PACKED_PHONE_LENGTH), &packedPhone, sizeof(packedPhone));
+        out += sizeof(PACKED_PHONE_LENGTH) + sizeof(packedPhone);
+    } else {
+        writeField(out, phoneNumber);
+    }
+    writeField(out, address);
+    return ref;
+}
+
+VoterPiiStore::Ref VoterPiiStore::snapshotRecord(size_t offset) {
+    return SNAPSHOT_FLAG | static_cast<Ref>(offset);
+}
+
+VoterPiiStore::Record VoterPiiStore::get(Ref ref, PhoneDigits& phoneDigits) const {
+    Record record;
+    if (ref & SNAPSHOT_FLAG) {
+        std::string_view contents = snapshot.contents();
+        size_t offset = static_cast<size_t>(ref & ~SNAPSHOT_FLAG);
+        record.firstName = readSnapshotValue(contents, offset);
+        record.lastName = readSnapshotValue(contents, offset);
+        record.phoneNumber = readSnapshotValue(contents, offset);
+        record.address = readSnapshotValue(contents, offset);
+        return record;
+    }
+    const char* in = chunks[ref >> 32].get() + (ref & 0xFFFFFFFFu);
+    record.firstName = readField(in);
+    record.lastName = readField(in);
+    uint32_t phoneLength;
+    std::memcpy(&phoneLength, in, sizeof(phoneLength));
+    if (phoneLength == PACKED_PHONE_LENGTH) {
+        uint64_t packedPhone;
+        std::memcpy(&packedPhone, in + sizeof(phoneLength), sizeof(packedPhone));
+        in += sizeof(phoneLength) + sizeof(packedPhone);
+        record.phoneNumber = unpackPhoneNumber(packedPhone, phoneDigits);
+    } else {
+        record.phoneNumber = readField(in);
+    }
+    record.address = readField(in);
+    return record;
+}
+
+std::string_view VoterPiiStore::snapshotContents() const {
+    return snapshot.contents();
+}
+
+void VoterPiiStore::releaseSnapshotPages() const {
+    snapshot.releaseResidentPages();
+}
+
+size_t VoterPiiStore::arenaBytes() const {
+    return totalCapacity;
+}
+
+size_t VoterPiiStore::ownedSnapshotBytes() const {
+    return snapshot.isMapped() ? 0 : snapshot.size();
+}
+
+size_t VoterPiiStore::mappedSnapshotBytes() const {
+    return snapshot.isMapped() ? snapshot.size() : 0;
+}
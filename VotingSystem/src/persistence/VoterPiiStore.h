@@ -0,0 +1,73 @@
+#pragma once
+#include "MappedFile.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Cold storage for voter personal details. Voting only needs a voter's ID,
+// region and voted flag; names, phone number and address are kept here and
+// decoded only when a display or export asks for them.
+//
+// Records either live in an in-memory arena (voters registered at runtime) or
+// point at the Voter<i>_FirstName/_LastName/_Phone/_Address lines of a
+// memory-mapped snapshot, which the OS pages in on demand. Arena records hold
+// an all-digit phone number packed into eight bytes; snapshot records leave it
+// as the text of the mapped line, which costs no heap at all.
+class VoterPiiStore {
+public:
+    struct Record {
+        std::string_view firstName;
+        std::string_view lastName;
+        std::string_view phoneNumber;
+        std::string_view address;
+    };
+
+    using Ref = uint64_t;
+
+    // Phone numbers of up to MAX_PACKED_PHONE_DIGITS digits are kept as an
+    // integer, with the digit count in the top bits so leading zeros survive.
+    // Anything else packs to 0 and is stored as text.
+    static constexpr size_t MAX_PACKED_PHONE_DIGITS = 17;
+    using PhoneDigits = std::array<char, MAX_PACKED_PHONE_DIGITS>;
+    static uint64_t packPhoneNumber(std::string_view phoneNumber);
+    static std::string_view unpackPhoneNumber(uint64_t packedPhone, PhoneDigits& digits);
+
+    VoterPiiStore();
+    explicit VoterPiiStore(MappedFile snapshot);
+
+    VoterPiiStore(const VoterPiiStore&) = delete;
+    VoterPiiStore& operator=(const VoterPiiStore&) = delete;
+
+    // Copies the fields into the arena, packing the phone number when it can
+    Ref append(std::string_view firstName, std::string_view lastName,
+               std::string_view phoneNumber, std::string_view address);
+    // offset is the start of a Voter<i>_FirstName line followed by the
+    // LastName, Phone and Address lines of the same voter
+    static Ref snapshotRecord(size_t offset);
+
+    // Views stay valid for the lifetime of the store, except a packed phone
+    // number, which is written to phoneDigits
+    Record get(Ref ref, PhoneDigits& phoneDigits) const;
+
+    std::string_view snapshotContents() const;
+    void releaseSnapshotPages() const;
+    size_t arenaBytes() const;
+    // Snapshot bytes held in memory (a decompressed or unmappable file) and
+    // bytes only mapped from the file, which the OS can drop and re-read
+    size_t ownedSnapshotBytes() const;
+    size_t mappedSnapshotBytes() const;
+
+private:
+    static constexpr Ref SNAPSHOT_FLAG = Ref(1) << 63;
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+    MappedFile snapshot;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    size_t chunkCapacity;
+    size_t chunkUsed;
+    size_t totalCapacity;
+
+    char* reserve(size_t bytes, Ref& ref);
+};
@@ -1,6 +1,5 @@
 #include "Region.h"
 #include "../core/Candidate.h"
-#include "../core/Voter.h"
 #include "../core/party.h"
 #include <iostream>
 #include <algorithm>
@@ -65,32 +64,30 @@ const std::vector<std::shared_ptr<Candidate>>& Region::getCandidates() const {
     return candidates;
 }
 
-void Region::addVoter(std::shared_ptr<Voter> voter) {
-    if (!voter) {
-        std::cout << "Error: Cannot add null voter to region.\n";
-        return;
-    }
-    
-    int voterId = voter->getUniqueId();
-    if (voterIds.find(voterId) != voterIds.end()) {
-        std::cout << "Error: Voter with ID " << voterId 
-                  << " is already registered in region '" << name << "'.\n";
+void Region::attachVoterStore(std::shared_ptr<const VoterStore> store) {
+    voterStore = std::move(store);
+    voterPositions.clear();
+}
+
+void Region::addVoter(VoterStore::Position position) {
+    if (!voterStore || position >= voterStore->size()) {
+        std::cout << "Error: Cannot add unknown voter to region.\n";
         return;
     }
     
-    voters.push_back(voter);
-    voterIds.insert(voterId);
-    
-    std::cout << "Voter '" << voter->getFullName() 
+    voterPositions.push_back(position);
+    std::cout << "Voter '" << voterStore->at(position)->getFullName() 
               << "' assigned to region '" << name << "'.\n";
 }
 
+// Membership is the voter's own region attribute, found through the store's ID index
 bool Region::hasVoter(int voterId) const {
-    return voterIds.find(voterId) != voterIds.end();
+    const Voter* voter = voterStore ? voterStore->find(voterId) : nullptr;
+    return voter && voter->getRegion().get() == this;
 }
 
-const std::vector<std::shared_ptr<Voter>>& Region::getVoters() const {
-    return voters;
+VoterStore::View Region::getVoters() const {
+    return VoterStore::View(voterStore.get(), &voterPositions);
 }
 
 void Region::registerParty(std::shared_ptr<Party> party) {
@@ -116,6 +113,17 @@ const std::vector<std::shared_ptr<Party>>& Region::getParties() const {
     return parties;
 }
 
+void Region::restoreCandidate(std::shared_ptr<Candidate> candidate) {
+    candidates.push_back(candidate);
+    if (candidate->getParty()) {
+        registerParty(candidate->getParty());
+    }
+}
+
+void Region::restoreVoter(VoterStore::Position position) {
+    voterPositions.push_back(position);
+}
+
 bool Region::canVoterVoteInRegion(int voterId) const {
     return hasVoter(voterId);
 }
@@ -135,7 +143,7 @@ void Region::displayRegionInfo() const {
     std::cout << "\n=== Region: " << name << " (" << code << ") ===\n";
     std::cout << "Parties: " << parties.size() << "\n";
     std::cout << "Candidates: " << candidates.size() << "\n";
-    std::cout << "Registered Voters: " << voters.size() << "\n";
+    std::cout << "Registered Voters: " << voterPositions.size() << "\n";
 }
 
 void Region::displayCandidatesInRegion() const {
@@ -158,12 +166,13 @@ void Region::displayCandidatesInRegion() const {
 
 void Region::displayVotersInRegion() const {
     std::cout << "\n=== Voters in " << name << " ===\n";
+    VoterStore::View voters = getVoters();
     if (voters.empty()) {
         std::cout << "No voters registered in this region.\n";
         return;
     }
     
-    for (const auto& voter : voters) {
+    for (const Voter* voter : voters) {
         std::cout << "- " << voter->getFullName() 
                   << " (ID: " << voter->getUniqueId() << ")";
         if (voter->hasVoted()) {
@@ -2,11 +2,10 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <unordered_set>
+#include "../core/VoterStore.h"
 
 // Forward declarations to avoid circular dependencies
 class Candidate;
-class Voter;
 class Party;
 
 class Region {
@@ -22,16 +21,22 @@ public:
     bool hasPartyCandidate(std::shared_ptr<Party> party) const;
     const std::vector<std::shared_ptr<Candidate>>& getCandidates() const;
     
-    // Voter management for this region
-    void addVoter(std::shared_ptr<Voter> voter);
+    // Voter management for this region. Voters live in their election's
+    // store; the region keeps their positions in it.
+    void attachVoterStore(std::shared_ptr<const VoterStore> store);
+    void addVoter(VoterStore::Position position);
     bool hasVoter(int voterId) const;
-    const std::vector<std::shared_ptr<Voter>>& getVoters() const;
+    VoterStore::View getVoters() const;
     
     // Party presence in region
     void registerParty(std::shared_ptr<Party> party);
     bool hasParty(std::shared_ptr<Party> party) const;
     const std::vector<std::shared_ptr<Party>>& getParties() const;
     
+    // Snapshot restore: skips duplicate checks and console output
+    void restoreCandidate(std::shared_ptr<Candidate> candidate);
+    void restoreVoter(VoterStore::Position position);
+    
     // Validation methods
     bool canVoterVoteInRegion(int voterId) const;
     bool isCandidateInRegion(std::shared_ptr<Candidate> candidate) const;
@@ -45,7 +50,7 @@ private:
     std::string name;
     std::string code;
     std::vector<std::shared_ptr<Candidate>> candidates;
-    std::vector<std::shared_ptr<Voter>> voters;
+    std::shared_ptr<const VoterStore> voterStore;
+    std::vector<VoterStore::Position> voterPositions;
     std::vector<std::shared_ptr<Party>> parties;
-    std::unordered_set<int> voterIds; // For quick lookup
 };
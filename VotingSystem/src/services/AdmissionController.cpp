@@ -0,0 +1,182 @@
+#include "AdmissionController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double INITIAL_AVERAGE_MICROS[] = {200.0, 500.0, 1000.0, 50000.0};   // Until measured
+const double SMOOTHING = 0.1;
+const int MAX_RETRY_AFTER_MS = 30000;
+
+thread_local bool queueingForbidden = false;   // Set by NoQueueScope
+
+size_t indexOf(OperationClass operation) {
+    return static_cast<size_t>(operation);
+}
+
+} // namespace
+
+AdmissionController::Ticket::Ticket(Ticket&& other) noexcept {
+    *this = std::move(other);
+}
+
+AdmissionController::Ticket& AdmissionController::Ticket::operator=(Ticket&& other) noexcept {
+    if (this != &other) {
+        release();
+        controller = other.controller;
+        electionId = other.electionId;
+        operation = other.operation;
+        admittedAt = other.admittedAt;
+        retryAfterMs = other.retryAfterMs;
+        other.controller = nullptr;
+    }
+    return *this;
+}
+
+AdmissionController::Ticket::~Ticket() {
+    release();
+}
+
+void AdmissionController::Ticket::release() {
+    if (controller) {
+        controller->release(*this);
+        controller = nullptr;
+    }
+}
+
+AdmissionController::NoQueueScope::NoQueueScope() : previous(queueingForbidden) {
+    queueingForbidden = true;
+}
+
+AdmissionController::NoQueueScope::~NoQueueScope() {
+    queueingForbidden = previous;
+}
+
+AdmissionController::AdmissionController() : AdmissionController(Options()) {}
+
+AdmissionController::AdmissionController(const Options& options)
+    : options(options), running(0), runningOtherThanVotes(0), waiting(0) {
+    for (size_t i = 0; i < CLASS_COUNT; ++i) {
+        averageMicros[i] = INITIAL_AVERAGE_MICROS[i];
+    }
+}
+
+void AdmissionController::setOptions(const Options& newOptions) {
+    std::lock_guard<std::mutex> lock(mutex);
+    options = newOptions;
+    released.notify_all();   // Raised limits may let waiters in
+}
+
+AdmissionController::Options AdmissionController::getOptions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return options;
+}
+
+AdmissionController::ClassStats AdmissionController::getStats(OperationClass operation) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats[indexOf(operation)];
+}
+
+size_t AdmissionController::getRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+size_t AdmissionController::getQueued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiting;
+}
+
+const AdmissionController::ClassLimits& AdmissionController::limitsFor(OperationClass operation) const {
+    switch (operation) {
+        case OperationClass::Vote: return options.vote;
+        case OperationClass::Read: return options.read;
+        case OperationClass::Write: return options.write;
+        case OperationClass::Bulk: return options.bulk;
+    }
+    return options.read;
+}
+
+bool AdmissionController::fits(const Lane& lane, OperationClass operation) const {
+    if (lane.running >= limitsFor(operation).maxConcurrent || running >= options.capacity) {
+        return false;
+    }
+    size_t shared = options.capacity - std::min(options.voteReserve, options.capacity);
+    return operation == OperationClass::Vote || runningOtherThanVotes < shared;
+}
+
+int AdmissionController::retryAfterMs(const Lane& lane, OperationClass operation) const {
+    // Time for everything ahead in the lane to drain at the lane's concurrency
+    size_t concurrency = std::max<size_t>(1, limitsFor(operation).maxConcurrent);
+    double ahead = static_cast<double>(lane.running + lane.queued + 1);
+    double micros = averageMicros[indexOf(operation)] * ahead / static_cast<double>(concurrency);
+    return std::min(MAX_RETRY_AFTER_MS, std::max(1, static_cast<int>(std::ceil(micros / 1000.0))));
+}
+
+void AdmissionController::forgetIfIdle(LaneMap::iterator slot) {
+    // Lanes exist only while in use, so unknown or finished election IDs cost nothing
+    if (slot->second.running == 0 && slot->second.queued == 0) {
+        lanes.erase(slot);
+    }
+}
+
+size_t AdmissionController::getLaneCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lanes.size();
+}
+
+AdmissionController::Ticket AdmissionController::admit(int electionId, OperationClass operation) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto slot = lanes.emplace(std::make_pair(electionId, operation), Lane()).first;
+    Lane& lane = slot->second;
+    ClassStats& classStats = stats[indexOf(operation)];
+    Ticket ticket;
+    ticket.electionId = electionId;
+    ticket.operation = operation;
+
+    bool admitted = fits(lane, operation);
+    if (!admitted && !queueingForbidden && lane.queued < limitsFor(operation).maxQueued) {
+        ++lane.queued;
+        ++waiting;
+        admitted = released.wait_for(lock, options.maxQueueWait, [&]() { return fits(lane, operation); });
+        --waiting;
+        --lane.queued;
+        if (admitted) {
+            ++classStats.queued;
+        }
+    }
+    if (!admitted) {
+        ++classStats.rejected;
+        ticket.retryAfterMs = retryAfterMs(lane, operation);
+        forgetIfIdle(slot);
+        return ticket;
+    }
+
+    ++lane.running;
+    ++running;
+    if (operation != OperationClass::Vote) {
+        ++runningOtherThanVotes;
+    }
+    ++classStats.admitted;
+    ticket.controller = this;
+    ticket.admittedAt = std::chrono::steady_clock::now();
+    return ticket;
+}
+
+void AdmissionController::release(Ticket& ticket) {
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - ticket.admittedAt).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto slot = lanes.find(std::make_pair(ticket.electionId, ticket.operation));
+    --slot->second.running;
+    forgetIfIdle(slot);
+    --running;
+    if (ticket.operation != OperationClass::Vote) {
+        --runningOtherThanVotes;
+    }
+    double& average = averageMicros[indexOf(ticket.operation)];
+    average += SMOOTHING * (micros - average);
+    // Any waiter may fit now: its own lane or the shared capacity just freed up
+    if (waiting > 0) {
+        released.notify_all();
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+
+// What a request costs and how urgent it is; each class has its own limits
+enum class OperationClass {
+    Vote,    // castVote, castVoteInRegion
+    Read,    // Small lookups: candidates, results, voter status, regions, parties
+    Write,   // Registrations and election setup
+    Bulk     // Whole-election scans and file I/O: voter lists, exports, imports, saves
+};
+
+// Bounds the work a ClearBallotService takes on. Every (election, class) pair
+// is a lane with its own concurrency limit and a short bounded queue; a
+// request that finds its lane full waits in the queue for at most
+// maxQueueWait, and one that finds the queue full too is refused at once with
+// an estimate of when to retry. On top of the lanes, the service as a whole
+// runs at most `capacity` requests, of which `voteReserve` slots only votes
+// may take, so no flood of reads or exports can crowd voting out. A thread
+// that serves many clients (a transport's event loop) never queues: while it
+// holds a NoQueueScope its requests are admitted or refused at once.
+class AdmissionController {
+public:
+    struct ClassLimits {
+        size_t maxConcurrent;   // Per election
+        size_t maxQueued;       // Per election; 0 = refuse instead of waiting
+    };
+
+    struct Options {
+        ClassLimits vote{32, 256};
+        ClassLimits read{8, 64};
+        ClassLimits write{4, 64};
+        ClassLimits bulk{1, 2};
+        size_t capacity = 64;
+        size_t voteReserve = 16;
+        std::chrono::milliseconds maxQueueWait{100};
+    };
+
+    // Held for the duration of an admitted request; refused tickets carry the hint
+    class Ticket {
+    public:
+        Ticket() = default;
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+        ~Ticket();
+
+        explicit operator bool() const { return controller != nullptr; }
+        int getRetryAfterMs() const { return retryAfterMs; }
+
+    private:
+        friend class AdmissionController;
+        AdmissionController* controller = nullptr;
+        int electionId = 0;
+        OperationClass operation = OperationClass::Read;
+        std::chrono::steady_clock::time_point admittedAt;
+        int retryAfterMs = 0;
+
+        void release();
+    };
+
+    struct ClassStats {
+        uint64_t admitted = 0;
+        uint64_t queued = 0;     // Admitted after waiting
+        uint64_t rejected = 0;
+    };
+
+    // For the lifetime of the scope, admit() on this thread refuses instead of
+    // waiting, so one saturated lane cannot stall every other connection the
+    // thread serves
+    class NoQueueScope {
+    public:
+        NoQueueScope();
+        ~NoQueueScope();
+        NoQueueScope(const NoQueueScope&) = delete;
+        NoQueueScope& operator=(const NoQueueScope&) = delete;
+    private:
+        bool previous;
+    };
+
+    AdmissionController();
+    explicit AdmissionController(const Options& options);
+
+    void setOptions(const Options& options);
+    Options getOptions() const;
+
+    Ticket admit(int electionId, OperationClass operation);
+    ClassStats getStats(OperationClass operation) const;
+    size_t getRunning() const;
+    size_t getQueued() const;
+    // Lanes with a request running or queued; idle lanes are dropped
+    size_t getLaneCount() const;
+
+private:
+    static constexpr size_t CLASS_COUNT = 4;
+
+    struct Lane {
+        size_t running = 0;
+        size_t queued = 0;
+    };
+
+    using LaneMap = std::map<std::pair<int, OperationClass>, Lane>;
+
+    Options options;
+    mutable std::mutex mutex;
+    std::condition_variable released;
+    LaneMap lanes;   // Only lanes in use; references stay valid while a waiter holds one
+    size_t running;
+    size_t runningOtherThanVotes;
+    size_t waiting;
+    double averageMicros[CLASS_COUNT];   // Smoothed service time per class
+    ClassStats stats[CLASS_COUNT];
+
+    const ClassLimits& limitsFor(OperationClass operation) const;
+    bool fits(const Lane& lane, OperationClass operation) const;
+    int retryAfterMs(const Lane& lane, OperationClass operation) const;
+    void release(Ticket& ticket);
+    void forgetIfIdle(LaneMap::iterator slot);
+};
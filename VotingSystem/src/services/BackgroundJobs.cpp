@@ -0,0 +1,172 @@
+#include "BackgroundJobs.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+#ifdef __linux__
+#define CLEARBALLOT_HAVE_THREAD_NICE 1
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+const int LOW_PRIORITY_NICE = 10;
+
+} // namespace
+#endif
+
+BackgroundJobs::BackgroundJobs() : BackgroundJobs(Options()) {}
+
+BackgroundJobs::BackgroundJobs(const Options& options)
+    : options(options), nextJobId(1), stopping(false) {
+    this->options.workerThreads = std::max<size_t>(1, options.workerThreads);
+}
+
+BackgroundJobs::~BackgroundJobs() {
+    shutdown();
+}
+
+const char* BackgroundJobs::stateName(State state) {
+    switch (state) {
+        case State::Queued: return "Queued";
+        case State::Running: return "Running";
+        case State::Succeeded: return "Succeeded";
+        case State::Failed: return "Failed";
+        case State::Cancelled: return "Cancelled";
+    }
+    return "Unknown";
+}
+
+int BackgroundJobs::submit(int electionId, const std::string& description, Job job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping || queue.size() >= options.maxQueued) {
+        return -1;
+    }
+    // Workers start with the first job, so idle services carry no threads
+    if (workers.empty()) {
+        for (size_t i = 0; i < options.workerThreads; ++i) {
+            workers.emplace_back(&BackgroundJobs::run, this);
+        }
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->status.jobId = nextJobId++;
+    entry->status.electionId = electionId;
+    entry->status.description = description;
+    entry->job = std::move(job);
+    entry->submittedAt = std::chrono::steady_clock::now();
+    jobs[entry->status.jobId] = entry;
+    queue.push_back(entry);
+    available.notify_one();
+    return entry->status.jobId;
+}
+
+bool BackgroundJobs::getStatus(int jobId, Status& status) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(jobId);
+    if (it == jobs.end()) {
+        return false;
+    }
+    const Entry& entry = *it->second;
+    status = entry.status;
+    status.progress = entry.progress.load();
+    bool done = entry.status.state != State::Queued && entry.status.state != State::Running;
+    auto end = done ? entry.finishedAt : std::chrono::steady_clock::now();
+    status.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - entry.submittedAt);
+    return true;
+}
+
+size_t BackgroundJobs::cancelQueued() {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t cancelled = queue.size();
+    for (auto& entry : queue) {
+        entry->status.state = State::Cancelled;
+        entry->status.result = ServiceResponse(false, "Job cancelled before it started.");
+        entry->finishedAt = std::chrono::steady_clock::now();
+        entry->job = nullptr;
+        retire(entry->status.jobId);
+    }
+    queue.clear();
+    return cancelled;
+}
+
+void BackgroundJobs::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    cancelQueued();
+    available.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t BackgroundJobs::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+// Called with mutex held once a job has finished
+void BackgroundJobs::retire(int jobId) {
+    finished.push_back(jobId);
+    while (finished.size() > options.maxRetained) {
+        jobs.erase(finished.front());
+        finished.pop_front();
+    }
+}
+
+void BackgroundJobs::run() {
+    if (options.lowPriority) {
+        lowerPriority();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        available.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            break;
+        }
+        std::shared_ptr<Entry> entry = queue.front();
+        queue.pop_front();
+        entry->status.state = State::Running;
+        Job job = std::move(entry->job);
+        lock.unlock();
+
+        ServiceResponse result;
+        try {
+            result = job(entry->progress);
+        } catch (const std::exception& e) {
+            result = ServiceResponse(false, std::string("[SERVICE ERROR] ") + e.what());
+        }
+
+        lock.lock();
+        entry->status.state = result.success ? State::Succeeded : State::Failed;
+        entry->status.result = std::move(result);
+        entry->progress.store(100);
+        entry->finishedAt = std::chrono::steady_clock::now();
+        retire(entry->status.jobId);
+    }
+}
+
+#ifdef CLEARBALLOT_HAVE_THREAD_NICE
+
+// On Linux the nice value is per thread, so only this worker is demoted
+void BackgroundJobs::lowerPriority() {
+    pid_t tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    if (::setpriority(PRIO_PROCESS, static_cast<id_t>(tid), LOW_PRIORITY_NICE) != 0) {
+        std::cout << "[JOBS] Could not lower background worker priority; it runs at normal priority.\n";
+    }
+}
+
+#else
+
+void BackgroundJobs::lowerPriority() {}
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+#include "ServiceResponse.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs long election operations (saves, loads, exports, imports) off the
+// request path on a small pool of its own. Callers get a job ID straight
+// away and poll for progress and the final response. The workers run at a
+// lower OS scheduling priority than the request threads, so under CPU
+// contention a running export yields to votes and queries.
+class BackgroundJobs {
+public:
+    enum class State { Queued, Running, Succeeded, Failed, Cancelled };
+
+    struct Options {
+        size_t workerThreads = 1;
+        size_t maxQueued = 16;      // Submissions beyond this are refused
+        size_t maxRetained = 256;   // Finished jobs kept for polling, oldest dropped first
+        bool lowPriority = true;
+    };
+
+    struct Status {
+        int jobId = 0;
+        int electionId = 0;
+        std::string description;
+        State state = State::Queued;
+        int progress = 0;           // Percent
+        std::chrono::milliseconds elapsed{0};   // Since submission
+        ServiceResponse result;     // Set once finished
+    };
+
+    // Does the work and returns its response; may raise progress (0-100) as it goes
+    using Job = std::function<ServiceResponse(std::atomic<int>& progress)>;
+
+    BackgroundJobs();
+    explicit BackgroundJobs(const Options& options);
+    ~BackgroundJobs();
+
+    BackgroundJobs(const BackgroundJobs&) = delete;
+    BackgroundJobs& operator=(const BackgroundJobs&) = delete;
+
+    // Returns the new job's ID, or -1 when the queue is full or the pool is shut down
+    int submit(int electionId, const std::string& description, Job job);
+    bool getStatus(int jobId, Status& status) const;
+    // Marks every job not yet started as cancelled; running jobs finish
+    size_t cancelQueued();
+    void shutdown();
+
+    size_t getQueuedCount() const;
+    static const char* stateName(State state);
+
+private:
+    struct Entry {
+        Status status;
+        Job job;
+        std::atomic<int> progress{0};
+        std::chrono::steady_clock::time_point submittedAt;
+        std::chrono::steady_clock::time_point finishedAt;
+    };
+
+    Options options;
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::map<int, std::shared_ptr<Entry>> jobs;   // Every retained job by ID
+    std::deque<std::shared_ptr<Entry>> queue;
+    std::deque<int> finished;                      // Finished job IDs, oldest first
+    std::vector<std::thread> workers;
+    int nextJobId;
+    bool stopping;
+
+    void run();
+    void retire(int jobId);
+    static void lowerPriority();
+};
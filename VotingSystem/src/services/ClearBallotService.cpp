@@ -1,15 +1,51 @@
 #include "ClearBallotService.h"
+#include "BackgroundJobs.h"
+#include "../persistence/CsvExportEngine.h"
+#include "../persistence/CsvVoterImporter.h"
+#include "../persistence/LzBlockFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
+
+namespace {
+
+// Maps one step of a bulk job onto [from, to] of the job's percent progress
+Election::Progress progressStep(std::atomic<int>* progress, int from, int to) {
+    if (!progress) {
+        return nullptr;
+    }
+    return [progress, from, to](size_t done, size_t total) {
+        double fraction = total == 0 ? 1.0 : static_cast<double>(std::min(done, total)) / static_cast<double>(total);
+        progress->store(from + static_cast<int>((to - from) * fraction), std::memory_order_relaxed);
+    };
+}
+
+} // namespace
 
 ClearBallotService::ClearBallotService() 
-    : nextElectionId(1), serviceRunning(false) {
+    : elections(std::make_unique<ElectionDirectory>()), nextElectionId(1), defaultElectionId(-1), serviceRunning(false),
+      acceptingRequests(true), inFlightRequests(0), flushesAbandoned(false), jobs(std::make_unique<BackgroundJobs>()),
+      memoryBudget(0), residentBytes(0), accessClock(0), evictionCount(0), reloadCount(0) {
 }
 
 ClearBallotService::~ClearBallotService() {
     if (serviceRunning) {
         stopService();
     }
+    // Jobs call back into the service, so they must stop before any other member goes
+    jobs->shutdown();
+    
+    // Spilled snapshots back elections only for this service's lifetime
+    elections->forEach([](ElectionDirectory::Entry& entry) {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        entry.election.reset();
+        if (!entry.spillFile.empty()) {
+            std::remove(entry.spillFile.c_str());
+        }
+    });
 }
 
 // Service lifecycle
@@ -22,29 +58,117 @@ bool ClearBallotService::startService() {
     }
     
     serviceRunning = true;
+    acceptingRequests.store(true);
     std::cout << "[SERVICE] ClearBallot service started successfully.\n";
     return true;
 }
 
 bool ClearBallotService::stopService() {
-    std::lock_guard<std::mutex> lock(electionsMutex);
+    {
+        std::lock_guard<std::mutex> lock(electionsMutex);
+        
+        if (!serviceRunning) {
+            std::cout << "[SERVICE] ClearBallot service is not running.\n";
+            return true;
+        }
+        
+        // Stop intake first; a concurrent stopService() now sees the service as stopped
+        serviceRunning = false;
+        acceptingRequests.store(false);
+    }
     
-    if (!serviceRunning) {
-        std::cout << "[SERVICE] ClearBallot service is not running.\n";
-        return true;
+    auto deadline = std::chrono::steady_clock::now() + shutdownOptions.deadline;
+    
+    // Jobs not yet started would only be refused now; a running one counts as in flight
+    size_t cancelledJobs = jobs->cancelQueued();
+    if (cancelledJobs > 0) {
+        std::cout << "[SERVICE] Cancelled " << cancelledJobs << " queued background job(s).\n";
     }
     
-    // Save all active elections before shutdown
-    for (const auto& pair : elections) {
-        auto election = pair.second;
-        std::string filename = "election_" + std::to_string(pair.first) + "_shutdown.txt";
-        election->saveCompleteElectionData(filename);
-        std::cout << "[SERVICE] Election " << pair.first << " data saved to " << filename << "\n";
+    if (!waitForInFlightRequests(deadline)) {
+        std::cout << "[SERVICE] Warning: " << inFlightRequests.load()
+                  << " request(s) still in progress at shutdown deadline.\n";
+    }
+    
+    // Save all active elections in parallel, outside the elections lock
+    ShutdownCoordinator::Result result = flushElections(deadline);
+    if (result.deadlineExceeded) {
+        flushesAbandoned.store(true);
+        std::cout << "[SERVICE] Warning: shutdown deadline exceeded, "
+                  << result.abandoned << " election(s) not saved.\n";
     }
     
-    serviceRunning = false;
     std::cout << "[SERVICE] ClearBallot service stopped successfully.\n";
-    return true;
+    return result.failed == 0 && !result.deadlineExceeded;
+}
+
+bool ClearBallotService::waitForInFlightRequests(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(drainMutex);
+    return drainCondition.wait_until(lock, deadline, [this]() {
+        return inFlightRequests.load() == 0;
+    });
+}
+
+ShutdownCoordinator::Result ClearBallotService::flushElections(std::chrono::steady_clock::time_point deadline) {
+    std::vector<ShutdownCoordinator::FlushTask> tasks;
+    const bool compressed = shutdownOptions.compressSnapshots;
+    {
+        std::lock_guard<std::mutex> lock(electionsMutex);
+        elections->forEach([&](ElectionDirectory::Entry& entry) {
+            int electionId = entry.id;
+            ElectionDirectory::Entry* target = &entry;
+            tasks.push_back({electionId, [electionId, target, compressed]() {
+                // Write beside the target and rename so an abandoned flush
+                // never leaves a torn snapshot in place of a good one
+                std::string filename = "election_" + std::to_string(electionId) + "_shutdown.txt";
+                if (compressed) {
+                    filename += LzBlockFile::FILE_EXTENSION;
+                }
+                std::string tempFilename = filename + ".tmp";
+                std::remove(tempFilename.c_str());   // Left by an earlier run; never to be renamed into place
+                std::lock_guard<std::mutex> lock(target->mutex);
+                if (target->isResident()) {
+                    if (!target->election->saveCompleteElectionData(tempFilename, compressed)) {
+                        std::cout << "[SERVICE ERROR] Could not save election " << electionId << " to "
+                                  << filename << "\n";
+                        std::remove(tempFilename.c_str());
+                        return false;
+                    }
+                } else {
+                    // An evicted election is already on disk; copy it rather than reload it
+                    std::ifstream spilled(target->spillFile, std::ios::binary);
+                    std::ofstream copy(tempFilename, std::ios::binary);
+                    bool copied = spilled.is_open() && copy.is_open();
+                    if (copied) {
+                        copy << spilled.rdbuf();
+                        copy.close();
+                        copied = copy.good();
+                    }
+                    if (!copied) {
+                        std::cout << "[SERVICE ERROR] Could not copy " << target->spillFile << " to "
+                                  << filename << "\n";
+                        copy.close();
+                        std::remove(tempFilename.c_str());
+                        return false;
+                    }
+                }
+                if (std::rename(tempFilename.c_str(), filename.c_str()) != 0) {
+                    std::cout << "[SERVICE ERROR] Could not finalize " << filename << "\n";
+                    return false;
+                }
+                std::cout << "[SERVICE] Election " + std::to_string(electionId) +
+                             " data saved to " + filename + "\n";
+                return true;
+            }});
+        });
+    }
+    
+    ShutdownCoordinator coordinator(shutdownOptions);
+    return coordinator.run(std::move(tasks), deadline);
+}
+
+bool ClearBallotService::hasAbandonedFlushes() const {
+    return flushesAbandoned.load();
 }
 
 bool ClearBallotService::isRunning() const {
@@ -52,52 +176,277 @@ bool ClearBallotService::isRunning() const {
     return serviceRunning;
 }
 
+bool ClearBallotService::isAcceptingRequests() const {
+    return acceptingRequests.load();
+}
+
+void ClearBallotService::setShutdownOptions(const ShutdownCoordinator::Options& options) {
+    shutdownOptions = options;
+}
+
+const ShutdownCoordinator::Options& ClearBallotService::getShutdownOptions() const {
+    return shutdownOptions;
+}
+
+void ClearBallotService::setAdmissionOptions(const AdmissionController::Options& options) {
+    admission.setOptions(options);
+}
+
+AdmissionController::Options ClearBallotService::getAdmissionOptions() const {
+    return admission.getOptions();
+}
+
+AdmissionController::ClassStats ClearBallotService::getAdmissionStats(OperationClass operation) const {
+    return admission.getStats(operation);
+}
+
 // Election management
 int ClearBallotService::createElection(const std::string& title) {
+    RequestGuard guard(*this, 0, OperationClass::Write);
+    if (!guard.admitted()) {
+        std::cout << "[SERVICE] Rejected election creation: " << guard.rejection().message << "\n";
+        return -1;
+    }
+    
     std::lock_guard<std::mutex> lock(electionsMutex);
     
+    if (nextElectionId > ElectionDirectory::MAX_ID) {
+        std::cout << "[SERVICE] Rejected election creation: election ID space exhausted.\n";
+        return -1;
+    }
     int electionId = nextElectionId++;
-    elections[electionId] = std::make_shared<Election>(title);
+    // The entry is built with its title; once added, lock-free readers can reach
+    // it, so everything else is set under its mutex
+    ElectionDirectory::Entry* entry = elections->add(electionId, std::make_shared<Election>(title));
+    {
+        std::lock_guard<std::mutex> entryLock(entry->mutex);
+        estimateFootprint(*entry);
+    }
     
     std::cout << "[SERVICE] Created election '" << title << "' with ID: " << electionId << "\n";
     return electionId;
 }
 
 bool ClearBallotService::electionExists(int electionId) const {
-    std::lock_guard<std::mutex> lock(electionsMutex);
-    return elections.find(electionId) != elections.end();
+    return elections->find(electionId) != nullptr;
 }
 
 std::shared_ptr<Election> ClearBallotService::getElection(int electionId) {
-    std::lock_guard<std::mutex> lock(electionsMutex);
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
+        return nullptr;
+    }
+    // The caller may keep the pointer indefinitely, so it must stay the live copy
+    auto election = lockEntry(*entry);
+    if (!election) {
+        return nullptr;
+    }
+    entry->pinned = true;
+    return entry->election;
+}
+
+std::string ClearBallotService::getElectionTitle(int electionId) const {
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
+        return "";
+    }
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    return entry->title;
+}
+
+ClearBallotService::LockedElection::LockedElection(ClearBallotService& service, ElectionDirectory::Entry& entry,
+                                                   std::unique_lock<std::mutex> lock)
+    : service(&service), entry(&entry), election(entry.election.get()), lock(std::move(lock)) {}
+
+ClearBallotService::LockedElection::LockedElection(LockedElection&& other) noexcept
+    : service(other.service), entry(other.entry), election(other.election), lock(std::move(other.lock)) {
+    other.election = nullptr;
+}
+
+ClearBallotService::LockedElection::~LockedElection() {
+    if (election) {
+        if (service->memoryBudget.load(std::memory_order_relaxed) != 0 &&
+            ++entry->releasesSinceEstimate >= FOOTPRINT_REFRESH_RELEASES) {
+            service->estimateFootprint(*entry);
+        }
+        if (entry->title != election->getTitle()) {
+            entry->title = election->getTitle();   // A load can rename the election
+        }
+    }
+}
+
+ClearBallotService::LockedElection ClearBallotService::lockElection(int electionId) {
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
+        return LockedElection();
+    }
+    return lockEntry(*entry);
+}
+
+ClearBallotService::LockedElection ClearBallotService::lockEntry(ElectionDirectory::Entry& entry) {
+    entry.lastAccess.store(++accessClock, std::memory_order_relaxed);
+    enforceMemoryBudget();
     
-    auto it = elections.find(electionId);
-    if (it != elections.end()) {
-        return it->second;
+    std::unique_lock<std::mutex> lock(entry.mutex);
+    if (!entry.isResident() && !makeResident(entry)) {
+        return LockedElection();
     }
-    return nullptr;
+    return LockedElection(*this, entry, std::move(lock));
 }
 
-std::shared_ptr<Election> ClearBallotService::getElectionSafe(int electionId) {
-    if (!validateElectionId(electionId)) {
-        return nullptr;
+bool ClearBallotService::makeResident(ElectionDirectory::Entry& entry) {
+    auto election = std::make_shared<Election>("");
+    if (!election->loadCompleteElectionData(entry.spillFile)) {
+        std::cout << "[SERVICE ERROR] Could not reload election " << entry.id << " from " << entry.spillFile << "\n";
+        return false;
     }
-    return getElection(electionId);
+    entry.election = std::move(election);
+    entry.footprint = 0;
+    estimateFootprint(entry);
+    ++reloadCount;
+    return true;
 }
 
-std::vector<int> ClearBallotService::getActiveElectionIds() const {
-    std::lock_guard<std::mutex> lock(electionsMutex);
+bool ClearBallotService::evict(ElectionDirectory::Entry& entry) {
+    std::string spillFile;
+    {
+        std::lock_guard<std::mutex> lock(evictionMutex);
+        spillFile = evictionOptions.spillDirectory + "/election_" + std::to_string(entry.id) + "_evicted.txt";
+    }
+    // Saved through a temporary and renamed, so a reloaded election's own mapping is never
+    // overwritten
+    if (!entry.election->saveCompleteElectionData(spillFile)) {
+        return false;
+    }
+    entry.election.reset();
+    entry.spillFile = spillFile;
+    residentBytes -= entry.footprint;
+    entry.footprint = 0;
+    ++evictionCount;
+    return true;
+}
+
+void ClearBallotService::estimateFootprint(ElectionDirectory::Entry& entry) {
+    size_t footprint = entry.election->estimateMemoryUsage();
+    residentBytes += footprint;
+    residentBytes -= entry.footprint;
+    entry.footprint = footprint;
+    entry.releasesSinceEstimate = 0;
+}
+
+void ClearBallotService::enforceMemoryBudget() {
+    // Checked without the lock: every request passes here
+    size_t budget = memoryBudget.load(std::memory_order_relaxed);
+    if (budget == 0 || residentBytes.load(std::memory_order_relaxed) <= budget) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(evictionMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;   // Another thread is already evicting
+    }
     
-    std::vector<int> ids;
-    for (const auto& pair : elections) {
-        ids.push_back(pair.first);
+    // Evict to 90% of the budget so every request does not pay for a pass
+    std::vector<std::pair<uint64_t, ElectionDirectory::Entry*>> candidates;
+    elections->forEach([&](ElectionDirectory::Entry& entry) {
+        candidates.emplace_back(entry.lastAccess.load(std::memory_order_relaxed), &entry);
+    });
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    lock.unlock();
+    
+    size_t target = budget - budget / 10;
+    for (const auto& candidate : candidates) {
+        if (residentBytes.load() <= target) {
+            break;
+        }
+        ElectionDirectory::Entry& entry = *candidate.second;
+        // Entries busy with a request are skipped rather than waited for
+        std::unique_lock<std::mutex> entryLock(entry.mutex, std::try_to_lock);
+        if (entryLock.owns_lock() && entry.isResident() && !entry.pinned) {
+            evict(entry);
+        }
     }
+}
+
+void ClearBallotService::setEvictionOptions(const EvictionOptions& options) {
+    {
+        std::lock_guard<std::mutex> lock(evictionMutex);
+        evictionOptions = options;
+        memoryBudget.store(options.memoryBudgetBytes);
+    }
+    // Footprints are not tracked without a budget, so start from fresh ones
+    if (options.memoryBudgetBytes != 0) {
+        elections->forEach([this](ElectionDirectory::Entry& entry) {
+            std::lock_guard<std::mutex> lock(entry.mutex);
+            if (entry.isResident()) {
+                estimateFootprint(entry);
+            }
+        });
+    }
+    enforceMemoryBudget();
+}
+
+ClearBallotService::EvictionOptions ClearBallotService::getEvictionOptions() const {
+    std::lock_guard<std::mutex> lock(evictionMutex);
+    return evictionOptions;
+}
+
+ClearBallotService::ResidencyStats ClearBallotService::getResidencyStats() const {
+    ResidencyStats stats;
+    elections->forEach([&](ElectionDirectory::Entry& entry) {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        ++(entry.isResident() ? stats.resident : stats.evicted);
+        if (entry.isResident()) {
+            stats.residentBytes += entry.election->estimateMemoryUsage();
+        }
+    });
+    stats.evictions = evictionCount.load();
+    stats.reloads = reloadCount.load();
+    return stats;
+}
+
+std::vector<int> ClearBallotService::getActiveElectionIds() const {
+    std::vector<int> ids;
+    elections->forEach([&](const ElectionDirectory::Entry& entry) {
+        ids.push_back(entry.id);
+    });
     return ids;
 }
 
+int ClearBallotService::getDefaultElection() {
+    std::lock_guard<std::mutex> lock(defaultElectionMutex);
+    if (defaultElectionId != -1 && electionExists(defaultElectionId)) {
+        return defaultElectionId;
+    }
+    
+    int electionId = createElection("2024 Local Elections");
+    if (electionId <= 0) {
+        return -1;
+    }
+    
+    // Default parties and candidates expected by the console apps
+    createParty(electionId, "Democratic Party");
+    createParty(electionId, "Republican Party");
+    createParty(electionId, "Green Party");
+    
+    addCandidateWithParty(electionId, "Alice Johnson", "Democratic Party");
+    addCandidateWithParty(electionId, "Bob Smith", "Republican Party");
+    addCandidateWithParty(electionId, "Carol Green", "Green Party");
+    addCandidate(electionId, "David Independent");
+    
+    defaultElectionId = electionId;
+    std::cout << "[SERVICE] Created default election with ID: " << electionId << "\n";
+    return electionId;
+}
+
 // Voter operations (delegate to Election)
 ServiceResponse ClearBallotService::registerVoter(int electionId, const VoterRegistrationData& voterData) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -115,34 +464,70 @@ ServiceResponse ClearBallotService::registerVoter(int electionId, const VoterReg
 }
 
 ServiceResponse ClearBallotService::castVote(int electionId, int voterId, int candidateIndex) {
-    auto election = getElectionSafe(electionId);
-    if (!election) {
-        return createErrorResponse("Election not found.");
+    RequestGuard guard(*this, electionId, OperationClass::Vote);
+    if (!guard.admitted()) {
+        return guard.rejection();
     }
     
-    // Delegate to existing Election method
-    bool success = election->castVote(voterId, candidateIndex);
-    
-    if (success) {
-        return createSuccessResponse("Vote cast successfully.");
-    } else {
-        return createErrorResponse("Failed to cast vote. Check voter ID and candidate selection.");
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
+        return createErrorResponse("Election not found.");
     }
+    
+    // Votes arriving together take the election lock once per batch
+    return entry->batcher.submit(voterId, candidateIndex, [this, entry](const std::vector<VoteBatcher::Ballot*>& batch) {
+        LockedElection election = lockEntry(*entry);
+        for (VoteBatcher::Ballot* ballot : batch) {
+            if (!election) {
+                ballot->response = createErrorResponse("Election not found.");
+            } else if (election->castVote(ballot->voterId, ballot->candidateIndex)) {
+                ballot->response = createSuccessResponse("Vote cast successfully.");
+            } else {
+                ballot->response = createErrorResponse("Failed to cast vote. Check voter ID and candidate selection.");
+            }
+        }
+    });
+}
+
+ClearBallotService::VoteBatchStats ClearBallotService::getVoteBatchStats() const {
+    VoteBatchStats stats;
+    elections->forEach([&](const ElectionDirectory::Entry& entry) {
+        stats.votes += entry.batcher.getBallotCount();
+        stats.batches += entry.batcher.getBatchCount();
+        stats.largestBatch = std::max(stats.largestBatch, entry.batcher.getLargestBatch());
+    });
+    return stats;
 }
 
 ServiceResponse ClearBallotService::getCandidates(int electionId) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
     
-    // For now, return a simple success message
-    // In a full implementation, we'd extract candidate data from Election
-    return createSuccessResponse("Candidates retrieved.", {"Use displayCandidates() for full list"});
+    // One line per candidate, numbered by the index castVote expects
+    std::vector<std::string> candidateLines;
+    const auto& candidates = election->getCandidates();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        auto party = candidates[i]->getParty();
+        candidateLines.push_back(std::to_string(i) + ". " + candidates[i]->getName() +
+                                 (party ? " (" + party->getName() + ")" : " (Independent)"));
+    }
+    return createSuccessResponse("Candidates retrieved.", candidateLines);
 }
 
 ServiceResponse ClearBallotService::getVoters(int electionId) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -151,16 +536,30 @@ ServiceResponse ClearBallotService::getVoters(int electionId) {
 }
 
 ServiceResponse ClearBallotService::getElectionResults(int electionId) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
     
-    return createSuccessResponse("Election results retrieved.", {"Use displayResults() for full results"});
+    std::vector<std::string> results;
+    for (const auto& candidate : election->getCandidates()) {
+        results.push_back(candidate->getName() + ": " + std::to_string(candidate->getVoteCount()) + " votes");
+    }
+    return createSuccessResponse("Election results retrieved.", results);
 }
 
 ServiceResponse ClearBallotService::checkVoterRegistration(int electionId, int voterId) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -177,7 +576,12 @@ ServiceResponse ClearBallotService::checkVoterRegistration(int electionId, int v
 
 // Admin operations (delegate to Election)
 ServiceResponse ClearBallotService::addCandidate(int electionId, const std::string& name) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -189,7 +593,12 @@ ServiceResponse ClearBallotService::addCandidate(int electionId, const std::stri
 
 ServiceResponse ClearBallotService::addCandidateWithParty(int electionId, const std::string& name, 
                                                         const std::string& partyName) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -204,7 +613,12 @@ ServiceResponse ClearBallotService::addCandidateWithParty(int electionId, const
 }
 
 ServiceResponse ClearBallotService::createParty(int electionId, const std::string& partyName) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -220,7 +634,12 @@ ServiceResponse ClearBallotService::createParty(int electionId, const std::strin
 }
 
 ServiceResponse ClearBallotService::getParties(int electionId) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -228,9 +647,195 @@ ServiceResponse ClearBallotService::getParties(int electionId) {
     return createSuccessResponse("Parties retrieved.", {"Use displayParties() for full list"});
 }
 
+ServiceResponse ClearBallotService::setValidationRules(int electionId, const std::string& rulesName) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    
+    if (!election->setValidationRules(rulesName)) {
+        ServiceResponse response = createErrorResponse("Unknown validation rules '" + rulesName + "'.");
+        response.data = ValidationRules::getNames();
+        return response;
+    }
+    return createSuccessResponse("Validation rules set to '" + rulesName + "'.");
+}
+
+// Regional operations (delegate to Election)
+ServiceResponse ClearBallotService::createRegion(int electionId, const std::string& name,
+                                               const std::string& code) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    
+    if (election->createRegion(name, code)) {
+        return createSuccessResponse("Region '" + name + "' created successfully.");
+    }
+    return createErrorResponse("Failed to create region (name: '" + name + "', code: '" + code + "').");
+}
+
+ServiceResponse ClearBallotService::getRegions(int electionId) {
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    
+    std::vector<std::string> regionLines;
+    for (size_t i = 1; ; ++i) {  // Region indices are 1-based
+        auto region = election->getRegionByIndex(i);
+        if (!region) {
+            break;
+        }
+        regionLines.push_back(region->getCode() + " - " + region->getName());
+    }
+    return createSuccessResponse("Regions retrieved.", regionLines);
+}
+
+ServiceResponse ClearBallotService::addCandidateToRegion(int electionId, const std::string& name,
+                                                       const std::string& regionCode) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    auto region = election->getRegionByCode(regionCode);
+    if (!region) {
+        return createErrorResponse("Region not found: " + regionCode);
+    }
+    
+    if (election->addCandidateToRegion(name, region)) {
+        return createSuccessResponse("Candidate '" + name + "' added to region '" + regionCode + "'.");
+    }
+    return createErrorResponse("Failed to add candidate to region.");
+}
+
+ServiceResponse ClearBallotService::addCandidateToRegion(int electionId, const std::string& name,
+                                                       const std::string& partyName,
+                                                       const std::string& regionCode) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    auto region = election->getRegionByCode(regionCode);
+    if (!region) {
+        return createErrorResponse("Region not found: " + regionCode);
+    }
+    
+    auto party = election->createParty(partyName);  // Returns the existing party if there is one
+    if (!party) {
+        return createErrorResponse("Party not found and could not be created: " + partyName);
+    }
+    
+    if (election->addCandidateToRegion(name, party, region)) {
+        return createSuccessResponse("Candidate '" + name + "' added to region '" + regionCode +
+                                     "' with party '" + partyName + "'.");
+    }
+    return createErrorResponse("Failed to add candidate to region.");
+}
+
+ServiceResponse ClearBallotService::registerVoterInRegion(int electionId, const VoterRegistrationData& voterData,
+                                                        const std::string& regionCode) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    auto region = election->getRegionByCode(regionCode);
+    if (!region) {
+        return createErrorResponse("Region not found: " + regionCode);
+    }
+    
+    bool success = election->registerVoterInRegion(voterData.firstName, voterData.lastName,
+                                                   voterData.phoneNumber, voterData.address,
+                                                   voterData.uniqueIdStr, voterData.ageStr, region);
+    if (success) {
+        return createSuccessResponse("Voter '" + voterData.firstName + " " + voterData.lastName +
+                                     "' registered in region '" + regionCode + "'.");
+    }
+    return createErrorResponse("Failed to register voter in region.");
+}
+
+ServiceResponse ClearBallotService::castVoteInRegion(int electionId, int voterId, int candidateIndex,
+                                                   const std::string& regionCode) {
+    RequestGuard guard(*this, electionId, OperationClass::Vote);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    auto region = election->getRegionByCode(regionCode);
+    if (!region) {
+        return createErrorResponse("Region not found: " + regionCode);
+    }
+    
+    if (election->castVoteInRegion(voterId, candidateIndex, region)) {
+        return createSuccessResponse("Vote cast successfully in region '" + regionCode + "'.");
+    }
+    return createErrorResponse("Failed to cast vote in region.");
+}
+
+ServiceResponse ClearBallotService::getRegionalResults(int electionId, const std::string& regionCode) {
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
+    if (!election) {
+        return createErrorResponse("Election not found.");
+    }
+    auto region = election->getRegionByCode(regionCode);
+    if (!region) {
+        return createErrorResponse("Region not found: " + regionCode);
+    }
+    
+    std::vector<std::string> results;
+    for (const auto& candidate : region->getCandidates()) {
+        results.push_back(candidate->getName() + ": " + std::to_string(candidate->getVoteCount()) + " votes");
+    }
+    return createSuccessResponse("Regional results retrieved for '" + regionCode + "'.", results);
+}
+
 // Data persistence operations
 ServiceResponse ClearBallotService::saveElectionResults(int electionId, const std::string& filename) {
-    auto election = getElectionSafe(electionId);
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    auto election = lockElection(electionId);
     if (!election) {
         return createErrorResponse("Election not found.");
     }
@@ -241,24 +846,82 @@ ServiceResponse ClearBallotService::saveElectionResults(int electionId, const st
 }
 
 ServiceResponse ClearBallotService::saveCompleteElectionData(int electionId, const std::string& filename) {
-    auto election = getElectionSafe(electionId);
-    if (!election) {
-        return createErrorResponse("Election not found.");
+    return saveCompleteElectionData(electionId, filename, nullptr);
+}
+
+ServiceResponse ClearBallotService::saveCompleteElectionData(int electionId, const std::string& filename,
+                                                             std::atomic<int>* progress) {
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
     }
     
-    // Delegate to existing Election method
-    election->saveCompleteElectionData(filename);
+    // Rendered under the election's lock; compressing and writing the file
+    // happen after votes can reach the election again
+    std::string contents;
+    {
+        auto election = lockElection(electionId);
+        if (!election) {
+            return createErrorResponse("Election not found.");
+        }
+        contents = election->renderCompleteElectionData(progressStep(progress, 0, 50));
+    }
+    if (!Election::saveRenderedElectionData(filename, contents, progressStep(progress, 50, 100))) {
+        return createErrorResponse("Could not write complete election data to '" + filename + "'.");
+    }
     return createSuccessResponse("Complete election data saved to '" + filename + "'.");
 }
 
 ServiceResponse ClearBallotService::loadElectionData(int electionId, const std::string& filename) {
-    auto election = getElectionSafe(electionId);
-    if (!election) {
+    return loadElectionData(electionId, filename, nullptr);
+}
+
+ServiceResponse ClearBallotService::loadElectionData(int electionId, const std::string& filename,
+                                                     std::atomic<int>* progress) {
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
         return createErrorResponse("Election not found.");
     }
+    entry->lastAccess.store(++accessClock, std::memory_order_relaxed);
     
-    // Delegate to existing Election method
-    bool success = election->loadCompleteElectionData(filename);
+    // The snapshot is read and parsed into a fresh election without the lock,
+    // which is then held only to swap it in. An election handed out by
+    // getElection must stay the object its holders see, so it is reloaded in
+    // place instead, under the lock, as before.
+    bool pinned;
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        pinned = entry->pinned;
+    }
+    std::shared_ptr<Election> staged;
+    if (!pinned) {
+        staged = std::make_shared<Election>("");
+        if (!staged->loadCompleteElectionData(filename, progressStep(progress, 0, 100))) {
+            return createErrorResponse("Failed to load election data from '" + filename + "'.");
+        }
+    }
+    
+    std::shared_ptr<Election> previous;   // Freed once the lock is released
+    bool success = true;
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (entry->pinned) {
+            success = entry->election->loadCompleteElectionData(filename, progressStep(progress, 0, 100));
+        } else {
+            // An evicted election is replaced outright; its spill file is rewritten on the next eviction
+            previous = std::move(entry->election);
+            entry->election = std::move(staged);
+        }
+        if (success) {
+            entry->title = entry->election->getTitle();
+            estimateFootprint(*entry);
+        }
+    }
     
     if (success) {
         return createSuccessResponse("Election data loaded from '" + filename + "'.");
@@ -267,17 +930,194 @@ ServiceResponse ClearBallotService::loadElectionData(int electionId, const std::
     }
 }
 
-ServiceResponse ClearBallotService::exportElectionToCSV(int electionId, const std::string& baseFilename) {
-    auto election = getElectionSafe(electionId);
-    if (!election) {
-        return createErrorResponse("Election not found.");
+ServiceResponse ClearBallotService::exportElectionToCSV(int electionId, const std::string& baseFilename,
+                                                       bool compressed) {
+    return exportElectionToCSV(electionId, baseFilename, compressed, nullptr);
+}
+
+ServiceResponse ClearBallotService::exportElectionToCSV(int electionId, const std::string& baseFilename,
+                                                       bool compressed, std::atomic<int>* progress) {
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
     }
     
-    // Delegate to existing Election method
-    election->exportToCSV(baseFilename);
+    // As with saves, only rendering the rows needs the election's lock
+    CsvExportEngine::Options options;
+    options.compressed = compressed;
+    options.progress = progressStep(progress, 0, 50);
+    CsvExportEngine::Rendered rendered;
+    {
+        auto election = lockElection(electionId);
+        if (!election) {
+            return createErrorResponse("Election not found.");
+        }
+        rendered = CsvExportEngine(*election, options).render();
+    }
+    options.progress = progressStep(progress, 50, 100);
+    if (!CsvExportEngine::writeRendered(baseFilename, rendered, options).allWritten()) {
+        return createErrorResponse("Some CSV files could not be written for '" + baseFilename + "'.");
+    }
     return createSuccessResponse("Election data exported to CSV files with base name '" + baseFilename + "'.");
 }
 
+ServiceResponse ClearBallotService::importVotersFromCSV(int electionId, const std::string& filename) {
+    return importVotersFromCSV(electionId, filename, nullptr);
+}
+
+ServiceResponse ClearBallotService::importVotersFromCSV(int electionId, const std::string& filename,
+                                                        std::atomic<int>* progress) {
+    RequestGuard guard(*this, electionId, OperationClass::Bulk);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    // The roll is read and validated without the lock; it is held only while
+    // the valid rows are registered. Rules come from a static registry, so the
+    // pointer stays good after the lock is released.
+    const ValidationRules* rules;
+    {
+        auto election = lockElection(electionId);
+        if (!election) {
+            return createErrorResponse("Election not found.");
+        }
+        rules = &election->getValidationRules();
+    }
+    CsvVoterImporter::StagedRoll roll;
+    CsvVoterImporter::stageFile(roll, filename, *rules, progressStep(progress, 0, 70));
+    
+    CsvVoterImporter::Result result;
+    {
+        auto election = lockElection(electionId);
+        if (!election) {
+            return createErrorResponse("Election not found.");
+        }
+        CsvVoterImporter importer(*election);
+        result = importer.apply(roll, progressStep(progress, 70, 100));
+        election.refreshFootprint();
+    }
+    if (!result.fileOpened) {
+        return createErrorResponse("Could not open voter roll '" + filename + "'.");
+    }
+    
+    std::vector<std::string> summary;
+    summary.push_back("Rows read: " + std::to_string(result.rowsRead));
+    summary.push_back("Imported: " + std::to_string(result.imported));
+    summary.push_back("Rejected: " + std::to_string(result.rejected));
+    summary.insert(summary.end(), result.errors.begin(), result.errors.end());
+    
+    return createSuccessResponse("Imported " + std::to_string(result.imported) + " voters from '" +
+                                 filename + "'.", summary);
+}
+
+// Background jobs
+ServiceResponse ClearBallotService::startBulkJob(int electionId, BulkOperation operation,
+                                                 const std::string& filename, bool compressed) {
+    RequestGuard guard(*this, electionId, OperationClass::Write);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    static const char* const descriptions[] = {"Save complete data", "Load data", "Export CSV", "Import voters"};
+    int kind = static_cast<int>(operation);
+    if (kind < 0 || kind > static_cast<int>(BulkOperation::ImportVoters)) {
+        return createErrorResponse("Unknown bulk operation.");
+    }
+    if (!electionExists(electionId)) {
+        return createErrorResponse("Election not found.");
+    }
+    
+    std::string description = std::string(descriptions[kind]) + " '" + filename + "'";
+    int jobId = jobs->submit(electionId, description, [this, electionId, operation, filename, compressed](
+                                                          std::atomic<int>& progress) {
+        // Jobs queue behind the bulk lane rather than fail when it is busy
+        ServiceResponse response = runBulkOperation(electionId, operation, filename, compressed, &progress);
+        while (response.retryAfterMs > 0 && acceptingRequests.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(response.retryAfterMs));
+            response = runBulkOperation(electionId, operation, filename, compressed, &progress);
+        }
+        return response;
+    });
+    if (jobId < 0) {
+        ServiceResponse response = createErrorResponse("Background job queue is full.");
+        response.retryAfterMs = 1000;
+        return response;
+    }
+    
+    return createSuccessResponse("Job " + std::to_string(jobId) + " queued: " + description + ".",
+                                 {"Job ID: " + std::to_string(jobId)});
+}
+
+ServiceResponse ClearBallotService::getJobStatus(int electionId, int jobId) {
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    BackgroundJobs::Status status;
+    if (!jobs->getStatus(jobId, status) || status.electionId != electionId) {
+        return createErrorResponse("Job not found.");
+    }
+    
+    std::vector<std::string> data;
+    data.push_back("State: " + std::string(BackgroundJobs::stateName(status.state)));
+    data.push_back("Progress: " + std::to_string(status.progress) + "%");
+    data.push_back("Elapsed: " + std::to_string(status.elapsed.count()) + " ms");
+    if (status.state != BackgroundJobs::State::Queued && status.state != BackgroundJobs::State::Running) {
+        data.push_back("Result: " + status.result.message);
+        data.insert(data.end(), status.result.data.begin(), status.result.data.end());
+    }
+    return createSuccessResponse("Job " + std::to_string(jobId) + ": " + status.description + ".", data);
+}
+
+ServiceResponse ClearBallotService::getMemoryUsage(int electionId) {
+    RequestGuard guard(*this, electionId, OperationClass::Read);
+    if (!guard.admitted()) {
+        return guard.rejection();
+    }
+    
+    ElectionDirectory::Entry* entry = elections->find(electionId);
+    if (!entry) {
+        return createErrorResponse("Election not found.");
+    }
+    
+    auto bytes = [](const char* category, size_t count) {
+        return std::string(category) + ": " + std::to_string(count) + " bytes";
+    };
+    std::vector<std::string> data;
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (!entry->isResident()) {
+        std::ifstream spilled(entry->spillFile, std::ios::binary | std::ios::ate);
+        data.push_back("Resident: No");
+        data.push_back(bytes("On disk", spilled ? static_cast<size_t>(spilled.tellg()) : 0));
+        return createSuccessResponse("Election '" + entry->title + "' is evicted to disk.", data);
+    }
+    
+    Election::MemoryUsage usage = entry->election->getMemoryUsage();
+    data.push_back("Resident: Yes");
+    data.push_back(bytes("Voters", usage.voters));
+    data.push_back(bytes("Personal details", usage.personalDetails));
+    data.push_back(bytes("Candidates", usage.candidates));
+    data.push_back(bytes("Regions", usage.regions));
+    data.push_back(bytes("Indexes", usage.indexes));
+    data.push_back(bytes("Other", usage.other));
+    data.push_back(bytes("Total", usage.total()));
+    data.push_back(bytes("Mapped snapshot", usage.mappedSnapshot));
+    return createSuccessResponse("Memory usage of election '" + entry->title + "'.", data);
+}
+
+ServiceResponse ClearBallotService::runBulkOperation(int electionId, BulkOperation operation,
+                                                     const std::string& filename, bool compressed,
+                                                     std::atomic<int>* progress) {
+    switch (operation) {
+        case BulkOperation::SaveCompleteData: return saveCompleteElectionData(electionId, filename, progress);
+        case BulkOperation::LoadData: return loadElectionData(electionId, filename, progress);
+        case BulkOperation::ExportCsv: return exportElectionToCSV(electionId, filename, compressed, progress);
+        case BulkOperation::ImportVoters: return importVotersFromCSV(electionId, filename, progress);
+    }
+    return createErrorResponse("Unknown bulk operation.");
+}
+
 // Helper methods
 ServiceResponse ClearBallotService::createErrorResponse(const std::string& message) const {
     return ServiceResponse(false, message);
@@ -294,7 +1134,30 @@ ServiceResponse ClearBallotService::createSuccessResponse(const std::string& mes
     return response;
 }
 
-bool ClearBallotService::validateElectionId(int electionId) const {
-    std::lock_guard<std::mutex> lock(electionsMutex);
-    return elections.find(electionId) != elections.end();
+ClearBallotService::RequestGuard::RequestGuard(ClearBallotService& service, int electionId,
+                                               OperationClass operation)
+    : service(service), isAdmitted(false) {
+    // Count first, then check intake, so stopService() never misses a request
+    service.inFlightRequests.fetch_add(1);
+    if (service.acceptingRequests.load()) {
+        ticket = service.admission.admit(electionId, operation);
+        isAdmitted = static_cast<bool>(ticket);
+    }
+}
+
+ServiceResponse ClearBallotService::RequestGuard::rejection() const {
+    if (ticket.getRetryAfterMs() == 0) {
+        return service.createErrorResponse("Service is shutting down.");
+    }
+    ServiceResponse response = service.createErrorResponse(
+        "Service is busy; retry after " + std::to_string(ticket.getRetryAfterMs()) + " ms.");
+    response.retryAfterMs = ticket.getRetryAfterMs();
+    return response;
+}
+
+ClearBallotService::RequestGuard::~RequestGuard() {
+    if (service.inFlightRequests.fetch_sub(1) == 1 && !service.acceptingRequests.load()) {
+        std::lock_guard<std::mutex> lock(service.drainMutex);
+        service.drainCondition.notify_all();
+    }
 }
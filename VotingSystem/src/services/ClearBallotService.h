@@ -1,21 +1,18 @@
 #pragma once
 #include "../core/Election.h"
+#include "AdmissionController.h"
+#include "ElectionDirectory.h"
+#include "ServiceResponse.h"
+#include "ShutdownCoordinator.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <map>
 #include <mutex>
 #include <string>
 #include <vector>
 
-// Service response structure for client communication
-struct ServiceResponse {
-    bool success;
-    std::string message;
-    std::vector<std::string> data;
-    
-    ServiceResponse(bool success = false, const std::string& message = "")
-        : success(success), message(message) {}
-};
-
 // Voter registration data structure
 struct VoterRegistrationData {
     std::string firstName;
@@ -32,6 +29,16 @@ struct VoterRegistrationData {
           address(address), uniqueIdStr(idStr), ageStr(ageStr) {}
 };
 
+// Long-running operations that can also run as background jobs
+enum class BulkOperation {
+    SaveCompleteData,
+    LoadData,
+    ExportCsv,
+    ImportVoters
+};
+
+class BackgroundJobs;
+
 // Main service class that manages multiple elections
 class ClearBallotService {
 public:
@@ -42,12 +49,55 @@ public:
     bool startService();
     bool stopService();
     bool isRunning() const;
+    // True once a shutdown flush was abandoned at its deadline. Its detached
+    // worker still writes through this service, so the process must then end
+    // without destroying the service (see std::_Exit).
+    bool hasAbandonedFlushes() const;
+    bool isAcceptingRequests() const;
+    
+    // Shutdown tuning (worker count and deadline for draining and flushing)
+    void setShutdownOptions(const ShutdownCoordinator::Options& options);
+    const ShutdownCoordinator::Options& getShutdownOptions() const;
+    
+    // Per-election, per-operation-class concurrency limits and queues
+    void setAdmissionOptions(const AdmissionController::Options& options);
+    AdmissionController::Options getAdmissionOptions() const;
+    AdmissionController::ClassStats getAdmissionStats(OperationClass operation) const;
+    
+    // Cold elections are written to disk and dropped from memory once the
+    // resident ones exceed the budget, least recently used first, and are
+    // reloaded transparently by the next request that needs them
+    struct EvictionOptions {
+        size_t memoryBudgetBytes = 0;       // 0 keeps every election resident
+        std::string spillDirectory = ".";
+    };
+    struct ResidencyStats {
+        size_t resident = 0;
+        size_t evicted = 0;
+        size_t residentBytes = 0;           // Estimated afresh for the stats
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+    };
+    void setEvictionOptions(const EvictionOptions& options);
+    EvictionOptions getEvictionOptions() const;
+    ResidencyStats getResidencyStats() const;
     
     // Election management
     int createElection(const std::string& title);
     bool electionExists(int electionId) const;
     std::shared_ptr<Election> getElection(int electionId);
+    std::string getElectionTitle(int electionId) const;   // Without loading or pinning it
     std::vector<int> getActiveElectionIds() const;
+    // The election shared by single-election console apps; created and seeded on first use
+    int getDefaultElection();
+    
+    // Concurrent castVote calls on one election are applied in batches
+    struct VoteBatchStats {
+        uint64_t votes = 0;
+        uint64_t batches = 0;
+        size_t largestBatch = 0;
+    };
+    VoteBatchStats getVoteBatchStats() const;
     
     // Voter operations (delegate to Election)
     ServiceResponse registerVoter(int electionId, const VoterRegistrationData& voterData);
@@ -63,26 +113,134 @@ public:
                                          const std::string& partyName);
     ServiceResponse createParty(int electionId, const std::string& partyName);
     ServiceResponse getParties(int electionId);
+    // Selects the jurisdiction whose rules registrations are checked against;
+    // an unknown name fails with the registered names as data
+    ServiceResponse setValidationRules(int electionId, const std::string& rulesName);
+    
+    // Regional operations (delegate to Election)
+    ServiceResponse createRegion(int electionId, const std::string& name, const std::string& code);
+    ServiceResponse getRegions(int electionId);
+    ServiceResponse addCandidateToRegion(int electionId, const std::string& name,
+                                         const std::string& regionCode);
+    ServiceResponse addCandidateToRegion(int electionId, const std::string& name,
+                                         const std::string& partyName, const std::string& regionCode);
+    ServiceResponse registerVoterInRegion(int electionId, const VoterRegistrationData& voterData,
+                                          const std::string& regionCode);
+    ServiceResponse castVoteInRegion(int electionId, int voterId, int candidateIndex,
+                                     const std::string& regionCode);
+    ServiceResponse getRegionalResults(int electionId, const std::string& regionCode);
     
     // Data persistence operations
     ServiceResponse saveElectionResults(int electionId, const std::string& filename);
     ServiceResponse saveCompleteElectionData(int electionId, const std::string& filename);
     ServiceResponse loadElectionData(int electionId, const std::string& filename);
-    ServiceResponse exportElectionToCSV(int electionId, const std::string& baseFilename);
+    ServiceResponse exportElectionToCSV(int electionId, const std::string& baseFilename,
+                                        bool compressed = false);
+    ServiceResponse importVotersFromCSV(int electionId, const std::string& filename);
+    
+    // Background jobs: the bulk operations above, run on low-priority workers of
+    // their own so they never hold up the caller. startBulkJob answers at once
+    // with "Job ID: <n>"; getJobStatus reports state, progress and, once
+    // finished, the operation's response.
+    ServiceResponse startBulkJob(int electionId, BulkOperation operation, const std::string& filename,
+                                 bool compressed = false);
+    ServiceResponse getJobStatus(int electionId, int jobId);
+    
+    // Estimated bytes held by an election, one "<Category>: <n> bytes" line per
+    // category, then the total. An evicted election is reported from disk
+    // rather than reloaded.
+    ServiceResponse getMemoryUsage(int electionId);
     
 private:
-    std::map<int, std::shared_ptr<Election>> elections;
-    mutable std::mutex electionsMutex;  // Thread safety for concurrent access
+    std::unique_ptr<ElectionDirectory> elections;  // Lock-free lookups by election ID
+    mutable std::mutex electionsMutex;  // Serializes election creation and lifecycle changes
     int nextElectionId;
+    int defaultElectionId;
+    std::mutex defaultElectionMutex;
     bool serviceRunning;
     
+    // Request intake tracking so shutdown can stop new work and drain in-flight calls
+    std::atomic<bool> acceptingRequests;
+    std::atomic<int> inFlightRequests;
+    std::mutex drainMutex;
+    std::condition_variable drainCondition;
+    ShutdownCoordinator::Options shutdownOptions;
+    std::atomic<bool> flushesAbandoned;
+    AdmissionController admission;
+    std::unique_ptr<BackgroundJobs> jobs;
+    
+    // RAII marker for a request in progress; rejected once intake has stopped
+    // or when the request's lane is saturated
+    class RequestGuard {
+    public:
+        RequestGuard(ClearBallotService& service, int electionId, OperationClass operation);
+        ~RequestGuard();
+        bool admitted() const { return isAdmitted; }
+        ServiceResponse rejection() const;
+    private:
+        ClearBallotService& service;
+        bool isAdmitted;
+        AdmissionController::Ticket ticket;
+    };
+    
+    // The bulk operations, raising a background job's progress from 0 to 100
+    // as the work is done when progress is given
+    ServiceResponse runBulkOperation(int electionId, BulkOperation operation, const std::string& filename,
+                                     bool compressed, std::atomic<int>* progress);
+    ServiceResponse saveCompleteElectionData(int electionId, const std::string& filename,
+                                             std::atomic<int>* progress);
+    ServiceResponse loadElectionData(int electionId, const std::string& filename, std::atomic<int>* progress);
+    ServiceResponse exportElectionToCSV(int electionId, const std::string& baseFilename, bool compressed,
+                                        std::atomic<int>* progress);
+    ServiceResponse importVotersFromCSV(int electionId, const std::string& filename,
+                                        std::atomic<int>* progress);
+    bool waitForInFlightRequests(std::chrono::steady_clock::time_point deadline);
+    ShutdownCoordinator::Result flushElections(std::chrono::steady_clock::time_point deadline);
+    
+    // Residency of elections under the memory budget
+    EvictionOptions evictionOptions;
+    mutable std::mutex evictionMutex;   // Guards evictionOptions; one eviction pass at a time
+    std::atomic<size_t> memoryBudget;   // evictionOptions.memoryBudgetBytes, read lock-free
+    std::atomic<size_t> residentBytes;
+    std::atomic<uint64_t> accessClock;
+    std::atomic<uint64_t> evictionCount;
+    std::atomic<uint64_t> reloadCount;
+    
     // Helper methods
     ServiceResponse createErrorResponse(const std::string& message) const;
     ServiceResponse createSuccessResponse(const std::string& message) const;
     ServiceResponse createSuccessResponse(const std::string& message, 
                                         const std::vector<std::string>& data) const;
     
-    // Validation helpers
-    bool validateElectionId(int electionId) const;
-    std::shared_ptr<Election> getElectionSafe(int electionId);
+    // An election held exclusively for the duration of one request. Under a
+    // memory budget the election's footprint is re-estimated on every
+    // FOOTPRINT_REFRESH_RELEASES-th release, or the next one after
+    // refreshFootprint(); the estimate walks the whole election, so it is not
+    // paid per vote, and not at all without a budget.
+    static const uint32_t FOOTPRINT_REFRESH_RELEASES = 64;
+    class LockedElection {
+    public:
+        LockedElection() = default;
+        LockedElection(ClearBallotService& service, ElectionDirectory::Entry& entry,
+                       std::unique_lock<std::mutex> lock);
+        LockedElection(LockedElection&& other) noexcept;
+        LockedElection& operator=(LockedElection&& other) = delete;
+        ~LockedElection();
+        explicit operator bool() const { return election != nullptr; }
+        Election* operator->() const { return election; }
+        Election& operator*() const { return *election; }
+        void refreshFootprint() { entry->releasesSinceEstimate = FOOTPRINT_REFRESH_RELEASES; }
+    private:
+        ClearBallotService* service = nullptr;
+        ElectionDirectory::Entry* entry = nullptr;   // Outlives the service's requests
+        Election* election = nullptr;
+        std::unique_lock<std::mutex> lock;
+    };
+    
+    LockedElection lockElection(int electionId);
+    LockedElection lockEntry(ElectionDirectory::Entry& entry);
+    bool makeResident(ElectionDirectory::Entry& entry);   // Entry mutex held
+    bool evict(ElectionDirectory::Entry& entry);          // Entry mutex held
+    void estimateFootprint(ElectionDirectory::Entry& entry);   // Entry mutex held
+    void enforceMemoryBudget();
 };
@@ -0,0 +1,154 @@
+#include "ConnectionLoop.h"
+#include "AdmissionController.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_CHUNK_SIZE = 64 * 1024;
+const size_t MAX_READ_PER_EVENT = 4 * READ_CHUNK_SIZE;
+const int MAX_EVENTS = 64;
+
+} // namespace
+
+void ConnectionLoop::run(int epollFd, const std::atomic<bool>& running, const char* logPrefix,
+                         const std::function<void(int fd, uint32_t events)>& onEvent) {
+    // Every connection on this loop waits while a request does
+    AdmissionController::NoQueueScope noQueue;
+    epoll_event events[MAX_EVENTS];
+    while (running.load()) {
+        int count = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cout << logPrefix << " Event loop failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            onEvent(events[i].data.fd, events[i].events);
+        }
+    }
+}
+
+bool ConnectionLoop::dispatch(uint32_t events, const std::function<bool()>& read,
+                              const std::function<bool()>& write) {
+    bool keep = (events & EPOLLERR) == 0;
+    if (keep && (events & (EPOLLIN | EPOLLHUP))) {
+        keep = read();
+    }
+    if (keep && (events & EPOLLOUT)) {
+        keep = write();
+    }
+    return keep;
+}
+
+void ConnectionLoop::acceptAll(int listenFd, int epollFd, const std::function<void(int fd)>& onAccepted) {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;   // EAGAIN: backlog drained, or another loop took it; anything else is retried on the next event
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        onAccepted(fd);
+    }
+}
+
+ConnectionLoop::ReadStatus ConnectionLoop::readAvailable(StreamConnection& connection) {
+    char buffer[READ_CHUNK_SIZE];
+    size_t received = 0;
+    while (received < MAX_READ_PER_EVENT) {
+        ssize_t bytes = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (bytes > 0) {
+            connection.input.append(buffer, static_cast<size_t>(bytes));
+            received += static_cast<size_t>(bytes);
+        } else if (bytes == 0) {
+            return ReadStatus::PeerClosed;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return ReadStatus::Failed;
+        }
+    }
+    return ReadStatus::Open;
+}
+
+bool ConnectionLoop::writeQueued(StreamConnection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t bytes = ::send(connection.fd, connection.output.data() + connection.outputSent,
+                               connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (bytes > 0) {
+            connection.outputSent += static_cast<size_t>(bytes);
+        } else if (bytes < 0 && errno == EINTR) {
+            continue;
+        } else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    if (connection.outputSent == connection.output.size()) {
+        connection.output.clear();
+        connection.outputSent = 0;
+    }
+    return true;
+}
+
+size_t ConnectionLoop::pendingOutput(const StreamConnection& connection) {
+    return connection.output.size() - connection.outputSent;
+}
+
+bool ConnectionLoop::updateInterest(int epollFd, StreamConnection& connection, bool wantRead) {
+    size_t pending = pendingOutput(connection);
+    bool wantWrite = pending > 0;
+    wantRead = wantRead && pending < MAX_PENDING_OUTPUT;
+    uint32_t interest = (wantRead ? EPOLLIN : 0u) | (wantWrite ? EPOLLOUT : 0u);
+    if (interest != connection.interest) {
+        epoll_event event{};
+        event.events = interest;
+        event.data.fd = connection.fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+            return false;
+        }
+        connection.interest = interest;
+    }
+    return true;
+}
+
+void ConnectionLoop::close(int epollFd, int fd) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+}
+
+#else
+
+void ConnectionLoop::run(int, const std::atomic<bool>&, const char*, const std::function<void(int, uint32_t)>&) {}
+bool ConnectionLoop::dispatch(uint32_t, const std::function<bool()>&, const std::function<bool()>&) { return false; }
+void ConnectionLoop::acceptAll(int, int, const std::function<void(int)>&) {}
+ConnectionLoop::ReadStatus ConnectionLoop::readAvailable(StreamConnection&) { return ReadStatus::Failed; }
+bool ConnectionLoop::writeQueued(StreamConnection&) { return false; }
+size_t ConnectionLoop::pendingOutput(const StreamConnection& connection) {
+    return connection.output.size() - connection.outputSent;
+}
+bool ConnectionLoop::updateInterest(int, StreamConnection&, bool) { return false; }
+void ConnectionLoop::close(int, int) {}
+
+#endif
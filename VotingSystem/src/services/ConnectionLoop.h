@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// A non-blocking stream socket as the servers' event loops see it: what has
+// been read but not yet parsed, and what is queued for the peer.
+struct StreamConnection {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    size_t outputSent = 0;
+    uint32_t interest = 0;    // epoll events currently registered
+};
+
+// The epoll plumbing RpcServer and HttpServer share: waiting for events,
+// accepting connections, reading what a socket has, writing queued output as
+// the socket accepts it and keeping each connection's epoll interest in step.
+// What a request means is left to the server. Linux only; elsewhere the
+// servers fail in start() before any of this is used.
+class ConnectionLoop {
+public:
+    static constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;   // Stop reading from a client that is not reading
+
+    enum class ReadStatus { Open, PeerClosed, Failed };
+
+    // Waits on epollFd until running is cleared or epoll fails, and hands each
+    // ready fd with its events to onEvent. logPrefix tags the failure message.
+    // Requests run from onEvent are never queued for admission (see
+    // AdmissionController::NoQueueScope); a saturated lane refuses them at once.
+    static void run(int epollFd, const std::atomic<bool>& running, const char* logPrefix,
+                    const std::function<void(int fd, uint32_t events)>& onEvent);
+
+    // For an event on a connection: reads on input or hangup, then writes on
+    // output. False once the connection should be closed.
+    static bool dispatch(uint32_t events, const std::function<bool()>& read, const std::function<bool()>& write);
+
+    // Accepts every pending connection non-blocking and registers it for input;
+    // onAccepted then takes ownership of the fd
+    static void acceptAll(int listenFd, int epollFd, const std::function<void(int fd)>& onAccepted);
+
+    // Appends what the socket has to input, up to a per-event limit so one busy
+    // client cannot starve the others on the loop
+    static ReadStatus readAvailable(StreamConnection& connection);
+    // Sends as much queued output as the socket takes; false if the connection failed
+    static bool writeQueued(StreamConnection& connection);
+    static size_t pendingOutput(const StreamConnection& connection);
+    // Waits for writability while output is queued, and for input while
+    // wantRead and less than MAX_PENDING_OUTPUT is queued
+    static bool updateInterest(int epollFd, StreamConnection& connection, bool wantRead);
+    static void close(int epollFd, int fd);
+};
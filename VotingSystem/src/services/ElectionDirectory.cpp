@@ -0,0 +1,50 @@
+#include "ElectionDirectory.h"
+
+ElectionDirectory::Chunk::Chunk() {
+    for (auto& slot : slots) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ElectionDirectory::ElectionDirectory() : highestId(0) {
+    for (auto& chunk : chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ElectionDirectory::~ElectionDirectory() {
+    for (auto& chunkPointer : chunks) {
+        Chunk* chunk = chunkPointer.load(std::memory_order_relaxed);
+        if (!chunk) {
+            continue;
+        }
+        for (auto& slot : chunk->slots) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+        delete chunk;
+    }
+}
+
+ElectionDirectory::Entry* ElectionDirectory::add(int id, std::shared_ptr<Election> election) {
+    if (id <= 0 || id > MAX_ID) {
+        return nullptr;
+    }
+    std::atomic<Chunk*>& chunkPointer = chunks[static_cast<size_t>(id) / CHUNK_SIZE];
+    Chunk* chunk = chunkPointer.load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Chunk();
+        chunkPointer.store(chunk, std::memory_order_release);
+    }
+    std::atomic<Entry*>& slot = chunk->slots[static_cast<size_t>(id) % CHUNK_SIZE];
+    if (slot.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    // Fully built before the release store makes it visible to readers
+    Entry* entry = new Entry(id, std::move(election));
+    slot.store(entry, std::memory_order_release);
+    if (id > highestId.load(std::memory_order_relaxed)) {
+        highestId.store(id, std::memory_order_release);
+    }
+    return entry;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "../core/Election.h"
+#include "VoteBatcher.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Maps election IDs to their per-election state. IDs are dense integers handed
+// out from 1, so the directory is a two-level table indexed directly by ID:
+// a fixed array of chunk pointers, each chunk a fixed array of entry pointers.
+// Entries are only ever added and live as long as the directory, so a lookup
+// is two acquire loads with no lock, no retry and no reference counting;
+// nothing a reader can see is ever freed underneath it, which is what RCU or
+// epochs would otherwise have to guarantee. Adding is for one writer at a time
+// (the service serializes creation). The election inside an entry may be
+// evicted to disk and reloaded; the entry itself stays put.
+class ElectionDirectory {
+public:
+    struct Entry {
+        explicit Entry(int id, std::shared_ptr<Election> election)
+            : id(id), election(std::move(election)), title(this->election ? this->election->getTitle() : "") {}
+
+        bool isResident() const { return election != nullptr; }
+
+        const int id;
+        std::mutex mutex;       // Held while a request works on the election; Election is not thread-safe
+        VoteBatcher batcher;
+
+        // Guarded by mutex. An evicted election is null here and lives in spillFile.
+        std::shared_ptr<Election> election;
+        std::string title;      // Kept current on every release, so it is known while evicted
+        std::string spillFile;
+        size_t footprint = 0;   // Estimated bytes while resident
+        uint32_t releasesSinceEstimate = 0;
+        bool pinned = false;    // Handed out by getElection, so never evicted
+        std::atomic<uint64_t> lastAccess{0};
+    };
+
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNKS = 4096;
+    static constexpr int MAX_ID = static_cast<int>(CHUNK_SIZE * MAX_CHUNKS) - 1;
+
+    ElectionDirectory();
+    ~ElectionDirectory();
+
+    ElectionDirectory(const ElectionDirectory&) = delete;
+    ElectionDirectory& operator=(const ElectionDirectory&) = delete;
+
+    // Wait-free; nullptr for IDs never added
+    Entry* find(int id) const {
+        if (id <= 0 || id > MAX_ID) {
+            return nullptr;
+        }
+        Chunk* chunk = chunks[static_cast<size_t>(id) / CHUNK_SIZE].load(std::memory_order_acquire);
+        return chunk ? chunk->slots[static_cast<size_t>(id) % CHUNK_SIZE].load(std::memory_order_acquire)
+                     : nullptr;
+    }
+
+    // Publishes a new entry; returns nullptr if the ID is out of range or taken
+    Entry* add(int id, std::shared_ptr<Election> election);
+
+    // IDs 1..getHighestId() cover every entry; gaps read as nullptr
+    int getHighestId() const { return highestId.load(std::memory_order_acquire); }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        int highest = getHighestId();
+        for (int id = 1; id <= highest; ++id) {
+            if (Entry* entry = find(id)) {
+                visit(*entry);
+            }
+        }
+    }
+
+private:
+    struct Chunk {
+        std::atomic<Entry*> slots[CHUNK_SIZE];
+        Chunk();
+    };
+
+    std::atomic<Chunk*> chunks[MAX_CHUNKS];
+    std::atomic<int> highestId;
+};
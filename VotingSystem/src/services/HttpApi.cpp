@@ -0,0 +1,275 @@
+#include "HttpApi.h"
+#include <charconv>
+#include <exception>
+#include <map>
+#include <vector>
+
+namespace {
+
+bool parseInt(std::string_view text, int& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+std::vector<std::string_view> splitPath(std::string_view path) {
+    std::vector<std::string_view> segments;
+    while (!path.empty()) {
+        if (path.front() == '/') {
+            path.remove_prefix(1);
+            continue;
+        }
+        size_t slash = path.find('/');
+        segments.push_back(path.substr(0, slash));
+        path.remove_prefix(slash == std::string_view::npos ? path.size() : slash);
+    }
+    return segments;
+}
+
+void skipSpace(std::string_view& text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t' ||
+                             text.front() == '\r' || text.front() == '\n')) {
+        text.remove_prefix(1);
+    }
+}
+
+// Reads a JSON string (without escapes other than \" and \\) at the start of text
+bool readJsonString(std::string_view& text, std::string& out) {
+    if (text.empty() || text.front() != '"') {
+        return false;
+    }
+    text.remove_prefix(1);
+    out.clear();
+    while (!text.empty()) {
+        char c = text.front();
+        text.remove_prefix(1);
+        if (c == '"') {
+            return true;
+        }
+        if (c == '\\') {
+            if (text.empty() || (text.front() != '"' && text.front() != '\\' && text.front() != '/')) {
+                return false;
+            }
+            c = text.front();
+            text.remove_prefix(1);
+        }
+        out += c;
+    }
+    return false;
+}
+
+// Parses a flat JSON object whose values are numbers, strings, booleans or
+// null. Values are kept as their source text (strings unquoted).
+bool parseFlatObject(std::string_view text, std::map<std::string, std::string>& fields) {
+    skipSpace(text);
+    if (text.empty() || text.front() != '{') {
+        return false;
+    }
+    text.remove_prefix(1);
+    skipSpace(text);
+    if (!text.empty() && text.front() == '}') {
+        text.remove_prefix(1);
+        skipSpace(text);
+        return text.empty();
+    }
+    while (true) {
+        std::string key;
+        std::string value;
+        skipSpace(text);
+        if (!readJsonString(text, key)) {
+            return false;
+        }
+        skipSpace(text);
+        if (text.empty() || text.front() != ':') {
+            return false;
+        }
+        text.remove_prefix(1);
+        skipSpace(text);
+        if (!text.empty() && text.front() == '"') {
+            if (!readJsonString(text, value)) {
+                return false;
+            }
+        } else {
+            size_t end = text.find_first_of(",} \t\r\n");
+            if (end == 0 || end == std::string_view::npos) {
+                return false;
+            }
+            value.assign(text.substr(0, end));
+            text.remove_prefix(end);
+        }
+        fields[key] = value;
+        skipSpace(text);
+        if (text.empty()) {
+            return false;
+        }
+        char separator = text.front();
+        text.remove_prefix(1);
+        if (separator == '}') {
+            skipSpace(text);
+            return text.empty();
+        }
+        if (separator != ',') {
+            return false;
+        }
+    }
+}
+
+HttpResponse jsonError(int status, const std::string& message) {
+    return HttpResponse(status, "{\"success\":false,\"message\":" + HttpApi::quote(message) + "}");
+}
+
+} // namespace
+
+HttpApi::HttpApi(ClearBallotService& service) : service(service) {}
+
+std::string HttpApi::quote(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(text.size() + 2);
+    out += '"';
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (byte < 0x20) {
+            out += "\\u00";
+            out += hex[byte >> 4];
+            out += hex[byte & 0xF];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+HttpResponse HttpApi::handle(const HttpRequest& request) {
+    try {
+        std::vector<std::string_view> segments = splitPath(request.path);
+
+        if (segments.size() == 1 && segments[0] == "health") {
+            if (request.method != "GET") {
+                HttpResponse response = jsonError(405, "Use GET.");
+                response.headers.emplace_back("Allow", "GET");
+                return response;
+            }
+            return HttpResponse(200, service.isAcceptingRequests() ? "{\"status\":\"ok\"}"
+                                                                   : "{\"status\":\"shutting down\"}");
+        }
+
+        if (segments.size() < 3 || segments[0] != "elections") {
+            return jsonError(404, "No such endpoint.");
+        }
+        int electionId = 0;
+        if (!resolveElection(segments[1], electionId)) {
+            return jsonError(404, "Election not found.");
+        }
+
+        std::string_view resource = segments[2];
+        const char* allowed = nullptr;
+        if (resource == "votes" && segments.size() == 3) {
+            if (request.method == "POST") {
+                return castVote(electionId, request);
+            }
+            allowed = "POST";
+        } else if (resource == "voters" && segments.size() == 4) {
+            if (request.method == "GET") {
+                return voterStatus(electionId, segments[3]);
+            }
+            allowed = "GET";
+        } else if (resource == "results" && segments.size() == 3) {
+            if (request.method == "GET") {
+                return results(electionId);
+            }
+            allowed = "GET";
+        } else {
+            return jsonError(404, "No such endpoint.");
+        }
+
+        HttpResponse response = jsonError(405, std::string("Use ") + allowed + ".");
+        response.headers.emplace_back("Allow", allowed);
+        return response;
+    } catch (const std::exception& e) {
+        return jsonError(500, std::string("Internal error: ") + e.what());
+    }
+}
+
+HttpResponse HttpApi::castVote(int electionId, const HttpRequest& request) {
+    std::map<std::string, std::string> fields;
+    int voterId = 0;
+    int candidateIndex = 0;
+    if (!parseFlatObject(request.body, fields) ||
+        !parseInt(fields["voterId"], voterId) || !parseInt(fields["candidateIndex"], candidateIndex)) {
+        return jsonError(400, "Expected {\"voterId\": <int>, \"candidateIndex\": <int>}.");
+    }
+
+    ServiceResponse response = service.castVote(electionId, voterId, candidateIndex);
+    if (!response.success) {
+        return serviceError(response, 422);
+    }
+    return HttpResponse(200, "{\"success\":true,\"message\":" + quote(response.message) + "}");
+}
+
+HttpResponse HttpApi::voterStatus(int electionId, std::string_view voterIdText) {
+    int voterId = 0;
+    if (!parseInt(voterIdText, voterId)) {
+        return jsonError(400, "Voter ID must be a number.");
+    }
+
+    ServiceResponse response = service.checkVoterRegistration(electionId, voterId);
+    if (!response.success || response.data.size() != 2) {
+        return serviceError(response, 500);
+    }
+    bool registered = response.data[0] == "Registered: Yes";
+    bool voted = response.data[1] == "Has Voted: Yes";
+    return HttpResponse(200, "{\"voterId\":" + std::to_string(voterId) +
+                             ",\"registered\":" + (registered ? "true" : "false") +
+                             ",\"hasVoted\":" + (voted ? "true" : "false") + "}");
+}
+
+HttpResponse HttpApi::results(int electionId) {
+    ServiceResponse response = service.getElectionResults(electionId);
+    if (!response.success) {
+        return serviceError(response, 500);
+    }
+
+    // Service result lines read "<candidate>: <count> votes"
+    std::string body = "{\"electionId\":" + std::to_string(electionId) + ",\"results\":[";
+    for (size_t i = 0; i < response.data.size(); ++i) {
+        const std::string& line = response.data[i];
+        size_t separator = line.rfind(": ");
+        int votes = 0;
+        if (separator != std::string::npos) {
+            std::string_view count = std::string_view(line).substr(separator + 2);
+            parseInt(count.substr(0, count.find(' ')), votes);
+        }
+        body += i == 0 ? "{\"candidate\":" : ",{\"candidate\":";
+        body += quote(std::string_view(line).substr(0, separator));
+        body += ",\"votes\":" + std::to_string(votes) + "}";
+    }
+    body += "]}";
+    return HttpResponse(200, body);
+}
+
+HttpResponse HttpApi::serviceError(const ServiceResponse& response, int failureStatus) const {
+    if (response.message.find("Election not found") != std::string::npos) {
+        return jsonError(404, response.message);
+    }
+    if (response.retryAfterMs > 0) {
+        HttpResponse busy = jsonError(503, response.message);
+        busy.headers.emplace_back("Retry-After", std::to_string((response.retryAfterMs + 999) / 1000));
+        return busy;
+    }
+    if (!service.isAcceptingRequests()) {
+        return jsonError(503, response.message);
+    }
+    return jsonError(failureStatus, response.message);
+}
+
+bool HttpApi::resolveElection(std::string_view segment, int& electionId) {
+    if (segment == "default") {
+        electionId = service.getDefaultElection();
+        return electionId > 0;
+    }
+    return parseInt(segment, electionId) && service.electionExists(electionId);
+}
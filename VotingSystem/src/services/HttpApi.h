@@ -0,0 +1,33 @@
+#pragma once
+#include "ClearBallotService.h"
+#include "HttpProtocol.h"
+#include <string>
+#include <string_view>
+
+// JSON endpoints over ClearBallotService. {election} is a numeric election ID
+// or "default" for the election shared by the console apps.
+//
+//   GET  /health
+//   POST /elections/{election}/votes              {"voterId": 1, "candidateIndex": 0}
+//   GET  /elections/{election}/voters/{voterId}   registration and voting status
+//   GET  /elections/{election}/results            vote counts per candidate
+//
+// Stateless apart from the service, so one instance serves every worker thread.
+class HttpApi {
+public:
+    explicit HttpApi(ClearBallotService& service);
+
+    HttpResponse handle(const HttpRequest& request);
+
+    // JSON string literal for text, quotes included
+    static std::string quote(std::string_view text);
+
+private:
+    ClearBallotService& service;
+
+    HttpResponse castVote(int electionId, const HttpRequest& request);
+    HttpResponse voterStatus(int electionId, std::string_view voterId);
+    HttpResponse results(int electionId);
+    HttpResponse serviceError(const ServiceResponse& response, int failureStatus) const;
+    bool resolveElection(std::string_view segment, int& electionId);
+};
@@ -0,0 +1,167 @@
+#include "HttpProtocol.h"
+#include <charconv>
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] + 32) : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] + 32) : b[i];
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// True if the comma-separated header value lists token (e.g. "close")
+bool hasToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        size_t comma = value.find(',');
+        if (equalsIgnoreCase(trim(value.substr(0, comma)), token)) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        value.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+} // namespace
+
+HttpProtocol::ParseStatus HttpProtocol::parseRequest(std::string_view buffer, HttpRequest& request,
+                                                     size_t& consumed, int& errorStatus) {
+    size_t headerEnd = buffer.substr(0, MAX_HEADER_SIZE).find("\r\n\r\n");
+    if (headerEnd == std::string_view::npos) {
+        if (buffer.size() >= MAX_HEADER_SIZE) {
+            errorStatus = 431;
+            return ParseStatus::Rejected;
+        }
+        return ParseStatus::Incomplete;
+    }
+    std::string_view head = buffer.substr(0, headerEnd);
+
+    // Request line: METHOD SP target SP HTTP/1.x
+    size_t lineEnd = head.find("\r\n");
+    std::string_view line = head.substr(0, lineEnd);
+    size_t firstSpace = line.find(' ');
+    size_t secondSpace = firstSpace == std::string_view::npos ? firstSpace : line.find(' ', firstSpace + 1);
+    if (secondSpace == std::string_view::npos || firstSpace == 0 || secondSpace == firstSpace + 1) {
+        errorStatus = 400;
+        return ParseStatus::Rejected;
+    }
+    std::string_view version = line.substr(secondSpace + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        errorStatus = version.substr(0, 5) == "HTTP/" ? 505 : 400;
+        return ParseStatus::Rejected;
+    }
+    std::string_view target = line.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    size_t queryStart = target.find('?');
+    request.method.assign(line.data(), firstSpace);
+    request.path.assign(target.substr(0, queryStart));
+    request.query.assign(queryStart == std::string_view::npos ? std::string_view() : target.substr(queryStart + 1));
+    request.keepAlive = version == "HTTP/1.1";
+
+    // Only the headers that affect framing are interpreted
+    size_t contentLength = 0;
+    bool sawContentLength = false;
+    while (lineEnd != std::string_view::npos) {
+        head.remove_prefix(lineEnd + 2);
+        lineEnd = head.find("\r\n");
+        std::string_view header = head.substr(0, lineEnd);
+        size_t colon = header.find(':');
+        if (colon == std::string_view::npos || colon == 0) {
+            errorStatus = 400;
+            return ParseStatus::Rejected;
+        }
+        std::string_view name = header.substr(0, colon);
+        std::string_view value = trim(header.substr(colon + 1));
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            size_t length = 0;
+            auto result = std::from_chars(value.data(), value.data() + value.size(), length);
+            if (result.ec != std::errc() || result.ptr != value.data() + value.size() ||
+                (sawContentLength && length != contentLength)) {
+                errorStatus = 400;
+                return ParseStatus::Rejected;
+            }
+            contentLength = length;
+            sawContentLength = true;
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            errorStatus = 501;   // Chunked request bodies are not supported
+            return ParseStatus::Rejected;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            if (hasToken(value, "close")) {
+                request.keepAlive = false;
+            } else if (hasToken(value, "keep-alive")) {
+                request.keepAlive = true;
+            }
+        }
+    }
+
+    if (contentLength > MAX_BODY_SIZE) {
+        errorStatus = 413;
+        return ParseStatus::Rejected;
+    }
+    size_t bodyStart = headerEnd + 4;
+    if (buffer.size() - bodyStart < contentLength) {
+        return ParseStatus::Incomplete;
+    }
+    request.body.assign(buffer.substr(bodyStart, contentLength));
+    consumed = bodyStart + contentLength;
+    return ParseStatus::Complete;
+}
+
+void HttpProtocol::writeResponse(const HttpResponse& response, bool keepAlive, std::string& out) {
+    char number[16];
+    out += "HTTP/1.1 ";
+    out.append(number, std::to_chars(number, number + sizeof(number), response.status).ptr);
+    out += ' ';
+    out += reasonPhrase(response.status);
+    out += "\r\nContent-Type: ";
+    out += response.contentType;
+    out += "\r\nContent-Length: ";
+    out.append(number, std::to_chars(number, number + sizeof(number), response.body.size()).ptr);
+    out += keepAlive ? "\r\nConnection: keep-alive\r\n" : "\r\nConnection: close\r\n";
+    for (const auto& header : response.headers) {
+        out += header.first;
+        out += ": ";
+        out += header.second;
+        out += "\r\n";
+    }
+    out += "\r\n";
+    out += response.body;
+}
+
+const char* HttpProtocol::reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 422: return "Unprocessable Entity";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct HttpRequest {
+    std::string method;
+    std::string path;     // Target without the query string
+    std::string query;
+    std::string body;
+    bool keepAlive = true;
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string contentType = "application/json";
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;  // Extra headers, e.g. Allow
+
+    HttpResponse() = default;
+    HttpResponse(int status, std::string body) : status(status), body(std::move(body)) {}
+};
+
+// HTTP/1.1 message framing for the embedded API server: requests with a
+// Content-Length body (or none), persistent connections by default and any
+// number of requests pipelined back to back in one buffer.
+class HttpProtocol {
+public:
+    static constexpr size_t MAX_HEADER_SIZE = 16 * 1024;
+    static constexpr size_t MAX_BODY_SIZE = 1024 * 1024;
+
+    enum class ParseStatus { Complete, Incomplete, Rejected };
+
+    // Parses the request at the start of buffer. On Complete, consumed is its
+    // length; on Rejected, errorStatus is the status to answer before closing.
+    static ParseStatus parseRequest(std::string_view buffer, HttpRequest& request,
+                                    size_t& consumed, int& errorStatus);
+
+    // Appends the status line, headers and body to out
+    static void writeResponse(const HttpResponse& response, bool keepAlive, std::string& out);
+
+    static const char* reasonPhrase(int status);
+};
@@ -0,0 +1,255 @@
+#include "HttpServer.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+#ifdef __linux__
+#define CLEARBALLOT_HAVE_EPOLL 1
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+HttpServer::HttpServer(ClearBallotService& service)
+    : api(service), listenFd(-1), wakeFd(-1), port(0),
+      running(false), connectionCount(0), requestsServed(0) {}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+bool HttpServer::isRunning() const {
+    return running.load();
+}
+
+uint16_t HttpServer::getPort() const {
+    return port;
+}
+
+size_t HttpServer::getWorkerCount() const {
+    return workers.size();
+}
+
+size_t HttpServer::getConnectionCount() const {
+    return connectionCount.load();
+}
+
+uint64_t HttpServer::getRequestsServed() const {
+    return requestsServed.load();
+}
+
+#ifdef CLEARBALLOT_HAVE_EPOLL
+
+bool HttpServer::start(const Options& options) {
+    if (running.load()) {
+        return true;
+    }
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (::inet_pton(AF_INET, options.bindAddress.c_str(), &address.sin_addr) != 1) {
+        std::cout << "[HTTP ERROR] Invalid bind address: " << options.bindAddress << "\n";
+        return false;
+    }
+
+    listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int reuse = 1;
+    socklen_t length = sizeof(address);
+    bool ready = listenFd >= 0 && wakeFd >= 0 &&
+                 ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) == 0 &&
+                 ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                 ::listen(listenFd, SOMAXCONN) == 0 &&
+                 ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+
+    size_t workerCount = options.workerThreads;
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; ready && i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        epoll_event event{};
+        // Exclusive: a new connection wakes one worker rather than all of them
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd = listenFd;
+        ready = worker->epollFd >= 0 && ::epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+        event.events = EPOLLIN;
+        event.data.fd = wakeFd;
+        ready = ready && ::epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0;
+        workers.push_back(std::move(worker));
+    }
+    if (!ready) {
+        std::cout << "[HTTP ERROR] Could not listen on " << options.bindAddress << ":" << options.port
+                  << ": " << std::strerror(errno) << "\n";
+        closeAll();
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    running.store(true);
+    for (auto& worker : workers) {
+        worker->thread = std::thread(&HttpServer::run, this, std::ref(*worker));
+    }
+    std::cout << "[HTTP] Listening on http://" << options.bindAddress << ":" << port
+              << " with " << workers.size() << " worker(s)\n";
+    return true;
+}
+
+void HttpServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    // Never read, so the eventfd stays readable and wakes every worker
+    uint64_t one = 1;
+    if (::write(wakeFd, &one, sizeof(one)) < 0) {
+        // Workers also notice running == false on their next wakeup
+    }
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+    closeAll();
+    std::cout << "[HTTP] Stopped listening on port " << port << "\n";
+}
+
+void HttpServer::run(Worker& worker) {
+    ConnectionLoop::run(worker.epollFd, running, "[HTTP ERROR]", [this, &worker](int fd, uint32_t events) {
+        if (fd == wakeFd) {
+            return;
+        }
+        if (fd == listenFd) {
+            acceptConnections(worker);
+            return;
+        }
+
+        auto it = worker.connections.find(fd);
+        if (it == worker.connections.end()) {
+            return;
+        }
+        Connection& connection = *it->second;
+        bool keep = ConnectionLoop::dispatch(events, [&]() { return readRequests(worker, connection); },
+                                             [&]() { return writeResponses(worker, connection); });
+        if (!keep) {
+            closeConnection(worker, fd);
+        }
+    });
+}
+
+void HttpServer::acceptConnections(Worker& worker) {
+    ConnectionLoop::acceptAll(listenFd, worker.epollFd, [this, &worker](int fd) {
+        int noDelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->interest = EPOLLIN;
+        worker.connections[fd] = std::move(connection);
+        ++connectionCount;
+    });
+}
+
+bool HttpServer::readRequests(Worker& worker, Connection& connection) {
+    ConnectionLoop::ReadStatus read = ConnectionLoop::readAvailable(connection);
+    if (read == ConnectionLoop::ReadStatus::Failed) {
+        return false;
+    }
+    if (read == ConnectionLoop::ReadStatus::PeerClosed) {
+        // Half-closed: answer what was sent, then close
+        connection.closeAfterWrite = true;
+    }
+
+    // Answer every complete request in arrival order
+    HttpRequest request;
+    size_t consumed = 0;
+    while (true) {
+        size_t requestSize = 0;
+        int errorStatus = 0;
+        std::string_view pending = std::string_view(connection.input).substr(consumed);
+        HttpProtocol::ParseStatus status = HttpProtocol::parseRequest(pending, request, requestSize, errorStatus);
+        if (status == HttpProtocol::ParseStatus::Incomplete) {
+            break;
+        }
+        if (status == HttpProtocol::ParseStatus::Rejected) {
+            HttpResponse response(errorStatus, "{\"success\":false,\"message\":" +
+                                               HttpApi::quote(HttpProtocol::reasonPhrase(errorStatus)) + "}");
+            HttpProtocol::writeResponse(response, false, connection.output);
+            connection.closeAfterWrite = true;
+            consumed = connection.input.size();
+            break;
+        }
+
+        HttpProtocol::writeResponse(api.handle(request), request.keepAlive, connection.output);
+        ++requestsServed;
+        consumed += requestSize;
+        if (!request.keepAlive) {
+            connection.closeAfterWrite = true;
+            consumed = connection.input.size();   // Anything pipelined after Connection: close is dropped
+            break;
+        }
+    }
+    connection.input.erase(0, consumed);
+
+    return writeResponses(worker, connection);
+}
+
+bool HttpServer::writeResponses(Worker& worker, Connection& connection) {
+    if (!ConnectionLoop::writeQueued(connection)) {
+        return false;
+    }
+    if (connection.closeAfterWrite && ConnectionLoop::pendingOutput(connection) == 0) {
+        return false;
+    }
+    // Also stop reading once the connection is closing
+    return ConnectionLoop::updateInterest(worker.epollFd, connection, !connection.closeAfterWrite);
+}
+
+void HttpServer::closeConnection(Worker& worker, int fd) {
+    ConnectionLoop::close(worker.epollFd, fd);
+    if (worker.connections.erase(fd) > 0) {
+        --connectionCount;
+    }
+}
+
+void HttpServer::closeAll() {
+    for (auto& worker : workers) {
+        for (const auto& entry : worker->connections) {
+            ::close(entry.first);
+        }
+        if (worker->epollFd >= 0) {
+            ::close(worker->epollFd);
+        }
+    }
+    workers.clear();
+    connectionCount.store(0);
+    for (int* fd : {&listenFd, &wakeFd}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+#else
+
+bool HttpServer::start(const Options& options) {
+    std::cout << "[HTTP ERROR] The HTTP server is only available on Linux (requested port "
+              << options.port << ").\n";
+    return false;
+}
+
+void HttpServer::stop() {}
+void HttpServer::run(Worker&) {}
+void HttpServer::acceptConnections(Worker&) {}
+bool HttpServer::readRequests(Worker&, Connection&) { return false; }
+bool HttpServer::writeResponses(Worker&, Connection&) { return false; }
+void HttpServer::closeConnection(Worker&, int) {}
+void HttpServer::closeAll() {}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+#include "ConnectionLoop.h"
+#include "HttpApi.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Embedded HTTP/1.1 front end for a ClearBallotService.
+//
+// A fixed pool of worker threads shares one non-blocking listening socket;
+// each worker runs its own epoll loop and owns the connections it accepts, so
+// a connection is never touched by two threads. Connections are kept alive
+// and pipelined requests are answered in order. Linux only; start() fails
+// elsewhere.
+//
+// Requests are served on the worker's own event-loop thread, service call
+// included. They never wait in an admission queue there: a request whose lane
+// is saturated is answered at once with a retry hint. A request waiting for
+// an election's lock still holds up every other connection on that worker
+// for as long, so size workerThreads for the number of requests expected to
+// contend at once rather than for the core count alone.
+class HttpServer {
+public:
+    struct Options {
+        std::string bindAddress = "127.0.0.1";
+        uint16_t port = 8080;          // 0 picks a free port; see getPort()
+        size_t workerThreads = 0;      // 0 = one per core
+    };
+
+    explicit HttpServer(ClearBallotService& service);
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    bool start(const Options& options);
+    bool start() { return start(Options()); }
+    // Closes every connection and joins the workers
+    void stop();
+
+    bool isRunning() const;
+    uint16_t getPort() const;
+    size_t getWorkerCount() const;
+    size_t getConnectionCount() const;
+    uint64_t getRequestsServed() const;
+
+private:
+    struct Connection : StreamConnection {
+        bool closeAfterWrite = false;  // Last response said Connection: close
+    };
+
+    struct Worker {
+        int epollFd = -1;
+        std::thread thread;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;  // This worker's thread only
+    };
+
+    HttpApi api;
+    int listenFd;
+    int wakeFd;
+    uint16_t port;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> running;
+    std::atomic<size_t> connectionCount;
+    std::atomic<uint64_t> requestsServed;
+
+    void run(Worker& worker);
+    void acceptConnections(Worker& worker);
+    bool readRequests(Worker& worker, Connection& connection);
+    bool writeResponses(Worker& worker, Connection& connection);
+    void closeConnection(Worker& worker, int fd);
+    void closeAll();
+};
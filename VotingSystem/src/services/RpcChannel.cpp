@@ -0,0 +1,278 @@
+#include "RpcChannel.h"
+#include "RpcProtocol.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CLEARBALLOT_HAVE_UNIX_SOCKETS 1
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+RpcChannel::RpcChannel() : fd(-1), open(false), linked(false), nextRequestId(1) {}
+
+RpcChannel::~RpcChannel() {
+    close();
+}
+
+bool RpcChannel::isOpen() const {
+    return open.load();
+}
+
+bool RpcChannel::usesSharedMemory() const {
+    return linked.load();
+}
+
+size_t RpcChannel::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    return pending.size();
+}
+
+ServiceResponse RpcChannel::lostConnection() {
+    return ServiceResponse(false, "[CLIENT ERROR] Lost connection to service.");
+}
+
+ServiceResponse RpcChannel::call(std::string frame) {
+    return callAsync(std::move(frame)).get();
+}
+
+std::future<ServiceResponse> RpcChannel::callAsync(std::string frame) {
+    auto promise = std::make_shared<std::promise<ServiceResponse>>();
+    std::future<ServiceResponse> result = promise->get_future();
+    callAsync(std::move(frame), [promise](const ServiceResponse& response) {
+        promise->set_value(response);
+    });
+    return result;
+}
+
+void RpcChannel::callAsync(std::string frame, Callback done) {
+    if (!open.load()) {
+        done(lostConnection());
+        return;
+    }
+
+    uint32_t requestId;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        requestId = nextRequestId++;
+        if (requestId == 0) {
+            requestId = nextRequestId++;   // 0 is what the server echoes for unreadable requests
+        }
+        pending.emplace(requestId, std::move(done));
+    }
+    RpcProtocol::setRequestId(frame, requestId);
+
+    bool sent;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        sent = open.load() && (linked.load() ? link->requests().write(frame.data(), frame.size())
+                                             : sendAll(frame.data(), frame.size()));
+    }
+    if (!sent) {
+        // The reader may already have failed this request along with the rest
+        Callback orphan;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            auto it = pending.find(requestId);
+            if (it != pending.end()) {
+                orphan = std::move(it->second);
+                pending.erase(it);
+            }
+        }
+        if (orphan) {
+            orphan(lostConnection());
+        }
+    }
+}
+
+void RpcChannel::failPending() {
+    std::unordered_map<uint32_t, Callback> failed;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        failed.swap(pending);
+    }
+    ServiceResponse lost = lostConnection();
+    for (auto& entry : failed) {
+        entry.second(lost);
+    }
+}
+
+#ifdef CLEARBALLOT_HAVE_UNIX_SOCKETS
+
+bool RpcChannel::connect(const std::string& socketPath) {
+    close();
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cout << "[CLIENT ERROR] Socket path is empty or too long: " << socketPath << "\n";
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cout << "[CLIENT ERROR] Could not connect to " << socketPath << ": " << std::strerror(errno) << "\n";
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        return false;
+    }
+    open.store(true);
+    reader = std::thread(&RpcChannel::readLoop, this, false);
+    return true;
+}
+
+bool RpcChannel::attachSharedMemory() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (!open.load() || linked.load()) {
+        return linked.load();
+    }
+
+    std::string name = SharedMemoryLink::uniqueName();
+    std::unique_ptr<SharedMemoryLink> created = SharedMemoryLink::create(name);
+    if (!created) {
+        return false;
+    }
+    // The service maps the segment before it answers; after that the name is not needed
+    ServiceResponse response = call(RpcWriter(RpcOp::AttachSharedMemory).add(name).finish());
+    SharedMemoryLink::unlink(name);
+    if (!response.success || !open.load()) {
+        return false;
+    }
+
+    link = std::move(created);
+    ringReader = std::thread(&RpcChannel::readLoop, this, true);
+    linked.store(true);
+    return true;
+}
+
+void RpcChannel::close() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (fd < 0) {
+        return;
+    }
+    open.store(false);
+    ::shutdown(fd, SHUT_RDWR);   // Wakes the socket reader
+    if (link) {
+        link->close();           // Wakes the ring reader and the service's session
+    }
+    joinReader(reader);
+    joinReader(ringReader);
+    {
+        std::lock_guard<std::mutex> sendLock(sendMutex);
+        ::close(fd);
+        fd = -1;
+        linked.store(false);
+        link.reset();
+    }
+    failPending();
+}
+
+void RpcChannel::joinReader(std::thread& thread) {
+    if (!thread.joinable()) {
+        return;
+    }
+    if (thread.get_id() == std::this_thread::get_id()) {
+        thread.detach();   // Closed from a callback; the reader exits on its own
+    } else {
+        thread.join();
+    }
+}
+
+void RpcChannel::readLoop(bool fromSharedMemory) {
+    // Once attached, the socket reader sees nothing more until either side goes
+    // away, and then takes the rings down with it
+    auto receive = [this, fromSharedMemory](char* data, size_t size) {
+        return fromSharedMemory ? link->responses().read(data, size) : receiveAll(data, size);
+    };
+    std::string payload;
+    while (true) {
+        char header[RpcProtocol::FRAME_HEADER_SIZE];
+        size_t length = 0;
+        if (!receive(header, sizeof(header)) || !RpcProtocol::payloadLength(header, length)) {
+            break;
+        }
+        payload.resize(length);
+        uint32_t requestId = 0;
+        ServiceResponse response;
+        if (!receive(&payload[0], length) || !RpcProtocol::decodeResponse(payload, requestId, response)) {
+            break;
+        }
+
+        Callback done;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            auto it = pending.find(requestId);
+            if (it != pending.end()) {
+                done = std::move(it->second);
+                pending.erase(it);
+            }
+        }
+        if (done) {
+            done(response);
+        }
+    }
+    open.store(false);
+    if (linked.load()) {
+        link->close();
+    }
+    failPending();
+}
+
+bool RpcChannel::sendAll(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t bytes = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        data += bytes;
+        size -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+bool RpcChannel::receiveAll(char* data, size_t size) {
+    while (size > 0) {
+        ssize_t bytes = ::recv(fd, data, size, 0);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        data += bytes;
+        size -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+#else
+
+bool RpcChannel::connect(const std::string& socketPath) {
+    std::cout << "[CLIENT ERROR] Socket connections are not supported on this platform (" << socketPath << ").\n";
+    return false;
+}
+
+bool RpcChannel::attachSharedMemory() { return false; }
+void RpcChannel::close() {}
+void RpcChannel::joinReader(std::thread&) {}
+void RpcChannel::readLoop(bool) {}
+bool RpcChannel::sendAll(const char*, size_t) { return false; }
+bool RpcChannel::receiveAll(char*, size_t) { return false; }
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+#include "ClearBallotService.h"
+#include "SharedMemoryRing.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Client end of the RPC socket. One connection carries any number of
+// requests in flight: each request frame is stamped with a fresh request ID,
+// written whole under a send lock, and a reader thread hands every response to
+// the waiter registered under its ID, in whatever order responses arrive.
+// After attachSharedMemory() requests and responses travel through a pair of
+// shared-memory rings instead, and the socket only signals that either side
+// has gone away.
+class RpcChannel {
+public:
+    // Runs on the reader thread; it must not block or make synchronous calls
+    // on the same channel
+    using Callback = std::function<void(const ServiceResponse&)>;
+
+    RpcChannel();
+    ~RpcChannel();
+
+    RpcChannel(const RpcChannel&) = delete;
+    RpcChannel& operator=(const RpcChannel&) = delete;
+
+    bool connect(const std::string& socketPath);
+    // Same-host fast path; call right after connect(), before any requests.
+    // On failure the channel keeps using the socket.
+    bool attachSharedMemory();
+    void close();
+    bool isOpen() const;
+    bool usesSharedMemory() const;
+    size_t getPendingCount() const;
+
+    // Sends a finished request frame and waits for its response. If the
+    // connection breaks first, the response is a "Lost connection" error.
+    ServiceResponse call(std::string frame);
+    std::future<ServiceResponse> callAsync(std::string frame);
+    void callAsync(std::string frame, Callback done);
+
+    static ServiceResponse lostConnection();
+
+private:
+    int fd;
+    std::thread reader;
+    std::atomic<bool> open;
+    std::unique_ptr<SharedMemoryLink> link;
+    std::thread ringReader;
+    std::atomic<bool> linked;    // link is set and carries the traffic
+    std::mutex lifecycleMutex;   // connect() and close()
+    std::mutex sendMutex;        // One frame on the wire at a time
+    mutable std::mutex pendingMutex;
+    std::unordered_map<uint32_t, Callback> pending;
+    uint32_t nextRequestId;
+
+    void readLoop(bool fromSharedMemory);
+    static void joinReader(std::thread& thread);
+    void failPending();
+    bool sendAll(const char* data, size_t size);
+    bool receiveAll(char* data, size_t size);
+};
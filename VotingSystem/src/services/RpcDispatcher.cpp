@@ -0,0 +1,268 @@
+#include "RpcDispatcher.h"
+#include "RpcProtocol.h"
+#include <exception>
+
+namespace {
+
+ServiceResponse malformed() {
+    return ServiceResponse(false, "[SERVICE ERROR] Malformed request.");
+}
+
+bool readVoter(RpcReader& reader, std::string fields[6]) {
+    for (int i = 0; i < 6; ++i) {
+        if (!reader.read(fields[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+RpcDispatcher::RpcDispatcher(ClearBallotService& service) : service(service) {}
+
+void RpcDispatcher::handle(std::string_view payload, std::string& out) {
+    // Echo the request ID; a payload too short to carry one is answered as ID 0
+    RpcReader reader(payload);
+    uint32_t requestId = 0;
+    ServiceResponse response;
+    if (!reader.read(requestId)) {
+        response = malformed();
+    } else {
+        try {
+            response = execute(reader);
+        } catch (const std::exception& e) {
+            response = ServiceResponse(false, std::string("[SERVICE ERROR] ") + e.what());
+        }
+    }
+    RpcProtocol::encodeResponse(requestId, response, out);
+}
+
+uint64_t RpcDispatcher::affinityKey(std::string_view payload) {
+    RpcReader reader(payload);
+    uint32_t requestId = 0;
+    RpcOp op;
+    int32_t electionId = 0;
+    if (!reader.read(requestId) || !reader.read(op) || op == RpcOp::CreateElection ||
+        op == RpcOp::GetDefaultElection || op == RpcOp::AttachSharedMemory || !reader.read(electionId) ||
+        electionId < 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(electionId);
+}
+
+ServiceResponse RpcDispatcher::execute(RpcReader& reader) {
+    RpcOp op;
+    if (!reader.read(op)) {
+        return malformed();
+    }
+
+    // Every operation except CreateElection and GetDefaultElection starts with the election ID
+    int32_t electionId = 0;
+    std::string text[3];
+    std::string voter[6];
+    int32_t first = 0;
+    int32_t second = 0;
+    bool flag = false;
+
+    switch (op) {
+        case RpcOp::CreateElection: {
+            if (!reader.read(text[0]) || !reader.atEnd()) {
+                return malformed();
+            }
+            int id = service.createElection(text[0]);
+            ServiceResponse response(id > 0, id > 0 ? "Election created." : "Failed to create election.");
+            response.data.push_back(std::to_string(id));
+            return response;
+        }
+        case RpcOp::GetDefaultElection: {
+            if (!reader.atEnd()) {
+                return malformed();
+            }
+            int id = service.getDefaultElection();
+            ServiceResponse response(id > 0, id > 0 ? "Default election ready." : "No default election.");
+            response.data.push_back(std::to_string(id));
+            return response;
+        }
+        case RpcOp::AttachSharedMemory:
+            return ServiceResponse(false, "[SERVICE ERROR] Shared memory can only be attached over the socket.");
+        default:
+            break;
+    }
+
+    if (!reader.read(electionId)) {
+        return malformed();
+    }
+
+    ServiceResponse response;
+    bool decoded = true;
+    switch (op) {
+        case RpcOp::ElectionExists:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = ServiceResponse(service.electionExists(electionId));
+            }
+            break;
+        case RpcOp::RegisterVoter:
+            decoded = readVoter(reader, voter) && reader.atEnd();
+            if (decoded) {
+                response = service.registerVoter(electionId, VoterRegistrationData(
+                    voter[0], voter[1], voter[2], voter[3], voter[4], voter[5]));
+            }
+            break;
+        case RpcOp::CastVote:
+            decoded = reader.read(first) && reader.read(second) && reader.atEnd();
+            if (decoded) {
+                response = service.castVote(electionId, first, second);
+            }
+            break;
+        case RpcOp::GetCandidates:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getCandidates(electionId);
+            }
+            break;
+        case RpcOp::GetVoters:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getVoters(electionId);
+            }
+            break;
+        case RpcOp::GetElectionResults:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getElectionResults(electionId);
+            }
+            break;
+        case RpcOp::CheckVoterRegistration:
+            decoded = reader.read(first) && reader.atEnd();
+            if (decoded) {
+                response = service.checkVoterRegistration(electionId, first);
+            }
+            break;
+        case RpcOp::AddCandidate:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.addCandidate(electionId, text[0]);
+            }
+            break;
+        case RpcOp::AddCandidateWithParty:
+            decoded = reader.read(text[0]) && reader.read(text[1]) && reader.atEnd();
+            if (decoded) {
+                response = service.addCandidateWithParty(electionId, text[0], text[1]);
+            }
+            break;
+        case RpcOp::CreateParty:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.createParty(electionId, text[0]);
+            }
+            break;
+        case RpcOp::SetValidationRules:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.setValidationRules(electionId, text[0]);
+            }
+            break;
+        case RpcOp::GetParties:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getParties(electionId);
+            }
+            break;
+        case RpcOp::CreateRegion:
+            decoded = reader.read(text[0]) && reader.read(text[1]) && reader.atEnd();
+            if (decoded) {
+                response = service.createRegion(electionId, text[0], text[1]);
+            }
+            break;
+        case RpcOp::GetRegions:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getRegions(electionId);
+            }
+            break;
+        case RpcOp::AddCandidateToRegion:
+            decoded = reader.read(text[0]) && reader.read(text[1]) && reader.atEnd();
+            if (decoded) {
+                response = service.addCandidateToRegion(electionId, text[0], text[1]);
+            }
+            break;
+        case RpcOp::AddPartyCandidateToRegion:
+            decoded = reader.read(text[0]) && reader.read(text[1]) && reader.read(text[2]) && reader.atEnd();
+            if (decoded) {
+                response = service.addCandidateToRegion(electionId, text[0], text[1], text[2]);
+            }
+            break;
+        case RpcOp::RegisterVoterInRegion:
+            decoded = readVoter(reader, voter) && reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.registerVoterInRegion(electionId, VoterRegistrationData(
+                    voter[0], voter[1], voter[2], voter[3], voter[4], voter[5]), text[0]);
+            }
+            break;
+        case RpcOp::CastVoteInRegion:
+            decoded = reader.read(first) && reader.read(second) && reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.castVoteInRegion(electionId, first, second, text[0]);
+            }
+            break;
+        case RpcOp::GetRegionalResults:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.getRegionalResults(electionId, text[0]);
+            }
+            break;
+        case RpcOp::SaveElectionResults:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.saveElectionResults(electionId, text[0]);
+            }
+            break;
+        case RpcOp::SaveCompleteElectionData:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.saveCompleteElectionData(electionId, text[0]);
+            }
+            break;
+        case RpcOp::LoadElectionData:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.loadElectionData(electionId, text[0]);
+            }
+            break;
+        case RpcOp::ExportElectionToCSV:
+            decoded = reader.read(text[0]) && reader.read(flag) && reader.atEnd();
+            if (decoded) {
+                response = service.exportElectionToCSV(electionId, text[0], flag);
+            }
+            break;
+        case RpcOp::ImportVotersFromCSV:
+            decoded = reader.read(text[0]) && reader.atEnd();
+            if (decoded) {
+                response = service.importVotersFromCSV(electionId, text[0]);
+            }
+            break;
+        case RpcOp::StartBulkJob:
+            decoded = reader.read(first) && reader.read(text[0]) && reader.read(flag) && reader.atEnd();
+            if (decoded) {
+                response = service.startBulkJob(electionId, static_cast<BulkOperation>(first), text[0], flag);
+            }
+            break;
+        case RpcOp::GetJobStatus:
+            decoded = reader.read(first) && reader.atEnd();
+            if (decoded) {
+                response = service.getJobStatus(electionId, first);
+            }
+            break;
+        case RpcOp::GetMemoryUsage:
+            decoded = reader.atEnd();
+            if (decoded) {
+                response = service.getMemoryUsage(electionId);
+            }
+            break;
+        default:
+            return ServiceResponse(false, "[SERVICE ERROR] Unknown operation.");
+    }
+    return decoded ? response : malformed();
+}
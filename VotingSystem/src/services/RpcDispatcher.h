@@ -0,0 +1,26 @@
+#pragma once
+#include "ClearBallotService.h"
+#include <string>
+#include <string_view>
+
+class RpcReader;
+
+// Decodes request payloads, runs them against a ClearBallotService and encodes
+// the response frame. Transport independent: the socket server and any other
+// transport hand it complete payloads.
+class RpcDispatcher {
+public:
+    explicit RpcDispatcher(ClearBallotService& service);
+
+    // Appends the response frame for one request payload to out. A payload
+    // that cannot be decoded gets an error response; it never throws.
+    void handle(std::string_view payload, std::string& out);
+    // The election a request payload targets, or 0 for requests that are not
+    // about one election; executors route requests by it
+    static uint64_t affinityKey(std::string_view payload);
+
+private:
+    ClearBallotService& service;
+
+    ServiceResponse execute(RpcReader& reader);
+};
@@ -0,0 +1,189 @@
+#include "RpcProtocol.h"
+#include "ClearBallotService.h"
+
+namespace {
+
+void appendUint32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>(value >> (8 * i));
+    }
+}
+
+uint32_t readUint32(const char* p) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(p);
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) |
+           (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+void patchLength(std::string& frame, size_t frameStart) {
+    uint32_t length = static_cast<uint32_t>(frame.size() - frameStart - RpcProtocol::FRAME_HEADER_SIZE);
+    for (int i = 0; i < 4; ++i) {
+        frame[frameStart + i] = static_cast<char>(length >> (8 * i));
+    }
+}
+
+} // namespace
+
+bool RpcProtocol::payloadLength(const char* header, size_t& length) {
+    length = readUint32(header);
+    return length <= MAX_FRAME_SIZE;
+}
+
+RpcProtocol::FrameStatus RpcProtocol::nextFrame(std::string_view buffer, std::string_view& payload,
+                                                size_t& frameSize) {
+    if (buffer.size() < FRAME_HEADER_SIZE) {
+        return FrameStatus::Incomplete;
+    }
+    size_t length = 0;
+    if (!payloadLength(buffer.data(), length)) {
+        return FrameStatus::TooLarge;
+    }
+    if (buffer.size() - FRAME_HEADER_SIZE < length) {
+        return FrameStatus::Incomplete;
+    }
+    payload = buffer.substr(FRAME_HEADER_SIZE, length);
+    frameSize = FRAME_HEADER_SIZE + length;
+    return FrameStatus::Complete;
+}
+
+void RpcProtocol::setRequestId(std::string& frame, uint32_t requestId) {
+    for (size_t i = 0; i < REQUEST_ID_SIZE; ++i) {
+        frame[FRAME_HEADER_SIZE + i] = static_cast<char>(requestId >> (8 * i));
+    }
+}
+
+void RpcProtocol::encodeResponse(uint32_t requestId, const ServiceResponse& response, std::string& out) {
+    RpcWriter writer;
+    writer.add(requestId).add(response.success).add(response.message).add(static_cast<int32_t>(response.data.size()));
+    for (const auto& line : response.data) {
+        writer.add(line);
+    }
+    writer.add(static_cast<int32_t>(response.retryAfterMs));
+    writer.finishInto(out);
+}
+
+bool RpcProtocol::decodeResponse(std::string_view payload, uint32_t& requestId, ServiceResponse& response) {
+    RpcReader reader(payload);
+    int32_t count = 0;
+    if (!reader.read(requestId) || !reader.read(response.success) || !reader.read(response.message) || !reader.read(count) || count < 0) {
+        return false;
+    }
+    response.data.clear();
+    for (int32_t i = 0; i < count; ++i) {
+        std::string line;
+        if (!reader.read(line)) {
+            return false;
+        }
+        response.data.push_back(std::move(line));
+    }
+    int32_t retryAfterMs = 0;
+    if (!reader.read(retryAfterMs) || retryAfterMs < 0) {
+        return false;
+    }
+    response.retryAfterMs = retryAfterMs;
+    return reader.atEnd();
+}
+
+RpcWriter::RpcWriter() {
+    frame.append(RpcProtocol::FRAME_HEADER_SIZE, '\0');
+}
+
+RpcWriter::RpcWriter(RpcOp op) : RpcWriter() {
+    frame.append(RpcProtocol::REQUEST_ID_SIZE, '\0');
+    frame += static_cast<char>(op);
+}
+
+RpcWriter& RpcWriter::add(int32_t value) {
+    appendUint32(frame, static_cast<uint32_t>(value));
+    return *this;
+}
+
+RpcWriter& RpcWriter::add(uint32_t value) {
+    appendUint32(frame, value);
+    return *this;
+}
+
+RpcWriter& RpcWriter::add(bool value) {
+    frame += static_cast<char>(value ? 1 : 0);
+    return *this;
+}
+
+RpcWriter& RpcWriter::add(std::string_view value) {
+    appendUint32(frame, static_cast<uint32_t>(value.size()));
+    frame.append(value.data(), value.size());
+    return *this;
+}
+
+void RpcWriter::finishInto(std::string& out) {
+    patchLength(frame, 0);
+    out += frame;
+}
+
+const std::string& RpcWriter::finish() {
+    patchLength(frame, 0);
+    return frame;
+}
+
+RpcReader::RpcReader(std::string_view payload) : payload(payload), position(0) {}
+
+bool RpcReader::take(size_t count, const char*& data) {
+    if (payload.size() - position < count) {
+        return false;
+    }
+    data = payload.data() + position;
+    position += count;
+    return true;
+}
+
+bool RpcReader::read(RpcOp& op) {
+    const char* data;
+    if (!take(1, data)) {
+        return false;
+    }
+    op = static_cast<RpcOp>(static_cast<unsigned char>(*data));
+    return true;
+}
+
+bool RpcReader::read(int32_t& value) {
+    const char* data;
+    if (!take(4, data)) {
+        return false;
+    }
+    value = static_cast<int32_t>(readUint32(data));
+    return true;
+}
+
+bool RpcReader::read(uint32_t& value) {
+    const char* data;
+    if (!take(4, data)) {
+        return false;
+    }
+    value = readUint32(data);
+    return true;
+}
+
+bool RpcReader::read(bool& value) {
+    const char* data;
+    if (!take(1, data)) {
+        return false;
+    }
+    value = *data != 0;
+    return true;
+}
+
+bool RpcReader::read(std::string& value) {
+    const char* data;
+    if (!take(4, data)) {
+        return false;
+    }
+    size_t length = readUint32(data);
+    if (!take(length, data)) {
+        return false;
+    }
+    value.assign(data, length);
+    return true;
+}
+
+bool RpcReader::atEnd() const {
+    return position == payload.size();
+}
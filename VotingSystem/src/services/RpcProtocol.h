@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct ServiceResponse;
+
+// Operations of ClearBallotService as carried over the wire
+enum class RpcOp : uint8_t {
+    CreateElection = 1,
+    ElectionExists,
+    GetDefaultElection,
+    RegisterVoter,
+    CastVote,
+    GetCandidates,
+    GetVoters,
+    GetElectionResults,
+    CheckVoterRegistration,
+    AddCandidate,
+    AddCandidateWithParty,
+    CreateParty,
+    GetParties,
+    CreateRegion,
+    GetRegions,
+    AddCandidateToRegion,
+    AddPartyCandidateToRegion,
+    RegisterVoterInRegion,
+    CastVoteInRegion,
+    GetRegionalResults,
+    SaveElectionResults,
+    SaveCompleteElectionData,
+    LoadElectionData,
+    ExportElectionToCSV,
+    ImportVotersFromCSV,
+    AttachSharedMemory,     // Socket only: moves the connection's traffic onto a shared-memory link
+    StartBulkJob,
+    GetJobStatus,
+    GetMemoryUsage,
+    SetValidationRules
+};
+
+// Binary protocol between ServiceClient and the service process.
+//
+// Every message is a frame: a little-endian uint32 payload length followed by
+// the payload. Both directions start the payload with a uint32 request ID
+// chosen by the client and echoed by the server, so a client can keep many
+// requests in flight on one connection and match responses that arrive in any
+// order. A request continues with the operation byte and its arguments in the
+// order of the ClearBallotService method; a response with the success byte,
+// the message, the data lines and the retry-after hint in milliseconds (0 when
+// the request was not refused for load). Integers are little-endian int32 (uint32 for
+// IDs), strings a uint32 length followed by the bytes, and booleans a single
+// byte.
+class RpcProtocol {
+public:
+    static constexpr size_t FRAME_HEADER_SIZE = 4;
+    static constexpr size_t REQUEST_ID_SIZE = 4;
+    static constexpr size_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+    enum class FrameStatus { Complete, Incomplete, TooLarge };
+
+    // Reads the payload length from a frame header; false if it exceeds MAX_FRAME_SIZE
+    static bool payloadLength(const char* header, size_t& length);
+    // Looks for one whole frame at the start of buffer
+    static FrameStatus nextFrame(std::string_view buffer, std::string_view& payload, size_t& frameSize);
+
+    // Stamps the request ID into a finished request frame
+    static void setRequestId(std::string& frame, uint32_t requestId);
+
+    static void encodeResponse(uint32_t requestId, const ServiceResponse& response, std::string& out);
+    static bool decodeResponse(std::string_view payload, uint32_t& requestId, ServiceResponse& response);
+};
+
+// Builds one frame. The length prefix is filled in by finish(); a request
+// frame leaves room for the ID that RpcProtocol::setRequestId() stamps.
+class RpcWriter {
+public:
+    RpcWriter();
+    explicit RpcWriter(RpcOp op);
+
+    RpcWriter& add(int32_t value);
+    RpcWriter& add(uint32_t value);
+    RpcWriter& add(bool value);
+    RpcWriter& add(std::string_view value);
+    RpcWriter& add(const char* value) { return add(std::string_view(value)); }
+
+    // Appends the finished frame to out
+    void finishInto(std::string& out);
+    const std::string& finish();
+
+private:
+    std::string frame;
+};
+
+// Reads the fields of one payload; every read fails once the payload is exhausted
+class RpcReader {
+public:
+    explicit RpcReader(std::string_view payload);
+
+    bool read(RpcOp& op);
+    bool read(int32_t& value);
+    bool read(uint32_t& value);
+    bool read(bool& value);
+    bool read(std::string& value);
+    bool atEnd() const;
+
+private:
+    std::string_view payload;
+    size_t position;
+
+    bool take(size_t count, const char*& data);
+};
@@ -0,0 +1,415 @@
+#include "RpcServer.h"
+#include "RpcProtocol.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+#ifdef __linux__
+#define CLEARBALLOT_HAVE_EPOLL 1
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t MAX_IN_FLIGHT = 4096;                    // Per connection, with an executor
+const char SHARED_MEMORY_PREFIX[] = "/clearballot-";   // Only segments named by our clients are mapped
+
+bool isAttachRequest(std::string_view payload) {
+    return payload.size() > RpcProtocol::REQUEST_ID_SIZE &&
+           static_cast<RpcOp>(payload[RpcProtocol::REQUEST_ID_SIZE]) == RpcOp::AttachSharedMemory;
+}
+
+} // namespace
+
+RpcServer::RpcServer(ClearBallotService& service, WorkStealingExecutor* executor)
+    : service(service), dispatcher(service), executor(executor), listenFd(-1), epollFd(-1), wakeFd(-1),
+      completionFd(-1), nextConnectionId(1), tasksInFlight(0), linkThreads(0), running(false), connectionCount(0),
+      requestsServed(0) {}
+
+RpcServer::~RpcServer() {
+    stop();
+}
+
+bool RpcServer::isRunning() const {
+    return running.load();
+}
+
+const std::string& RpcServer::getSocketPath() const {
+    return socketPath;
+}
+
+size_t RpcServer::getConnectionCount() const {
+    return connectionCount.load();
+}
+
+uint64_t RpcServer::getRequestsServed() const {
+    return requestsServed.load();
+}
+
+#ifdef CLEARBALLOT_HAVE_EPOLL
+
+bool RpcServer::start(const std::string& path) {
+    if (running.load()) {
+        return true;
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cout << "[RPC ERROR] Socket path is empty or too long: " << path << "\n";
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    // A socket file nobody answers on is left over from a crashed service
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        bool inUse = ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        ::close(probe);
+        if (inUse) {
+            std::cout << "[RPC ERROR] Another service is already listening on " << path << "\n";
+            return false;
+        }
+    }
+    ::unlink(path.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    completionFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool ready = listenFd >= 0 && epollFd >= 0 && wakeFd >= 0 && completionFd >= 0 &&
+                 ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                 ::listen(listenFd, SOMAXCONN) == 0;
+    if (ready) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        ready = ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+        event.data.fd = wakeFd;
+        ready = ready && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0;
+        event.data.fd = completionFd;
+        ready = ready && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, completionFd, &event) == 0;
+    }
+    if (!ready) {
+        std::cout << "[RPC ERROR] Could not listen on " << path << ": " << std::strerror(errno) << "\n";
+        closeAll();
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    socketPath = path;
+    running.store(true);
+    loopThread = std::thread(&RpcServer::run, this);
+    std::cout << "[RPC] Listening on " << socketPath << "\n";
+    return true;
+}
+
+void RpcServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    uint64_t one = 1;
+    if (::write(wakeFd, &one, sizeof(one)) < 0) {
+        // The loop also notices running == false on its next wakeup
+    }
+    loopThread.join();
+    // Stop the ring readers, then let requests already with the executor finish
+    for (auto& entry : connections) {
+        detachSharedMemory(*entry.second);
+    }
+    waitForLinkThreads();
+    waitForTasks();
+    closeAll();
+    ::unlink(socketPath.c_str());
+    std::cout << "[RPC] Stopped listening on " << socketPath << "\n";
+}
+
+void RpcServer::run() {
+    ConnectionLoop::run(epollFd, running, "[RPC ERROR]", [this](int fd, uint32_t events) {
+        if (fd == wakeFd) {
+            return;
+        }
+        if (fd == completionFd) {
+            deliverCompletions();
+            return;
+        }
+        if (fd == listenFd) {
+            acceptConnections();
+            return;
+        }
+
+        auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        Connection& connection = *it->second;
+        bool keep = ConnectionLoop::dispatch(events, [&]() { return readRequests(connection); },
+                                             [&]() { return writeResponses(connection); });
+        if (!keep) {
+            closeConnection(fd);
+        }
+    });
+}
+
+void RpcServer::acceptConnections() {
+    ConnectionLoop::acceptAll(listenFd, epollFd, [this](int fd) {
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->id = nextConnectionId++;
+        connection->interest = EPOLLIN;
+        connections[fd] = std::move(connection);
+        ++connectionCount;
+    });
+}
+
+bool RpcServer::readRequests(Connection& connection) {
+    ConnectionLoop::ReadStatus read = ConnectionLoop::readAvailable(connection);
+    if (read == ConnectionLoop::ReadStatus::Failed) {
+        return false;
+    }
+
+    size_t consumed = 0;
+    while (true) {
+        std::string_view payload;
+        size_t frameSize = 0;
+        std::string_view pending = std::string_view(connection.input).substr(consumed);
+        RpcProtocol::FrameStatus status = RpcProtocol::nextFrame(pending, payload, frameSize);
+        if (status == RpcProtocol::FrameStatus::TooLarge) {
+            return false;
+        }
+        if (status == RpcProtocol::FrameStatus::Incomplete) {
+            break;
+        }
+        if (isAttachRequest(payload)) {
+            attachSharedMemory(connection, payload);
+        } else if (executor) {
+            int fd = connection.fd;
+            uint64_t id = connection.id;
+            ++connection.inFlight;
+            submit(payload, [this, fd, id](std::string& frame) {
+                bool first;
+                {
+                    std::lock_guard<std::mutex> lock(completionMutex);
+                    first = completions.empty();
+                    completions.push_back(Completion{fd, id, std::move(frame)});
+                }
+                uint64_t one = 1;
+                if (first && ::write(completionFd, &one, sizeof(one)) < 0) {
+                    // Already signalled; the loop drains every completion at once
+                }
+            });
+        } else {
+            dispatcher.handle(payload, connection.output);
+            ++requestsServed;
+        }
+        consumed += frameSize;
+    }
+    connection.input.erase(0, consumed);
+
+    return writeResponses(connection) && read != ConnectionLoop::ReadStatus::PeerClosed;
+}
+
+bool RpcServer::writeResponses(Connection& connection) {
+    // Also stop reading while too many requests are still with the executor
+    return ConnectionLoop::writeQueued(connection) &&
+           ConnectionLoop::updateInterest(epollFd, connection, connection.inFlight < MAX_IN_FLIGHT);
+}
+
+void RpcServer::submit(std::string_view payload, std::function<void(std::string&)> reply) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        ++tasksInFlight;
+    }
+    WorkStealingExecutor::Task work = [this, request = std::string(payload), reply = std::move(reply)]() {
+        std::string frame;
+        dispatcher.handle(request, frame);
+        ++requestsServed;
+        reply(frame);
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        if (--tasksInFlight == 0) {
+            tasksDone.notify_all();
+        }
+    };
+    if (!executor->submit(RpcDispatcher::affinityKey(payload), work)) {
+        work();   // The executor is shutting down
+    }
+}
+
+void RpcServer::waitForTasks() {
+    std::unique_lock<std::mutex> lock(tasksMutex);
+    tasksDone.wait(lock, [this]() { return tasksInFlight == 0; });
+}
+
+void RpcServer::deliverCompletions() {
+    uint64_t signalled = 0;
+    if (::read(completionFd, &signalled, sizeof(signalled)) < 0) {
+        // Spurious wakeup; nothing to drain
+    }
+    std::vector<Completion> finished;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        finished.swap(completions);
+    }
+
+    std::vector<int> touched;
+    for (auto& completion : finished) {
+        auto it = connections.find(completion.fd);
+        if (it == connections.end() || it->second->id != completion.connectionId) {
+            continue;   // The client went away before its answer was ready
+        }
+        it->second->output += completion.frame;
+        --it->second->inFlight;
+        touched.push_back(completion.fd);
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (int fd : touched) {
+        if (!writeResponses(*connections[fd])) {
+            closeConnection(fd);
+        }
+    }
+}
+
+void RpcServer::attachSharedMemory(Connection& connection, std::string_view payload) {
+    RpcReader reader(payload);
+    uint32_t requestId = 0;
+    RpcOp op;
+    std::string name;
+    ServiceResponse response(false, "[SERVICE ERROR] Could not attach shared memory.");
+    if (reader.read(requestId) && reader.read(op) && reader.read(name) && reader.atEnd() && !connection.link &&
+        name.compare(0, sizeof(SHARED_MEMORY_PREFIX) - 1, SHARED_MEMORY_PREFIX) == 0) {
+        std::unique_ptr<SharedMemoryLink> link = SharedMemoryLink::open(name);
+        if (link) {
+            connection.link = std::make_shared<LinkSession>();
+            connection.link->link = std::move(link);
+            {
+                std::lock_guard<std::mutex> lock(linkThreadsMutex);
+                ++linkThreads;
+            }
+            std::thread(&RpcServer::serveSharedMemory, this, connection.link).detach();
+            response = ServiceResponse(true, "Shared memory attached.");
+        }
+    }
+    RpcProtocol::encodeResponse(requestId, response, connection.output);
+}
+
+void RpcServer::serveSharedMemory(std::shared_ptr<LinkSession> session) {
+    SharedMemoryLink& link = *session->link;
+    std::string payload;
+    std::string output;
+    while (true) {
+        char header[RpcProtocol::FRAME_HEADER_SIZE];
+        size_t length = 0;
+        if (!link.requests().read(header, sizeof(header)) || !RpcProtocol::payloadLength(header, length)) {
+            break;
+        }
+        payload.resize(length);
+        if (!link.requests().read(&payload[0], length)) {
+            break;
+        }
+        if (executor) {
+            // Bounded like a socket connection; the ring fills up and the client waits
+            std::unique_lock<std::mutex> lock(session->responseMutex);
+            session->drained.wait(lock, [&]() {
+                return session->inFlight < MAX_IN_FLIGHT || link.responses().isClosed();
+            });
+            ++session->inFlight;
+            lock.unlock();
+            submit(payload, [session](std::string& frame) {
+                std::lock_guard<std::mutex> lock(session->responseMutex);
+                if (!session->link->responses().write(frame.data(), frame.size())) {
+                    session->link->close();
+                }
+                --session->inFlight;
+                session->drained.notify_one();
+            });
+            continue;
+        }
+        output.clear();
+        dispatcher.handle(payload, output);
+        ++requestsServed;
+        if (!link.responses().write(output.data(), output.size())) {
+            break;
+        }
+    }
+    link.close();
+    session.reset();
+
+    // stop() waits for every reader; it is only woken once this thread is done with the server
+    std::unique_lock<std::mutex> lock(linkThreadsMutex);
+    --linkThreads;
+    std::notify_all_at_thread_exit(linkThreadsDone, std::move(lock));
+}
+
+void RpcServer::waitForLinkThreads() {
+    std::unique_lock<std::mutex> lock(linkThreadsMutex);
+    linkThreadsDone.wait(lock, [this]() { return linkThreads == 0; });
+}
+
+void RpcServer::detachSharedMemory(Connection& connection) {
+    if (connection.link) {
+        // Not under responseMutex: a worker may hold it while blocked on the full ring
+        connection.link->link->close();
+        {
+            std::lock_guard<std::mutex> lock(connection.link->responseMutex);
+        }
+        connection.link->drained.notify_all();
+        connection.link.reset();
+    }
+}
+
+void RpcServer::closeConnection(int fd) {
+    ConnectionLoop::close(epollFd, fd);
+    auto it = connections.find(fd);
+    if (it != connections.end()) {
+        detachSharedMemory(*it->second);
+        connections.erase(it);
+        --connectionCount;
+    }
+}
+
+void RpcServer::closeAll() {
+    for (const auto& entry : connections) {
+        detachSharedMemory(*entry.second);
+        ::close(entry.first);
+    }
+    connections.clear();
+    connectionCount.store(0);
+    for (int* fd : {&listenFd, &epollFd, &wakeFd, &completionFd}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+#else
+
+bool RpcServer::start(const std::string& path) {
+    std::cout << "[RPC ERROR] The socket server is only available on Linux (requested " << path << ").\n";
+    return false;
+}
+
+void RpcServer::stop() {}
+void RpcServer::run() {}
+void RpcServer::acceptConnections() {}
+bool RpcServer::readRequests(Connection&) { return false; }
+bool RpcServer::writeResponses(Connection&) { return false; }
+void RpcServer::attachSharedMemory(Connection&, std::string_view) {}
+void RpcServer::submit(std::string_view, std::function<void(std::string&)>) {}
+void RpcServer::deliverCompletions() {}
+void RpcServer::waitForTasks() {}
+void RpcServer::serveSharedMemory(std::shared_ptr<LinkSession>) {}
+void RpcServer::detachSharedMemory(Connection&) {}
+void RpcServer::waitForLinkThreads() {}
+void RpcServer::closeConnection(int) {}
+void RpcServer::closeAll() {}
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+#include "ConnectionLoop.h"
+#include "RpcDispatcher.h"
+#include "SharedMemoryRing.h"
+#include "WorkStealingExecutor.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Serves a ClearBallotService to other processes over a Unix domain socket.
+// One event-loop thread multiplexes every connection with epoll: sockets are
+// non-blocking, partial frames are buffered per connection and responses are
+// written back as the socket accepts them. Without an executor every request
+// runs on the loop thread in arrival order, and one whose admission lane is
+// saturated is refused with a retry hint rather than queued. With one, each request goes to
+// its election's home worker and is answered when it finishes, so responses
+// on one connection may come back out of order; clients match them by
+// request ID. A client on the same host may move its traffic onto a
+// shared-memory link (RpcOp::AttachSharedMemory); the connection then gets a
+// dedicated thread reading its request ring, and the socket only tells the
+// server when the client is gone. Linux only; start() fails elsewhere.
+class RpcServer {
+public:
+    static constexpr const char* DEFAULT_SOCKET_PATH = "/tmp/clearballot.sock";
+
+    // The executor, if any, must outlive the server
+    explicit RpcServer(ClearBallotService& service, WorkStealingExecutor* executor = nullptr);
+    ~RpcServer();
+
+    RpcServer(const RpcServer&) = delete;
+    RpcServer& operator=(const RpcServer&) = delete;
+
+    // Binds the socket (replacing a stale one) and starts the event loop
+    bool start(const std::string& socketPath = DEFAULT_SOCKET_PATH);
+    // Closes every connection and removes the socket file
+    void stop();
+
+    bool isRunning() const;
+    const std::string& getSocketPath() const;
+    size_t getConnectionCount() const;
+    uint64_t getRequestsServed() const;
+
+private:
+    // Shared with executor tasks, which may finish after the connection closed
+    struct LinkSession {
+        std::unique_ptr<SharedMemoryLink> link;
+        std::mutex responseMutex;          // Workers take turns on the response ring
+        std::condition_variable drained;
+        size_t inFlight = 0;               // Guarded by responseMutex
+    };
+
+    struct Connection : StreamConnection {
+        uint64_t id = 0;          // Tells a reused fd apart from the connection a response was for
+        size_t inFlight = 0;      // Requests handed to the executor
+        std::shared_ptr<LinkSession> link;   // Its ring reader runs detached and exits once it is closed
+    };
+
+    struct Completion {
+        int fd;
+        uint64_t connectionId;
+        std::string frame;
+    };
+
+    ClearBallotService& service;
+    RpcDispatcher dispatcher;
+    WorkStealingExecutor* executor;
+    std::string socketPath;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    int completionFd;          // Workers signal finished socket requests
+    uint64_t nextConnectionId;
+    std::mutex completionMutex;
+    std::vector<Completion> completions;
+    std::mutex tasksMutex;
+    std::condition_variable tasksDone;
+    size_t tasksInFlight;      // Guarded by tasksMutex
+    std::mutex linkThreadsMutex;
+    std::condition_variable linkThreadsDone;
+    size_t linkThreads;        // Ring readers still running, guarded by linkThreadsMutex
+    std::thread loopThread;
+    std::atomic<bool> running;
+    std::atomic<size_t> connectionCount;
+    std::atomic<uint64_t> requestsServed;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;  // Event-loop thread only
+
+    void run();
+    void acceptConnections();
+    bool readRequests(Connection& connection);
+    bool writeResponses(Connection& connection);
+    void submit(std::string_view payload, std::function<void(std::string&)> reply);
+    void deliverCompletions();
+    void waitForTasks();
+    void attachSharedMemory(Connection& connection, std::string_view payload);
+    void serveSharedMemory(std::shared_ptr<LinkSession> session);
+    // Closes the link without waiting for its reader, which may be in the middle
+    // of a long request; the event loop must not stall on it
+    static void detachSharedMemory(Connection& connection);
+    void waitForLinkThreads();
+    void closeConnection(int fd);
+    void closeAll();
+};
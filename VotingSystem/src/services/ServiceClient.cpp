@@ -39,12 +39,45 @@ bool ServiceClient::connectToService() {
     }
 }
 
+bool ServiceClient::connectToService(const std::string& socketPath, Transport transport) {
+    if (connected) {
+        std::cout << "[CLIENT] Already connected to ClearBallot service.\n";
+        return true;
+    }
+    
+    channel = std::make_unique<RpcChannel>();
+    if (!channel->connect(socketPath)) {
+        std::cout << "[CLIENT ERROR] ClearBallot service is not reachable at " << socketPath << ".\n";
+        channel.reset();
+        return false;
+    }
+    
+    bool sharedMemory = transport == Transport::SharedMemory && channel->attachSharedMemory();
+    if (transport == Transport::SharedMemory && !sharedMemory) {
+        std::cout << "[CLIENT] Shared memory unavailable; using the socket.\n";
+    }
+    
+    connected = true;
+    std::cout << "[CLIENT] Connected to ClearBallot service at " << socketPath
+              << (sharedMemory ? " (shared memory)" : "") << ".\n";
+    ensureDefaultElection();
+    return true;
+}
+
 bool ServiceClient::isConnected() const {
+    if (channel) {
+        return connected && channel->isOpen();
+    }
     return connected && service && service->isRunning();
 }
 
 void ServiceClient::disconnect() {
-    if (service && connected) {
+    if (channel) {
+        // The remote service keeps running for its other clients
+        channel->close();
+        channel.reset();
+        std::cout << "[CLIENT] Disconnected from ClearBallot service.\n";
+    } else if (service && connected) {
         service->stopService();
         std::cout << "[CLIENT] Disconnected from ClearBallot service.\n";
     }
@@ -61,6 +94,10 @@ int ServiceClient::createElection(const std::string& title) {
         return -1;
     }
     
+    if (channel) {
+        ServiceResponse response = callRemote(RpcWriter(RpcOp::CreateElection).add(title));
+        return response.success && !response.data.empty() ? std::stoi(response.data[0]) : -1;
+    }
     return service->createElection(title);
 }
 
@@ -69,6 +106,9 @@ bool ServiceClient::electionExists(int electionId) {
         return false;
     }
     
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::ElectionExists).add(electionId)).success;
+    }
     return service->electionExists(electionId);
 }
 
@@ -84,6 +124,10 @@ ServiceResponse ServiceClient::registerVoter(int electionId, const std::string&
     // Use default election if electionId is -1
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
     
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::RegisterVoter).add(targetElectionId).add(firstName).add(lastName)
+                              .add(phone).add(address).add(idStr).add(ageStr));
+    }
     VoterRegistrationData voterData(firstName, lastName, phone, address, idStr, ageStr);
     return service->registerVoter(targetElectionId, voterData);
 }
@@ -94,6 +138,9 @@ ServiceResponse ServiceClient::castVote(int electionId, int voterId, int candida
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::CastVote).add(targetElectionId).add(voterId).add(candidateIndex));
+    }
     return service->castVote(targetElectionId, voterId, candidateIndex);
 }
 
@@ -103,6 +150,9 @@ ServiceResponse ServiceClient::getCandidates(int electionId) {
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetCandidates).add(targetElectionId));
+    }
     return service->getCandidates(targetElectionId);
 }
 
@@ -112,6 +162,9 @@ ServiceResponse ServiceClient::getVoters(int electionId) {
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetVoters).add(targetElectionId));
+    }
     return service->getVoters(targetElectionId);
 }
 
@@ -121,6 +174,9 @@ ServiceResponse ServiceClient::getElectionResults(int electionId) {
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetElectionResults).add(targetElectionId));
+    }
     return service->getElectionResults(targetElectionId);
 }
 
@@ -130,9 +186,83 @@ ServiceResponse ServiceClient::checkVoterRegistration(int electionId, int voterI
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::CheckVoterRegistration).add(targetElectionId).add(voterId));
+    }
     return service->checkVoterRegistration(targetElectionId, voterId);
 }
 
+// Asynchronous voter operations
+std::future<ServiceResponse> ServiceClient::castVoteAsync(int electionId, int voterId, int candidateIndex) {
+    if (!isConnected()) {
+        return readyResponse(createErrorResponse("Not connected to service."));
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return channel->callAsync(RpcWriter(RpcOp::CastVote).add(targetElectionId).add(voterId)
+                                      .add(candidateIndex).finish());
+    }
+    return readyResponse(service->castVote(targetElectionId, voterId, candidateIndex));
+}
+
+void ServiceClient::castVoteAsync(int electionId, int voterId, int candidateIndex, ResponseCallback done) {
+    if (!isConnected()) {
+        done(createErrorResponse("Not connected to service."));
+        return;
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        channel->callAsync(RpcWriter(RpcOp::CastVote).add(targetElectionId).add(voterId)
+                               .add(candidateIndex).finish(), std::move(done));
+        return;
+    }
+    done(service->castVote(targetElectionId, voterId, candidateIndex));
+}
+
+std::future<ServiceResponse> ServiceClient::registerVoterAsync(int electionId, const std::string& firstName,
+                                                               const std::string& lastName, const std::string& phone,
+                                                               const std::string& address, const std::string& idStr,
+                                                               const std::string& ageStr) {
+    if (!isConnected()) {
+        return readyResponse(createErrorResponse("Not connected to service."));
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return channel->callAsync(RpcWriter(RpcOp::RegisterVoter).add(targetElectionId).add(firstName)
+                                      .add(lastName).add(phone).add(address).add(idStr).add(ageStr).finish());
+    }
+    VoterRegistrationData voterData(firstName, lastName, phone, address, idStr, ageStr);
+    return readyResponse(service->registerVoter(targetElectionId, voterData));
+}
+
+std::future<ServiceResponse> ServiceClient::checkVoterRegistrationAsync(int electionId, int voterId) {
+    if (!isConnected()) {
+        return readyResponse(createErrorResponse("Not connected to service."));
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return channel->callAsync(RpcWriter(RpcOp::CheckVoterRegistration).add(targetElectionId)
+                                      .add(voterId).finish());
+    }
+    return readyResponse(service->checkVoterRegistration(targetElectionId, voterId));
+}
+
+std::future<ServiceResponse> ServiceClient::getElectionResultsAsync(int electionId) {
+    if (!isConnected()) {
+        return readyResponse(createErrorResponse("Not connected to service."));
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return channel->callAsync(RpcWriter(RpcOp::GetElectionResults).add(targetElectionId).finish());
+    }
+    return readyResponse(service->getElectionResults(targetElectionId));
+}
+
 // Admin operations
 ServiceResponse ServiceClient::addCandidate(int electionId, const std::string& name) {
     if (!isConnected()) {
@@ -140,6 +270,9 @@ ServiceResponse ServiceClient::addCandidate(int electionId, const std::string& n
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::AddCandidate).add(targetElectionId).add(name));
+    }
     return service->addCandidate(targetElectionId, name);
 }
 
@@ -150,6 +283,9 @@ ServiceResponse ServiceClient::addCandidateWithParty(int electionId, const std::
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::AddCandidateWithParty).add(targetElectionId).add(name).add(partyName));
+    }
     return service->addCandidateWithParty(targetElectionId, name, partyName);
 }
 
@@ -159,6 +295,9 @@ ServiceResponse ServiceClient::createParty(int electionId, const std::string& pa
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::CreateParty).add(targetElectionId).add(partyName));
+    }
     return service->createParty(targetElectionId, partyName);
 }
 
@@ -168,9 +307,24 @@ ServiceResponse ServiceClient::getParties(int electionId) {
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetParties).add(targetElectionId));
+    }
     return service->getParties(targetElectionId);
 }
 
+ServiceResponse ServiceClient::setValidationRules(int electionId, const std::string& rulesName) {
+    if (!isConnected()) {
+        return createErrorResponse("Not connected to service.");
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::SetValidationRules).add(targetElectionId).add(rulesName));
+    }
+    return service->setValidationRules(targetElectionId, rulesName);
+}
+
 // Data persistence operations
 ServiceResponse ServiceClient::saveElectionResults(int electionId, const std::string& filename) {
     if (!isConnected()) {
@@ -178,6 +332,9 @@ ServiceResponse ServiceClient::saveElectionResults(int electionId, const std::st
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::SaveElectionResults).add(targetElectionId).add(filename));
+    }
     return service->saveElectionResults(targetElectionId, filename);
 }
 
@@ -187,6 +344,9 @@ ServiceResponse ServiceClient::saveCompleteElectionData(int electionId, const st
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::SaveCompleteElectionData).add(targetElectionId).add(filename));
+    }
     return service->saveCompleteElectionData(targetElectionId, filename);
 }
 
@@ -196,16 +356,75 @@ ServiceResponse ServiceClient::loadElectionData(int electionId, const std::strin
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::LoadElectionData).add(targetElectionId).add(filename));
+    }
     return service->loadElectionData(targetElectionId, filename);
 }
 
-ServiceResponse ServiceClient::exportElectionToCSV(int electionId, const std::string& baseFilename) {
+ServiceResponse ServiceClient::exportElectionToCSV(int electionId, const std::string& baseFilename,
+                                                  bool compressed) {
     if (!isConnected()) {
         return createErrorResponse("Not connected to service.");
     }
     
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
-    return service->exportElectionToCSV(targetElectionId, baseFilename);
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::ExportElectionToCSV).add(targetElectionId).add(baseFilename).add(compressed));
+    }
+    return service->exportElectionToCSV(targetElectionId, baseFilename, compressed);
+}
+
+ServiceResponse ServiceClient::importVotersFromCSV(int electionId, const std::string& filename) {
+    if (!isConnected()) {
+        return createErrorResponse("Not connected to service.");
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::ImportVotersFromCSV).add(targetElectionId).add(filename));
+    }
+    return service->importVotersFromCSV(targetElectionId, filename);
+}
+
+// Background jobs
+ServiceResponse ServiceClient::startBulkJob(int electionId, BulkOperation operation, const std::string& filename,
+                                           bool compressed) {
+    if (!isConnected()) {
+        return createErrorResponse("Not connected to service.");
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::StartBulkJob).add(targetElectionId).add(static_cast<int>(operation))
+                              .add(filename).add(compressed));
+    }
+    return service->startBulkJob(targetElectionId, operation, filename, compressed);
+}
+
+ServiceResponse ServiceClient::getJobStatus(int electionId, int jobId) {
+    if (!isConnected()) {
+        return createErrorResponse("Not connected to service.");
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetJobStatus).add(targetElectionId).add(jobId));
+    }
+    return service->getJobStatus(targetElectionId, jobId);
+}
+
+// Capacity reporting
+ServiceResponse ServiceClient::getMemoryUsage(int electionId) {
+    if (!isConnected()) {
+        return createErrorResponse("Not connected to service.");
+    }
+    
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetMemoryUsage).add(targetElectionId));
+    }
+    return service->getMemoryUsage(targetElectionId);
 }
 
 // Direct Election access (for compatibility)
@@ -214,6 +433,9 @@ std::shared_ptr<Election> ServiceClient::getElection(int electionId) {
         return nullptr;
     }
     
+    if (channel) {
+        return nullptr;  // Elections live in the service process
+    }
     int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
     return service->getElection(targetElectionId);
 }
@@ -221,137 +443,53 @@ std::shared_ptr<Election> ServiceClient::getElection(int electionId) {
 // Regional operations
 ServiceResponse ServiceClient::createRegion(int electionId, const std::string& name, const std::string& code) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->createRegion(name, code);
-        if (region) {
-            return ServiceResponse(true, "Region '" + name + "' created successfully");
-        } else {
-            return createErrorResponse("Failed to create region (name: '" + name + "', code: '" + code + "')");
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "[SERVER ERROR] Exception in createRegion: " << e.what() << std::endl;
-        return createErrorResponse("An internal error occurred while creating the region.");
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::CreateRegion).add(targetElectionId).add(name).add(code));
     }
+    return service->createRegion(targetElectionId, name, code);
 }
 
 ServiceResponse ServiceClient::getRegions(int electionId) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        // This would display regions - for now just return success
-        election->displayRegions();
-        return ServiceResponse(true, "Regions retrieved successfully");
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in getRegions: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetRegions).add(targetElectionId));
     }
+    return service->getRegions(targetElectionId);
 }
 
 ServiceResponse ServiceClient::addCandidateToRegion(int electionId, const std::string& name, 
                                                    const std::string& regionCode) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->getRegionByCode(regionCode);
-        if (!region) {
-            return createErrorResponse("Region not found: " + regionCode);
-        }
-        
-        bool result = election->addCandidateToRegion(name, region);
-        if (result) {
-            return ServiceResponse(true, "Candidate '" + name + "' added to region '" + regionCode + "'");
-        } else {
-            return createErrorResponse("Failed to add candidate to region");
-        }
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in addCandidateToRegion: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::AddCandidateToRegion).add(targetElectionId).add(name).add(regionCode));
     }
+    return service->addCandidateToRegion(targetElectionId, name, regionCode);
 }
 
 ServiceResponse ServiceClient::addCandidateToRegion(int electionId, const std::string& name,
                                                    const std::string& partyName, const std::string& regionCode) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->getRegionByCode(regionCode);
-        if (!region) {
-            return createErrorResponse("Region not found: " + regionCode);
-        }
-        
-        // Find party by name - iterate through party indices since direct access not available
-        std::shared_ptr<Party> party = nullptr;
-        
-        // First try to find an existing party by checking each index
-        for (size_t i = 1; i <= 100; ++i) { // Reasonable upper limit
-            auto testParty = election->getPartyByIndex(i);
-            if (!testParty) break; // No more parties
-            if (testParty->getName() == partyName) {
-                party = testParty;
-                break;
-            }
-        }
-        
-        if (!party) {
-            // Try to create the party if it doesn't exist
-            party = election->createParty(partyName);
-            if (!party) {
-                return createErrorResponse("Party not found and could not be created: " + partyName);
-            }
-        }
-        
-        bool result = election->addCandidateToRegion(name, party, region);
-        if (result) {
-            return ServiceResponse(true, "Candidate '" + name + "' added to region '" + regionCode + "' with party '" + partyName + "'");
-        } else {
-            return createErrorResponse("Failed to add candidate to region");
-        }
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in addCandidateToRegion: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::AddPartyCandidateToRegion).add(targetElectionId).add(name)
+                              .add(partyName).add(regionCode));
     }
+    return service->addCandidateToRegion(targetElectionId, name, partyName, regionCode);
 }
 
 ServiceResponse ServiceClient::registerVoterInRegion(int electionId, const std::string& firstName,
@@ -359,93 +497,42 @@ ServiceResponse ServiceClient::registerVoterInRegion(int electionId, const std::
                                                     const std::string& address, const std::string& idStr,
                                                     const std::string& ageStr, const std::string& regionCode) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->getRegionByCode(regionCode);
-        if (!region) {
-            return createErrorResponse("Region not found: " + regionCode);
-        }
-        
-        bool result = election->registerVoterInRegion(firstName, lastName, phone, address, idStr, ageStr, region);
-        if (result) {
-            return ServiceResponse(true, "Voter '" + firstName + " " + lastName + "' registered in region '" + regionCode + "'");
-        } else {
-            return createErrorResponse("Failed to register voter in region");
-        }
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in registerVoterInRegion: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::RegisterVoterInRegion).add(targetElectionId).add(firstName).add(lastName)
+                              .add(phone).add(address).add(idStr).add(ageStr).add(regionCode));
     }
+    VoterRegistrationData voterData(firstName, lastName, phone, address, idStr, ageStr);
+    return service->registerVoterInRegion(targetElectionId, voterData, regionCode);
 }
 
 ServiceResponse ServiceClient::castVoteInRegion(int electionId, int voterId, int candidateIndex,
                                                const std::string& regionCode) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->getRegionByCode(regionCode);
-        if (!region) {
-            return createErrorResponse("Region not found: " + regionCode);
-        }
-        
-        bool result = election->castVoteInRegion(voterId, candidateIndex, region);
-        if (result) {
-            return ServiceResponse(true, "Vote cast successfully in region '" + regionCode + "'");
-        } else {
-            return createErrorResponse("Failed to cast vote in region");
-        }
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in castVoteInRegion: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::CastVoteInRegion).add(targetElectionId).add(voterId)
+                              .add(candidateIndex).add(regionCode));
     }
+    return service->castVoteInRegion(targetElectionId, voterId, candidateIndex, regionCode);
 }
 
 ServiceResponse ServiceClient::getRegionalResults(int electionId, const std::string& regionCode) {
     if (!isConnected()) {
-        return createErrorResponse("Not connected to service");
-    }
-    
-    if (electionId == -1) {
-        electionId = defaultElectionId;
+        return createErrorResponse("Not connected to service.");
     }
     
-    try {
-        auto election = service->getElection(electionId);
-        if (!election) {
-            return createErrorResponse("Election not found");
-        }
-        
-        auto region = election->getRegionByCode(regionCode);
-        if (!region) {
-            return createErrorResponse("Region not found: " + regionCode);
-        }
-        
-        // Display regional results
-        election->displayResultsInRegion(region);
-        return ServiceResponse(true, "Regional results retrieved for '" + regionCode + "'");
-    } catch (const std::exception& e) {
-        return createErrorResponse("Exception in getRegionalResults: " + std::string(e.what()));
+    int targetElectionId = (electionId == -1) ? defaultElectionId : electionId;
+    if (channel) {
+        return callRemote(RpcWriter(RpcOp::GetRegionalResults).add(targetElectionId).add(regionCode));
     }
+    return service->getRegionalResults(targetElectionId, regionCode);
 }
 
 // Helper methods
@@ -462,24 +549,30 @@ bool ServiceClient::ensureDefaultElection() {
         return false;
     }
     
-    // Create a default election for backward compatibility with existing console apps
-    defaultElectionId = service->createElection("2024 Local Elections");
+    // All console apps sharing a service work on the same seeded election
+    if (channel) {
+        RpcWriter request(RpcOp::GetDefaultElection);
+        ServiceResponse response = callRemote(request);
+        defaultElectionId = response.success && !response.data.empty() ? std::stoi(response.data[0]) : -1;
+    } else {
+        defaultElectionId = service->getDefaultElection();
+    }
     
     if (defaultElectionId > 0) {
-        std::cout << "[CLIENT] Created default election with ID: " << defaultElectionId << "\n";
-        
-        // Set up default parties and candidates for compatibility
-        service->createParty(defaultElectionId, "Democratic Party");
-        service->createParty(defaultElectionId, "Republican Party");
-        service->createParty(defaultElectionId, "Green Party");
-        
-        service->addCandidateWithParty(defaultElectionId, "Alice Johnson", "Democratic Party");
-        service->addCandidateWithParty(defaultElectionId, "Bob Smith", "Republican Party");
-        service->addCandidateWithParty(defaultElectionId, "Carol Green", "Green Party");
-        service->addCandidate(defaultElectionId, "David Independent");
-        
+        std::cout << "[CLIENT] Using default election with ID: " << defaultElectionId << "\n";
         return true;
     }
     
+    defaultElectionId = -1;
     return false;
 }
+
+ServiceResponse ServiceClient::callRemote(RpcWriter& request) {
+    return channel->call(request.finish());
+}
+
+std::future<ServiceResponse> ServiceClient::readyResponse(const ServiceResponse& response) {
+    std::promise<ServiceResponse> promise;
+    promise.set_value(response);
+    return promise.get_future();
+}
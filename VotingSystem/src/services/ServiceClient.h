@@ -1,16 +1,26 @@
 #pragma once
 #include "ClearBallotService.h"
+#include "RpcChannel.h"
+#include "RpcProtocol.h"
+#include <future>
 #include <memory>
 #include <string>
 
-// Client interface for communicating with ClearBallotService
+// Client interface for communicating with ClearBallotService. It either hosts
+// a private in-process service (connectToService()) or talks to a standalone
+// service over its Unix socket (connectToService(socketPath)).
 class ServiceClient {
 public:
     ServiceClient();
     ~ServiceClient();
     
     // Connection management
+    // Remote clients move their traffic onto shared memory by default, since
+    // the socket is always on the same host; they fall back to the socket if
+    // that fails
+    enum class Transport { Socket, SharedMemory };
     bool connectToService();
+    bool connectToService(const std::string& socketPath, Transport transport = Transport::SharedMemory);
     bool isConnected() const;
     void disconnect();
     
@@ -30,12 +40,28 @@ public:
     ServiceResponse getElectionResults(int electionId);
     ServiceResponse checkVoterRegistration(int electionId, int voterId);
     
+    // Asynchronous voter operations. Against a remote service the request is
+    // written immediately and any number may be in flight on the connection;
+    // in-process the call runs inline and the result is ready on return.
+    // Callbacks run on the connection's reader thread and must not call the
+    // synchronous methods of this client.
+    using ResponseCallback = RpcChannel::Callback;
+    std::future<ServiceResponse> castVoteAsync(int electionId, int voterId, int candidateIndex);
+    void castVoteAsync(int electionId, int voterId, int candidateIndex, ResponseCallback done);
+    std::future<ServiceResponse> registerVoterAsync(int electionId, const std::string& firstName,
+                                                    const std::string& lastName, const std::string& phone,
+                                                    const std::string& address, const std::string& idStr,
+                                                    const std::string& ageStr);
+    std::future<ServiceResponse> checkVoterRegistrationAsync(int electionId, int voterId);
+    std::future<ServiceResponse> getElectionResultsAsync(int electionId);
+    
     // Admin operations
     ServiceResponse addCandidate(int electionId, const std::string& name);
     ServiceResponse addCandidateWithParty(int electionId, const std::string& name,
                                          const std::string& partyName);
     ServiceResponse createParty(int electionId, const std::string& partyName);
     ServiceResponse getParties(int electionId);
+    ServiceResponse setValidationRules(int electionId, const std::string& rulesName);
     
     // Regional operations
     ServiceResponse createRegion(int electionId, const std::string& name, const std::string& code);
@@ -56,17 +82,31 @@ public:
     ServiceResponse saveElectionResults(int electionId, const std::string& filename);
     ServiceResponse saveCompleteElectionData(int electionId, const std::string& filename);
     ServiceResponse loadElectionData(int electionId, const std::string& filename);
-    ServiceResponse exportElectionToCSV(int electionId, const std::string& baseFilename);
+    ServiceResponse exportElectionToCSV(int electionId, const std::string& baseFilename,
+                                        bool compressed = false);
+    ServiceResponse importVotersFromCSV(int electionId, const std::string& filename);
+    
+    // Background jobs
+    ServiceResponse startBulkJob(int electionId, BulkOperation operation, const std::string& filename,
+                                 bool compressed = false);
+    ServiceResponse getJobStatus(int electionId, int jobId);
+    
+    // Capacity reporting
+    ServiceResponse getMemoryUsage(int electionId);
     
-    // Direct Election access (for compatibility with existing console interfaces)
+    // Direct Election access (for compatibility with existing console interfaces);
+    // always nullptr when connected to a remote service
     std::shared_ptr<Election> getElection(int electionId);
     
 private:
-    std::shared_ptr<ClearBallotService> service;  // For initial implementation (local service)
+    std::shared_ptr<ClearBallotService> service;  // In-process service
+    std::unique_ptr<RpcChannel> channel;          // Remote service; set instead of service
     bool connected;
     int defaultElectionId;  // For single-election console apps
     
     // Helper methods
     ServiceResponse createErrorResponse(const std::string& message) const;
     bool ensureDefaultElection();
+    ServiceResponse callRemote(RpcWriter& request);
+    static std::future<ServiceResponse> readyResponse(const ServiceResponse& response);
 };
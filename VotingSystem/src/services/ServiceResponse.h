@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Service response structure for client communication
+struct ServiceResponse {
+    bool success;
+    std::string message;
+    std::vector<std::string> data;
+    int retryAfterMs = 0;   // Set when refused for load: how long the caller should back off
+    
+    ServiceResponse(bool success = false, const std::string& message = "")
+        : success(success), message(message) {}
+};
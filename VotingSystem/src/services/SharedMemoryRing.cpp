@@ -0,0 +1,219 @@
+#include "SharedMemoryRing.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#define CLEARBALLOT_HAVE_FUTEX 1
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CLEARBALLOT_CPU_RELAX() _mm_pause()
+#else
+#define CLEARBALLOT_CPU_RELAX() std::atomic_signal_fence(std::memory_order_seq_cst)
+#endif
+
+namespace {
+
+const uint32_t SPIN_ITERATIONS = 4000;     // A few microseconds before sleeping
+const long SLEEP_SLICE_NANOS = 50000000;   // Re-check closed at least this often
+
+} // namespace
+
+static_assert((uint64_t(1) << 32) % SharedMemoryRing::CAPACITY == 0,
+              "Ring positions wrap at 2^32, so the capacity must divide it");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "Ring counters are shared between processes and must be lock-free");
+
+SharedMemoryRing::SharedMemoryRing(Shared& shared)
+    : shared(shared), spinLimit(std::thread::hardware_concurrency() > 1 ? SPIN_ITERATIONS : 0) {}
+
+bool SharedMemoryRing::isClosed() const {
+    return shared.closed.load() != 0;
+}
+
+void SharedMemoryRing::close() {
+    shared.closed.store(1);
+    wake(shared.head);
+    wake(shared.tail);
+}
+
+bool SharedMemoryRing::fail() {
+    close();
+    return false;
+}
+
+bool SharedMemoryRing::write(const char* data, size_t size) {
+    while (size > 0) {
+        uint32_t head = shared.head.load(std::memory_order_relaxed);
+        uint32_t tail = shared.tail.load(std::memory_order_acquire);
+        if (head - tail > CAPACITY) {
+            return fail();
+        }
+        uint32_t space = CAPACITY - (head - tail);
+        if (space == 0) {
+            if (!waitWhile(shared.tail, tail, shared.writerSleeping)) {
+                return false;
+            }
+            continue;
+        }
+        if (isClosed()) {
+            return false;
+        }
+
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(size, space));
+        uint32_t offset = head % CAPACITY;
+        uint32_t first = std::min(count, CAPACITY - offset);
+        std::memcpy(shared.data + offset, data, first);
+        std::memcpy(shared.data, data + first, count - first);
+        // Sequentially consistent so the store cannot pass the sleeping check
+        shared.head.store(head + count);
+        if (shared.readerSleeping.load()) {
+            wake(shared.head);
+        }
+        data += count;
+        size -= count;
+    }
+    return true;
+}
+
+bool SharedMemoryRing::read(char* data, size_t size) {
+    while (size > 0) {
+        uint32_t tail = shared.tail.load(std::memory_order_relaxed);
+        uint32_t head = shared.head.load(std::memory_order_acquire);
+        uint32_t available = head - tail;
+        if (available > CAPACITY) {
+            return fail();
+        }
+        if (available == 0) {
+            if (!waitWhile(shared.head, head, shared.readerSleeping)) {
+                return false;
+            }
+            continue;
+        }
+        if (isClosed()) {
+            return false;
+        }
+
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(size, available));
+        uint32_t offset = tail % CAPACITY;
+        uint32_t first = std::min(count, CAPACITY - offset);
+        std::memcpy(data, shared.data + offset, first);
+        std::memcpy(data + first, shared.data, count - first);
+        shared.tail.store(tail + count);
+        if (shared.writerSleeping.load()) {
+            wake(shared.tail);
+        }
+        data += count;
+        size -= count;
+    }
+    return true;
+}
+
+#ifdef CLEARBALLOT_HAVE_FUTEX
+
+bool SharedMemoryRing::waitWhile(std::atomic<uint32_t>& position, uint32_t observed,
+                                 std::atomic<uint32_t>& sleeping) {
+    for (uint32_t i = 0; i < spinLimit; ++i) {
+        if (position.load(std::memory_order_acquire) != observed || isClosed()) {
+            return !isClosed();
+        }
+        CLEARBALLOT_CPU_RELAX();
+    }
+
+    // Announce the sleep before the final check; the peer checks the flag after
+    // moving the position, so one of the two always sees the other
+    sleeping.store(1);
+    if (position.load() == observed && !isClosed()) {
+        timespec slice{0, SLEEP_SLICE_NANOS};
+        // Not FUTEX_PRIVATE_FLAG: the word is shared with another process
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&position), FUTEX_WAIT, observed, &slice, nullptr, 0);
+    }
+    sleeping.store(0);
+    return !isClosed();
+}
+
+void SharedMemoryRing::wake(std::atomic<uint32_t>& position) {
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&position), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+SharedMemoryLink::SharedMemoryLink(Segment* segment)
+    : segment(segment), requestRing(segment->requests), responseRing(segment->responses) {}
+
+SharedMemoryLink::~SharedMemoryLink() {
+    ::munmap(segment, sizeof(Segment));
+}
+
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::create(const std::string& name) {
+    return map(name, true);
+}
+
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::open(const std::string& name) {
+    return map(name, false);
+}
+
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::map(const std::string& name, bool create) {
+    int flags = create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR;
+    int fd = ::shm_open(name.c_str(), flags | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // A new segment is sized here and starts zeroed, which is two empty rings;
+    // an opened one must already be exactly the expected size
+    struct stat info;
+    bool sized = create ? ::ftruncate(fd, sizeof(Segment)) == 0
+                        : ::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) == sizeof(Segment);
+    void* memory = sized ? ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        if (create) {
+            ::shm_unlink(name.c_str());
+        }
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryLink>(new SharedMemoryLink(static_cast<Segment*>(memory)));
+}
+
+void SharedMemoryLink::unlink(const std::string& name) {
+    ::shm_unlink(name.c_str());
+}
+
+std::string SharedMemoryLink::uniqueName() {
+    static std::atomic<uint32_t> sequence{0};
+    return "/clearballot-" + std::to_string(::getpid()) + "-" + std::to_string(++sequence);
+}
+
+#else
+
+bool SharedMemoryRing::waitWhile(std::atomic<uint32_t>&, uint32_t, std::atomic<uint32_t>&) {
+    return false;
+}
+
+void SharedMemoryRing::wake(std::atomic<uint32_t>&) {}
+
+SharedMemoryLink::SharedMemoryLink(Segment* segment)
+    : segment(segment), requestRing(segment->requests), responseRing(segment->responses) {}
+
+SharedMemoryLink::~SharedMemoryLink() {}
+
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::create(const std::string&) { return nullptr; }
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::open(const std::string&) { return nullptr; }
+std::unique_ptr<SharedMemoryLink> SharedMemoryLink::map(const std::string&, bool) { return nullptr; }
+void SharedMemoryLink::unlink(const std::string&) {}
+std::string SharedMemoryLink::uniqueName() { return std::string(); }
+
+#endif
+
+void SharedMemoryLink::close() {
+    requestRing.close();
+    responseRing.close();
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Single-producer, single-consumer byte ring living in memory shared by two
+// processes. Positions are free-running uint32 counters (the capacity divides
+// 2^32), so the ring is empty when head == tail and full when they are
+// CAPACITY apart. A side with nothing to do spins briefly, then sleeps on a
+// futex on the counter it waits for; the other side only pays for the wake
+// syscall while someone is actually asleep. Either side may close the ring,
+// which fails all further reads and writes on both. The counters are writable
+// by the peer process, so positions more than CAPACITY apart are taken as a
+// corrupt ring: it is closed and the call fails rather than copying out of
+// bounds.
+class SharedMemoryRing {
+public:
+    static constexpr uint32_t CAPACITY = 256 * 1024;
+
+    // Layout inside the shared segment; all-zero bytes are a valid empty ring
+    struct Shared {
+        alignas(64) std::atomic<uint32_t> head;           // Bytes ever written; producer only
+        alignas(64) std::atomic<uint32_t> tail;           // Bytes ever read; consumer only
+        alignas(64) std::atomic<uint32_t> readerSleeping;
+        std::atomic<uint32_t> writerSleeping;
+        std::atomic<uint32_t> closed;
+        alignas(64) char data[CAPACITY];
+    };
+
+    explicit SharedMemoryRing(Shared& shared);
+
+    // Both block until every byte has moved, streaming through the ring in
+    // pieces if size exceeds CAPACITY; false once the ring is closed
+    bool write(const char* data, size_t size);
+    bool read(char* data, size_t size);
+    void close();
+    bool isClosed() const;
+
+private:
+    Shared& shared;
+    uint32_t spinLimit;   // 0 on a single core, where spinning only delays the peer
+
+    bool fail();   // Closes a ring whose positions cannot be trusted
+    bool waitWhile(std::atomic<uint32_t>& position, uint32_t observed, std::atomic<uint32_t>& sleeping);
+    static void wake(std::atomic<uint32_t>& position);
+};
+
+// A named POSIX shared-memory segment holding one request ring (client to
+// service) and one response ring (service to client). The client creates it,
+// the service opens it by name, and the client unlinks the name once both
+// sides have it mapped. Linux only; create() and open() return nullptr
+// elsewhere.
+class SharedMemoryLink {
+public:
+    ~SharedMemoryLink();
+
+    SharedMemoryLink(const SharedMemoryLink&) = delete;
+    SharedMemoryLink& operator=(const SharedMemoryLink&) = delete;
+
+    static std::unique_ptr<SharedMemoryLink> create(const std::string& name);
+    static std::unique_ptr<SharedMemoryLink> open(const std::string& name);
+    static void unlink(const std::string& name);
+    // A name unique to this process and call
+    static std::string uniqueName();
+
+    SharedMemoryRing& requests() { return requestRing; }
+    SharedMemoryRing& responses() { return responseRing; }
+    // Closes both rings, waking anything blocked on either side
+    void close();
+
+private:
+    struct Segment {
+        SharedMemoryRing::Shared requests;
+        SharedMemoryRing::Shared responses;
+    };
+
+    Segment* segment;
+    SharedMemoryRing requestRing;
+    SharedMemoryRing responseRing;
+
+    explicit SharedMemoryLink(Segment* segment);
+    static std::unique_ptr<SharedMemoryLink> map(const std::string& name, bool create);
+};
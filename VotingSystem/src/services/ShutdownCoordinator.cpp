@@ -0,0 +1,97 @@
+#include "ShutdownCoordinator.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// State shared with the workers. Workers may outlive run() when the deadline
+// passes, so everything they touch is reference counted.
+struct FlushState {
+    std::vector<ShutdownCoordinator::FlushTask> tasks;
+    std::atomic<size_t> nextTask{0};
+    std::atomic<bool> abandoned{false};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t finished = 0;
+    size_t succeeded = 0;
+};
+
+void flushWorker(std::shared_ptr<FlushState> state) {
+    while (!state->abandoned.load()) {
+        size_t index = state->nextTask.fetch_add(1);
+        if (index >= state->tasks.size()) {
+            return;
+        }
+
+        bool ok = false;
+        try {
+            ok = state->tasks[index].flush();
+        } catch (const std::exception& e) {
+            std::cout << "[SERVICE ERROR] Election " << state->tasks[index].electionId
+                      << " failed to flush: " << e.what() << "\n";
+        }
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        ++state->finished;
+        if (ok) {
+            ++state->succeeded;
+        }
+        state->done.notify_all();
+    }
+}
+
+} // namespace
+
+ShutdownCoordinator::ShutdownCoordinator(const Options& options) : options(options) {}
+
+const ShutdownCoordinator::Options& ShutdownCoordinator::getOptions() const {
+    return options;
+}
+
+size_t ShutdownCoordinator::resolveWorkerCount(size_t taskCount) const {
+    size_t workers = options.workerThreads;
+    if (workers == 0) {
+        workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    return std::min(workers, taskCount);
+}
+
+ShutdownCoordinator::Result ShutdownCoordinator::run(std::vector<FlushTask> tasks,
+                                                     std::chrono::steady_clock::time_point deadline) const {
+    Result result;
+    if (tasks.empty()) {
+        return result;
+    }
+
+    auto state = std::make_shared<FlushState>();
+    state->tasks = std::move(tasks);
+    const size_t total = state->tasks.size();
+
+    size_t workerCount = resolveWorkerCount(total);
+    for (size_t i = 0; i < workerCount; ++i) {
+        // Detached so that a flush stuck on slow storage cannot hold the
+        // process past its deadline.
+        std::thread(flushWorker, state).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    bool allDone = state->done.wait_until(lock, deadline, [&state, total]() {
+        return state->finished == total;
+    });
+
+    if (!allDone) {
+        state->abandoned.store(true);
+        result.deadlineExceeded = true;
+    }
+
+    result.completed = state->succeeded;
+    result.failed = state->finished - state->succeeded;
+    result.abandoned = total - state->finished;
+    return result;
+}
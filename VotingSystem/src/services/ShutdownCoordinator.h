@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Runs the per-election flush work of a service shutdown on a small thread pool.
+// Each flush is independent, so elections are persisted in parallel and the
+// whole shutdown is bounded by a configurable deadline.
+class ShutdownCoordinator {
+public:
+    struct Options {
+        size_t workerThreads = 4;                     // 0 = one per hardware thread
+        std::chrono::milliseconds deadline{30000};    // Upper bound for drain + flush
+        bool compressSnapshots = false;               // Write election_<id>_shutdown.txt.cblz
+    };
+
+    struct FlushTask {
+        int electionId;
+        std::function<bool()> flush;   // Returns false if the election could not be saved
+    };
+
+    struct Result {
+        size_t completed = 0;    // Flushes that finished successfully
+        size_t failed = 0;       // Flushes that finished but reported an error
+        size_t abandoned = 0;    // Flushes still queued or running at the deadline
+        bool deadlineExceeded = false;
+    };
+
+    explicit ShutdownCoordinator(const Options& options);
+
+    // Runs every task and waits until all have finished or the deadline passes.
+    // Tasks that have not started by the deadline are skipped; tasks that are
+    // mid-flight keep running on detached workers. The workers own the
+    // coordinator's state, but whatever a task itself touches must outlive
+    // them, so after an exceeded deadline the caller must not tear it down.
+    Result run(std::vector<FlushTask> tasks,
+               std::chrono::steady_clock::time_point deadline) const;
+
+    const Options& getOptions() const;
+
+private:
+    Options options;
+
+    size_t resolveWorkerCount(size_t taskCount) const;
+};
@@ -0,0 +1,83 @@
+#include "VoteBatcher.h"
+#include <algorithm>
+#include <exception>
+#include <string>
+
+VoteBatcher::VoteBatcher(size_t maxBatch)
+    : maxBatch(std::max<size_t>(1, maxBatch)), combining(false), batchCount(0), ballotCount(0), largestBatch(0) {}
+
+uint64_t VoteBatcher::getBatchCount() const {
+    return batchCount.load();
+}
+
+uint64_t VoteBatcher::getBallotCount() const {
+    return ballotCount.load();
+}
+
+size_t VoteBatcher::getLargestBatch() const {
+    return largestBatch.load();
+}
+
+ServiceResponse VoteBatcher::submit(int voterId, int candidateIndex, const ApplyBatch& apply) {
+    Slot slot;
+    slot.ballot.voterId = voterId;
+    slot.ballot.candidateIndex = candidateIndex;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.push_back(&slot);
+    if (combining) {
+        slot.wake.wait(lock, [&]() { return slot.state != SlotState::Queued; });
+        if (slot.state == SlotState::Done) {
+            return std::move(slot.ballot.response);
+        }
+        // Handed the combiner role with this ballot still queued
+    }
+    combining = true;
+    combine(slot, lock, apply);
+    return std::move(slot.ballot.response);
+}
+
+void VoteBatcher::combine(Slot& own, std::unique_lock<std::mutex>& lock, const ApplyBatch& apply) {
+    std::vector<Slot*> slots;
+    std::vector<Ballot*> batch;
+    while (own.state != SlotState::Done) {
+        slots.clear();
+        batch.clear();
+        while (!queue.empty() && slots.size() < maxBatch) {
+            slots.push_back(queue.front());
+            batch.push_back(&queue.front()->ballot);
+            queue.pop_front();
+        }
+
+        // New ballots queue up behind this batch while it is applied
+        lock.unlock();
+        try {
+            apply(batch);
+        } catch (const std::exception& e) {
+            for (Ballot* ballot : batch) {
+                ballot->response = ServiceResponse(false, std::string("[SERVICE ERROR] ") + e.what());
+            }
+        }
+        ++batchCount;
+        ballotCount += batch.size();
+        size_t largest = largestBatch.load();
+        while (batch.size() > largest && !largestBatch.compare_exchange_weak(largest, batch.size())) {
+        }
+        lock.lock();
+
+        for (Slot* slot : slots) {
+            slot->state = SlotState::Done;
+            if (slot != &own) {
+                slot->wake.notify_one();
+            }
+        }
+    }
+
+    // Own ballot is done: leave, handing the role to the oldest waiter if any
+    if (queue.empty()) {
+        combining = false;
+    } else {
+        queue.front()->state = SlotState::Lead;
+        queue.front()->wake.notify_one();
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "ServiceResponse.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Combines concurrent votes on one election into batches. Callers queue their
+// ballot; whoever finds no batch in progress becomes the combiner, takes up to
+// maxBatch queued ballots (its own among them) and applies them in one
+// critical section, then hands each waiter its response. Ballots that arrive
+// meanwhile form the next batch, so batches grow with contention and a lone
+// caller pays nothing extra. A combiner stops as soon as its own ballot is
+// done and passes the role to the oldest waiter, which bounds every caller's
+// wait by its place in the queue.
+class VoteBatcher {
+public:
+    struct Ballot {
+        int voterId;
+        int candidateIndex;
+        ServiceResponse response;
+    };
+
+    // Applies one batch in order and fills in every ballot's response
+    using ApplyBatch = std::function<void(const std::vector<Ballot*>& batch)>;
+
+    explicit VoteBatcher(size_t maxBatch = 64);
+
+    ServiceResponse submit(int voterId, int candidateIndex, const ApplyBatch& apply);
+
+    uint64_t getBatchCount() const;
+    uint64_t getBallotCount() const;
+    size_t getLargestBatch() const;
+
+private:
+    enum class SlotState { Queued, Done, Lead };
+
+    struct Slot {
+        Ballot ballot;
+        SlotState state = SlotState::Queued;
+        std::condition_variable wake;
+    };
+
+    size_t maxBatch;
+    std::mutex mutex;
+    std::deque<Slot*> queue;      // Guarded by mutex; slots live on their callers' stacks
+    bool combining;
+    std::atomic<uint64_t> batchCount;
+    std::atomic<uint64_t> ballotCount;
+    std::atomic<size_t> largestBatch;
+
+    void combine(Slot& own, std::unique_lock<std::mutex>& lock, const ApplyBatch& apply);
+};
@@ -0,0 +1,240 @@
+#include "WorkStealingExecutor.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+#ifdef __linux__
+#define CLEARBALLOT_HAVE_AFFINITY 1
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Lets submit() from inside a task keep the work on the calling worker
+thread_local const WorkStealingExecutor* currentExecutor = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(const Options& options)
+    : stopping(false), nextWorker(0), tasksExecuted(0), tasksStolen(0) {
+    size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+    size_t count = options.workerThreads == 0 ? cpus : options.workerThreads;
+    for (size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    // Start only once every queue exists, since workers steal from each other
+    for (size_t i = 0; i < count; ++i) {
+        int cpu = options.pinThreads ? static_cast<int>((options.firstCpu + i) % cpus) : -1;
+        workers[i]->thread = std::thread(&WorkStealingExecutor::run, this, i, cpu);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    shutdown();
+}
+
+void WorkStealingExecutor::shutdown() {
+    if (stopping.exchange(true)) {
+        return;
+    }
+    for (auto& worker : workers) {
+        std::lock_guard<std::mutex> lock(worker->parkMutex);
+        worker->notified = true;
+        worker->parked.notify_one();
+    }
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    // A submit racing with shutdown can land after the workers' last look
+    Task task;
+    for (auto& worker : workers) {
+        while (takeOwn(*worker, task)) {
+            execute(task);
+            ++tasksExecuted;
+        }
+    }
+}
+
+size_t WorkStealingExecutor::getWorkerCount() const {
+    return workers.size();
+}
+
+size_t WorkStealingExecutor::homeWorker(uint64_t affinityKey) const {
+    return static_cast<size_t>(affinityKey % workers.size());
+}
+
+int WorkStealingExecutor::currentWorker() const {
+    return currentExecutor == this ? static_cast<int>(currentIndex) : -1;
+}
+
+uint64_t WorkStealingExecutor::getTasksExecuted() const {
+    return tasksExecuted.load();
+}
+
+uint64_t WorkStealingExecutor::getTasksStolen() const {
+    return tasksStolen.load();
+}
+
+bool WorkStealingExecutor::submit(Task task) {
+    size_t index = currentExecutor == this ? currentIndex : nextWorker++ % workers.size();
+    return enqueue(index, std::move(task));
+}
+
+bool WorkStealingExecutor::submit(uint64_t affinityKey, Task task) {
+    return enqueue(homeWorker(affinityKey), std::move(task));
+}
+
+bool WorkStealingExecutor::enqueue(size_t index, Task task) {
+    if (stopping.load()) {
+        return false;
+    }
+    Worker& worker = *workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.queueMutex);
+        worker.queue.push_back(std::move(task));
+        ++worker.queued;
+    }
+    // An idle home worker takes it; a backlog behind a busy one is offered to a thief
+    if (!wakeIfSleeping(worker) && worker.queued.load() > 1) {
+        wakeIdleThief(index);
+    }
+    return true;
+}
+
+bool WorkStealingExecutor::wakeIfSleeping(Worker& worker) {
+    std::lock_guard<std::mutex> lock(worker.parkMutex);
+    if (!worker.sleeping) {
+        return false;
+    }
+    if (!worker.notified) {
+        worker.notified = true;
+        worker.parked.notify_one();
+    }
+    return true;
+}
+
+void WorkStealingExecutor::wakeIdleThief(size_t busyIndex) {
+    for (size_t step = 1; step < workers.size(); ++step) {
+        if (wakeIfSleeping(*workers[(busyIndex + step) % workers.size()])) {
+            return;
+        }
+    }
+}
+
+// A single task queued for an idle owner is left to the owner, which has been woken
+bool WorkStealingExecutor::stealable(const Worker& victim) const {
+    size_t depth = victim.queued.load();
+    return depth > 1 || (depth == 1 && victim.busy.load());
+}
+
+bool WorkStealingExecutor::anyWorkFor(size_t index) const {
+    for (size_t i = 0; i < workers.size(); ++i) {
+        if (i == index ? workers[i]->queued.load() > 0 : stealable(*workers[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingExecutor::takeOwn(Worker& worker, Task& task) {
+    if (worker.queued.load() == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(worker.queueMutex);
+    if (worker.queue.empty()) {
+        return false;
+    }
+    task = std::move(worker.queue.front());
+    worker.queue.pop_front();
+    --worker.queued;
+    return true;
+}
+
+bool WorkStealingExecutor::steal(size_t thief, Task& task) {
+    // Retry while some queue looks stealable; the victim may drain it first
+    for (size_t attempt = 0; attempt < workers.size(); ++attempt) {
+        size_t victim = thief;
+        size_t deepest = 0;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            size_t depth = workers[i]->queued.load();
+            if (i != thief && depth > deepest && stealable(*workers[i])) {
+                victim = i;
+                deepest = depth;
+            }
+        }
+        if (victim == thief) {
+            return false;
+        }
+        if (takeOwn(*workers[victim], task)) {
+            ++tasksStolen;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::run(size_t index, int cpu) {
+    currentExecutor = this;
+    currentIndex = index;
+    if (cpu >= 0) {
+        pinToCpu(cpu);
+    }
+
+    Worker& self = *workers[index];
+    while (true) {
+        Task task;
+        if (takeOwn(self, task) || steal(index, task)) {
+            self.busy.store(true);
+            execute(task);
+            self.busy.store(false);
+            ++tasksExecuted;
+            continue;
+        }
+
+        // Sleeping is announced under parkMutex before the final look at the
+        // queues, so a submit either is seen here or finds this worker asleep
+        std::unique_lock<std::mutex> lock(self.parkMutex);
+        if (anyWorkFor(index)) {
+            continue;
+        }
+        if (stopping.load()) {
+            break;
+        }
+        self.sleeping = true;
+        self.parked.wait(lock, [&]() { return self.notified || stopping.load(); });
+        self.sleeping = false;
+        self.notified = false;
+    }
+    currentExecutor = nullptr;
+}
+
+void WorkStealingExecutor::execute(Task& task) {
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cout << "[EXECUTOR ERROR] Task failed: " << e.what() << "\n";
+    } catch (...) {
+        std::cout << "[EXECUTOR ERROR] Task failed with an unknown exception.\n";
+    }
+}
+
+#ifdef CLEARBALLOT_HAVE_AFFINITY
+
+void WorkStealingExecutor::pinToCpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % CPU_SETSIZE, &set);
+    if (::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+        std::cout << "[EXECUTOR] Could not pin a worker to CPU " << cpu << "; it will float.\n";
+    }
+}
+
+#else
+
+void WorkStealingExecutor::pinToCpu(int) {}
+
+#endif
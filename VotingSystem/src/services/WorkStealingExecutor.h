@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads, one task queue each. A task submitted with an
+// affinity key (an election ID, say) goes to that key's home worker, so one
+// election's data stays warm in one core's cache. A worker that runs out of
+// work steals the oldest task from the deepest queue whose owner is busy or
+// has a backlog, before it sleeps; a submit that queues up behind a busy home
+// worker wakes an idle worker to steal it. Tasks with the same key therefore usually, but not always, run in
+// submission order on the same thread; callers that need ordering must wait.
+class WorkStealingExecutor {
+public:
+    using Task = std::function<void()>;
+
+    struct Options {
+        size_t workerThreads = 0;   // 0 = one per hardware thread
+        bool pinThreads = false;    // Pin worker i to CPU (firstCpu + i) mod the CPU count; Linux only
+        size_t firstCpu = 0;
+    };
+
+    explicit WorkStealingExecutor(const Options& options);
+    WorkStealingExecutor() : WorkStealingExecutor(Options()) {}
+    // Runs everything already queued, then joins the workers
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    // From a worker, unkeyed tasks stay on that worker; from outside they are
+    // spread round-robin. Returns false once shutdown() has begun.
+    bool submit(Task task);
+    bool submit(uint64_t affinityKey, Task task);
+    void shutdown();
+
+    size_t getWorkerCount() const;
+    size_t homeWorker(uint64_t affinityKey) const;
+    // Index of the calling worker, or -1 outside the pool
+    int currentWorker() const;
+    uint64_t getTasksExecuted() const;
+    uint64_t getTasksStolen() const;
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::mutex queueMutex;
+        std::deque<Task> queue;
+        std::atomic<size_t> queued{0};   // queue.size(), readable without the lock
+        std::atomic<bool> busy{false};   // Running a task
+        std::mutex parkMutex;
+        std::condition_variable parked;
+        bool sleeping = false;           // Guarded by parkMutex
+        bool notified = false;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> nextWorker;
+    std::atomic<uint64_t> tasksExecuted;
+    std::atomic<uint64_t> tasksStolen;
+
+    bool enqueue(size_t index, Task task);
+    void run(size_t index, int cpu);
+    bool takeOwn(Worker& worker, Task& task);
+    bool steal(size_t thief, Task& task);
+    bool stealable(const Worker& victim) const;
+    bool anyWorkFor(size_t index) const;
+    bool wakeIfSleeping(Worker& worker);
+    void wakeIdleThief(size_t busyIndex);
+    static void execute(Task& task);
+    static void pinToCpu(int cpu);
+};
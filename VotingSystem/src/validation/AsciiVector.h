@@ -0,0 +1,28 @@
+#pragma once
+
+// Classification of 16 ASCII bytes at a time, shared by the name checks
+// (Utf8Name::scan and InputValidator::checkNames) so their vector paths agree
+// with each other and with AsciiClass on what a letter or a space is.
+#if defined(__x86_64__) || defined(_M_X64)
+#define CLEARBALLOT_X86_SIMD 1
+#include <immintrin.h>
+
+struct AsciiVector {
+    // Unsigned "c - base < span" for every byte, via a signed compare with the bias flipped
+    static __m128i inRange(__m128i v, char base, char span) {
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+        __m128i offset = _mm_xor_si128(_mm_sub_epi8(v, _mm_set1_epi8(base)), bias);
+        return _mm_cmplt_epi8(offset, _mm_set1_epi8(static_cast<char>(0x80 + span)));
+    }
+
+    // 0xFF for each byte that is an ASCII letter
+    static __m128i letters(__m128i v) {
+        return inRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+    }
+
+    // 0xFF for each byte that is ASCII whitespace
+    static __m128i spaces(__m128i v) {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), inRange(v, '\t', 5));
+    }
+};
+#endif
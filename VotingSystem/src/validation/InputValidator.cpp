@@ -1,26 +1,215 @@
 #include "InputValidator.h"
+#include "ValidationRules.h"
+#include "AsciiVector.h"
 #include <regex>
-#include <sstream>
 #include <algorithm>
-#include <cctype>
+#include <cstring>
+
+namespace {
+
+using Standard = RuleValidator<StandardRules>;
+
+// Bulk checks: a block of 64 rows is trimmed and copied into Width-byte slots
+// first, then classified in a second pass, so the vector loads never wait on
+// the byte stores of the copy. A classifier returns one bit per slot byte that
+// is an allowed character; a row of length n passes when its length is in
+// range and its low n bits are all set. Bytes past the end of a row are
+// ignored, and only the 16-byte chunks a row reaches are classified.
+const size_t BLOCK_ROWS = 64;
+
+template <size_t Width>
+struct PackedBlock {
+    alignas(16) char slots[BLOCK_ROWS][Width];
+    uint8_t lengths[BLOCK_ROWS];
+    bool packed[BLOCK_ROWS];   // False when the trimmed row does not fit a slot
+};
+
+// Fixed-size pieces (overlapping where the length is not a multiple) compile
+// to plain moves, where a variable-length memcpy is a library call per row
+inline void copySmall(char* destination, const char* source, size_t length) {
+    if (length >= 16) {
+        for (size_t offset = 0; offset + 16 < length; offset += 16) {
+            std::memcpy(destination + offset, source + offset, 16);
+        }
+        std::memcpy(destination + length - 16, source + length - 16, 16);
+    } else if (length >= 8) {
+        std::memcpy(destination, source, 8);
+        std::memcpy(destination + length - 8, source + length - 8, 8);
+    } else if (length >= 4) {
+        std::memcpy(destination, source, 4);
+        std::memcpy(destination + length - 4, source + length - 4, 4);
+    } else if (length > 0) {
+        destination[0] = source[0];
+        destination[length / 2] = source[length / 2];
+        destination[length - 1] = source[length - 1];
+    }
+}
+
+template <size_t Width>
+void packBlock(const std::string_view* values, size_t rows, PackedBlock<Width>& block) {
+    for (size_t i = 0; i < rows; ++i) {
+        std::string_view value = InputValidator::trimView(values[i]);
+        block.packed[i] = value.size() <= Width;
+        block.lengths[i] = static_cast<uint8_t>(block.packed[i] ? value.size() : 0);
+        if (block.packed[i]) {
+            copySmall(block.slots[i], value.data(), value.size());
+        }
+    }
+}
+
+inline uint64_t lowBits(size_t count) {
+    return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+}
+
+#ifdef CLEARBALLOT_X86_SIMD
+inline uint64_t nameBits(const char* p, size_t length) {
+    uint64_t bits = 0;
+    for (size_t i = 0; 16 * i < length; ++i) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        __m128i allowed = _mm_or_si128(AsciiVector::letters(v), AsciiVector::spaces(v));
+        bits |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(allowed))) << (16 * i);
+    }
+    return bits;
+}
+#else
+inline uint64_t nameBits(const char* p, size_t length) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < length; ++i) {
+        bits |= uint64_t(AsciiClass::isAlpha(p[i]) || AsciiClass::isSpace(p[i])) << i;
+    }
+    return bits;
+}
+#endif
+
+// Rows whose trimmed length is within [minLength, maxLength] are classified,
+// then given to accept. Rows too long for a slot, or with a byte the
+// classifier does not allow, get a second chance from fallback: the full
+// single-value check, for fields where such rows can still be valid.
+template <size_t Width, typename Classify, typename Accept, typename Fallback>
+InputValidator::RowBitmap checkColumn(const std::string_view* values, size_t rows,
+                                      size_t minLength, size_t maxLength,
+                                      Classify classify, Accept accept, Fallback fallback) {
+    static_assert(Width % 16 == 0 && Width <= 64, "slots are whole vectors, one bit per byte");
+    InputValidator::RowBitmap result(rows);
+    std::vector<uint64_t>& words = result.data();
+    PackedBlock<Width> block{};   // Zeroed once so slot tails are never uninitialized reads
+    for (size_t start = 0; start < rows; start += BLOCK_ROWS) {
+        size_t count = std::min(BLOCK_ROWS, rows - start);
+        packBlock(values + start, count, block);
+        uint64_t word = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bool valid;
+            size_t length = block.lengths[i];
+            if (!block.packed[i]) {
+                valid = fallback(values[start + i]);
+            } else if (length < minLength || length > maxLength) {
+                valid = false;
+            } else {
+                uint64_t mask = lowBits(length);
+                valid = (classify(block.slots[i], length) & mask) == mask
+                            ? accept(std::string_view(block.slots[i], length))
+                            : fallback(values[start + i]);
+            }
+            word |= uint64_t(valid) << i;
+        }
+        words[start / BLOCK_ROWS] = word;
+    }
+    return result;
+}
+
+} // namespace
+
+// The single-value checks are the standard jurisdiction's; see ValidationRules.h
+
+InputValidator::Problem InputValidator::checkName(std::string_view name) {
+    return Standard::checkName(name);
+}
+
+InputValidator::Problem InputValidator::checkPhoneNumber(std::string_view phone) {
+    return Standard::checkPhoneNumber(phone);
+}
+
+InputValidator::Problem InputValidator::checkUniqueId(std::string_view id, int* value) {
+    return Standard::checkUniqueId(id, value);
+}
+
+InputValidator::Problem InputValidator::checkAddress(std::string_view address) {
+    return Standard::checkAddress(address);
+}
+
+InputValidator::Problem InputValidator::checkAge(std::string_view ageStr, int* value) {
+    return Standard::checkAge(ageStr, value);
+}
+
+InputValidator::Failures InputValidator::checkVoterInput(std::string_view firstName, std::string_view lastName,
+                                                         std::string_view phone, std::string_view address,
+                                                         std::string_view idStr, std::string_view ageStr,
+                                                         int* uniqueId, int* age) {
+    return Standard::checkVoterInput(firstName, lastName, phone, address, idStr, ageStr, uniqueId, age);
+}
+
+std::string InputValidator::Failures::describe() const {
+    return Standard::describe(*this);
+}
+
+std::string InputValidator::describe(Field field, Problem problem) {
+    return Standard::describe(field, problem);
+}
+
+size_t InputValidator::RowBitmap::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        while (word) {
+            word &= word - 1;
+            ++total;
+        }
+    }
+    return total;
+}
+
+InputValidator::RowBitmap& InputValidator::RowBitmap::operator&=(const RowBitmap& other) {
+    for (size_t i = 0; i < words.size() && i < other.words.size(); ++i) {
+        words[i] &= other.words[i];
+    }
+    return *this;
+}
+
+InputValidator::RowBitmap InputValidator::checkNames(const std::string_view* values, size_t rows,
+                                                     size_t minLength, size_t maxLength,
+                                                     Problem (*singleCheck)(std::string_view)) {
+    // The slots take ASCII names; non-ASCII bytes fail the classifier, so
+    // those rows and any too long for a slot go through singleCheck. For
+    // ASCII bytes are characters, so the byte length is the name's length.
+    return checkColumn<64>(
+        values, rows, minLength, 64, nameBits,
+        [maxLength](std::string_view name) { return name.size() <= maxLength; },
+        [singleCheck](std::string_view name) { return singleCheck(name) == Problem::None; });
+}
+
+InputValidator::RowBitmap InputValidator::checkNames(const std::string_view* values, size_t rows) {
+    return Standard::checkNames(values, rows);
+}
+
+const char* InputValidator::batchSimdLevel() {
+#ifdef CLEARBALLOT_X86_SIMD
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// The string API below is kept for existing callers and shares the checks above
 
 bool InputValidator::isValidName(const std::string& name) {
-    std::string trimmedName = trim(name);
-    return !trimmedName.empty() && 
-           isValidLength(trimmedName, ValidationConfig::MIN_NAME_LENGTH, ValidationConfig::MAX_NAME_LENGTH) &&
-           containsOnlyAlphabetsAndSpaces(trimmedName);
+    return checkName(name) == Problem::None;
 }
 
 bool InputValidator::isValidPhoneNumber(const std::string& phone) {
-    std::string trimmedPhone = trim(phone);
-    return isExactLength(trimmedPhone, ValidationConfig::PHONE_NUMBER_LENGTH) &&
-           containsOnlyDigits(trimmedPhone);
+    return checkPhoneNumber(phone) == Problem::None;
 }
 
 bool InputValidator::isValidUniqueId(const std::string& id) {
-    std::string trimmedId = trim(id);
-    return isExactLength(trimmedId, ValidationConfig::UNIQUE_ID_LENGTH) &&
-           containsOnlyDigits(trimmedId);
+    return checkUniqueId(id) == Problem::None;
 }
 
 bool InputValidator::isValidAge(int age) {
@@ -28,22 +217,11 @@ bool InputValidator::isValidAge(int age) {
 }
 
 bool InputValidator::isValidAge(const std::string& ageStr) {
-    std::string trimmedAge = trim(ageStr);
-    if (!containsOnlyDigits(trimmedAge) || trimmedAge.empty()) {
-        return false;
-    }
-    
-    try {
-        int age = std::stoi(trimmedAge);
-        return isValidAge(age);
-    } catch (const std::exception&) {
-        return false;
-    }
+    return checkAge(ageStr) == Problem::None;
 }
 
 bool InputValidator::isValidAddress(const std::string& address) {
-    std::string trimmedAddress = trim(address);
-    return isValidLength(trimmedAddress, ValidationConfig::MIN_ADDRESS_LENGTH, ValidationConfig::MAX_ADDRESS_LENGTH);
+    return checkAddress(address) == Problem::None;
 }
 
 std::string InputValidator::validateVoterInput(const std::string& firstName, 
@@ -52,178 +230,29 @@ std::string InputValidator::validateVoterInput(const std::string& firstName,
                                              const std::string& address,
                                              const std::string& idStr,
                                              const std::string& ageStr) {
-    std::ostringstream errors;
-    
-    // Validate each field and collect all errors
-    std::string firstNameError = validateName(firstName, "First name");
-    if (!firstNameError.empty()) {
-        errors << firstNameError << "\n";
-    }
-    
-    std::string lastNameError = validateName(lastName, "Last name");
-    if (!lastNameError.empty()) {
-        errors << lastNameError << "\n";
-    }
-    
-    std::string phoneError = validatePhoneNumber(phone);
-    if (!phoneError.empty()) {
-        errors << phoneError << "\n";
-    }
-    
-    std::string addressError = validateAddress(address);
-    if (!addressError.empty()) {
-        errors << addressError << "\n";
-    }
-    
-    std::string idError = validateUniqueId(idStr);
-    if (!idError.empty()) {
-        errors << idError << "\n";
-    }
-    
-    std::string ageError = validateAge(ageStr);
-    if (!ageError.empty()) {
-        errors << ageError << "\n";
-    }
-    
-    return errors.str();
+    return checkVoterInput(firstName, lastName, phone, address, idStr, ageStr).describe();
 }
 
 std::string InputValidator::validateName(const std::string& name, const std::string& fieldName) {
-    std::string trimmedName = trim(name);
-    
-    if (trimmedName.empty()) {
-        return "[ERROR] " + fieldName + " cannot be empty.";
-    }
-    
-    if (trimmedName.length() < ValidationConfig::MIN_NAME_LENGTH) {
-        return "[ERROR] " + fieldName + " must be at least " + 
-               std::to_string(ValidationConfig::MIN_NAME_LENGTH) + " characters long.";
-    }
-    
-    if (trimmedName.length() > ValidationConfig::MAX_NAME_LENGTH) {
-        return "[ERROR] " + fieldName + " must not exceed " + 
-               std::to_string(ValidationConfig::MAX_NAME_LENGTH) + " characters.";
-    }
-    
-    if (!containsOnlyAlphabetsAndSpaces(trimmedName)) {
-        return "[ERROR] " + fieldName + " must contain only alphabetic characters and spaces.";
-    }
-    
-    return ""; // No errors
+    return Standard::describeName(fieldName, checkName(name));
 }
 
 std::string InputValidator::validatePhoneNumber(const std::string& phone) {
-    std::string trimmedPhone = trim(phone);
-    
-    if (trimmedPhone.empty()) {
-        return "[ERROR] Phone number cannot be empty.";
-    }
-    
-    if (trimmedPhone.length() != ValidationConfig::PHONE_NUMBER_LENGTH) {
-        return "[ERROR] Phone number must be exactly " + 
-               std::to_string(ValidationConfig::PHONE_NUMBER_LENGTH) + " digits long.";
-    }
-    
-    if (!containsOnlyDigits(trimmedPhone)) {
-        return "[ERROR] Phone number must contain only numeric digits.";
-    }
-    
-    return ""; // No errors
+    return describe(Field::Phone, checkPhoneNumber(phone));
 }
 
 std::string InputValidator::validateUniqueId(const std::string& id) {
-    std::string trimmedId = trim(id);
-    
-    if (trimmedId.empty()) {
-        return "[ERROR] Unique ID cannot be empty.";
-    }
-    
-    if (trimmedId.length() != ValidationConfig::UNIQUE_ID_LENGTH) {
-        return "[ERROR] Unique ID must be exactly " + 
-               std::to_string(ValidationConfig::UNIQUE_ID_LENGTH) + " digits long.";
-    }
-    
-    if (!containsOnlyDigits(trimmedId)) {
-        return "[ERROR] Unique ID must contain only numeric digits.";
-    }
-    
-    return ""; // No errors
+    return describe(Field::UniqueId, checkUniqueId(id));
 }
 
 std::string InputValidator::validateAddress(const std::string& address) {
-    std::string trimmedAddress = trim(address);
-    
-    if (trimmedAddress.empty()) {
-        return "[ERROR] Address cannot be empty.";
-    }
-    
-    if (trimmedAddress.length() < ValidationConfig::MIN_ADDRESS_LENGTH) {
-        return "[ERROR] Address must be at least " + 
-               std::to_string(ValidationConfig::MIN_ADDRESS_LENGTH) + " characters long.";
-    }
-    
-    if (trimmedAddress.length() > ValidationConfig::MAX_ADDRESS_LENGTH) {
-        return "[ERROR] Address must not exceed " + 
-               std::to_string(ValidationConfig::MAX_ADDRESS_LENGTH) + " characters.";
-    }
-    
-    return ""; // No errors
+    return describe(Field::Address, checkAddress(address));
 }
 
 std::string InputValidator::validateAge(const std::string& ageStr) {
-    std::string trimmedAge = trim(ageStr);
-    
-    if (trimmedAge.empty()) {
-        return "[ERROR] Age cannot be empty.";
-    }
-    
-    if (!containsOnlyDigits(trimmedAge)) {
-        return "[ERROR] Age must be a valid number (digits only).";
-    }
-    
-    try {
-        int age = std::stoi(trimmedAge);
-        if (age < ValidationConfig::MIN_AGE) {
-            return "[ERROR] You must be at least " + 
-                   std::to_string(ValidationConfig::MIN_AGE) + " years old to register.";
-        }
-        if (age > ValidationConfig::MAX_AGE) {
-            return "[ERROR] Age must not exceed " + 
-                   std::to_string(ValidationConfig::MAX_AGE) + " years.";
-        }
-    } catch (const std::exception&) {
-        return "[ERROR] Age contains invalid characters or is too large.";
-    }
-    
-    return ""; // No errors
-}
-
-// Private helper methods
-bool InputValidator::containsOnlyAlphabetsAndSpaces(const std::string& str) {
-    return std::all_of(str.begin(), str.end(), [](unsigned char c) {
-        return std::isalpha(c) || std::isspace(c);
-    });
-}
-
-bool InputValidator::containsOnlyDigits(const std::string& str) {
-    return std::all_of(str.begin(), str.end(), [](unsigned char c) {
-        return std::isdigit(c);
-    });
-}
-
-bool InputValidator::isExactLength(const std::string& str, size_t length) {
-    return str.length() == length;
-}
-
-bool InputValidator::isValidLength(const std::string& str, size_t min, size_t max) {
-    return str.length() >= min && str.length() <= max;
+    return describe(Field::Age, checkAge(ageStr));
 }
 
 std::string InputValidator::trim(const std::string& str) {
-    size_t start = str.find_first_not_of(" \t\r\n");
-    if (start == std::string::npos) {
-        return "";
-    }
-    size_t end = str.find_last_not_of(" \t\r\n");
-    return str.substr(start, end - start + 1);
+    return std::string(trimView(str));
 }
@@ -0,0 +1,479 @@
+#include "Utf8Name.h"
+#include "AsciiVector.h"
+
+namespace {
+
+// Letter and mark tables for code points below TABLE_LIMIT, which covers every
+// assigned letter and mark outside the variation selectors. Each 256-code-point
+// block maps through *_BLOCK_INDEX to one of a few distinct 256-bit bitmaps.
+// Generated from the Unicode 14.0 character database (Python's unicodedata):
+// a code point is set when its general category starts with L (or M).
+const uint32_t TABLE_LIMIT = 0x40000;
+const size_t TABLE_BLOCKS = TABLE_LIMIT >> 8;
+
+const uint8_t LETTER_BLOCK_INDEX[TABLE_BLOCKS] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    17, 2, 18, 19, 20, 2, 21, 22, 23, 24, 25, 26, 27, 28, 2, 29,
+    30, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32, 33, 34, 0,
+    35, 36, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 28, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 37, 2, 38, 39, 40, 41, 42, 43, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 44, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 45, 46, 2, 47, 48, 49,
+    50, 0, 51, 52, 53, 54, 2, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 0, 75, 76, 77, 78,
+    2, 2, 2, 79, 80, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82,
+    2, 2, 2, 2, 83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 2, 84, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 85, 86, 0, 0, 87, 88,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 89, 2, 2, 2, 2, 90, 91, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92,
+    2, 93, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 95, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 96, 97, 98, 99, 0, 0, 0, 0, 0, 0, 0, 100,
+    0, 101, 102, 0, 0, 0, 0, 103, 104, 105, 0, 0, 0, 0, 106, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 107, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 108, 109, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 110, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 111, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 112, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 113, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+const uint64_t LETTER_BLOCKS[][4] = {
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x07fffffe07fffffe, 0x0420040000000000, 0xff7fffffff7fffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x0000501f0003ffc3},
+    {0x0000000000000000, 0xbcdf000000000000, 0xfffffffbffffd740, 0xffbfffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xfffffffffffffc03, 0xffffffffffffffff},
+    {0xfffeffffffffffff, 0xffffffff027fffff, 0x00000000000001ff, 0x000787ffffff0000},
+    {0xffffffff00000000, 0xfffec000000007ff, 0xffffffffffffffff, 0x9c00c060002fffff},
+    {0x0000fffffffd0000, 0xffffffffffffe000, 0x0002003fffffffff, 0x043007fffffffc00},
+    {0x00000110043fffff, 0xffff07ff01ffffff, 0xffffffff00007eff, 0x00000000000003ff},
+    {0x23fffffffffffff0, 0xfffe0003ff010000, 0x23c5fdfffff99fe1, 0x10030003b0004000},
+    {0x036dfdfffff987e0, 0x001c00005e000000, 0x23edfdfffffbbfe0, 0x0200000300010000},
+    {0x23edfdfffff99fe0, 0x00020003b0000000, 0x03ffc718d63dc7e8, 0x0000000000010000},
+    {0x23fffdfffffddfe0, 0x0000000327000000, 0x23effdfffffddfe1, 0x0006000360000000},
+    {0x27fffffffffddff0, 0xfc00000380704000, 0x2ffbfffffc7fffe0, 0x000000000000007f},
+    {0x000dfffffffffffe, 0x000000000000007f, 0x200dffaffffff7d6, 0x00000000f000005f},
+    {0x0000000000000001, 0x00001ffffffffeff, 0x0000000000001f00, 0x0000000000000000},
+    {0x800007ffffffffff, 0xffe1c0623c3f0000, 0xffffffff00004003, 0xf7ffffffffff20bf},
+    {0xffffffffffffffff, 0xffffffff3d7f3dff, 0x7f3dffffffff3dff, 0xffffffffff7fff3d},
+    {0xffffffffff3dffff, 0x0000000007ffffff, 0xffffffff0000ffff, 0x3f3fffffffffffff},
+    {0xfffffffffffffffe, 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffff9fffffffffff, 0xffffffff07fffffe, 0x01fe07ffffffffff},
+    {0x0003ffff8003ffff, 0x0001dfff0003ffff, 0x000fffffffffffff, 0x0000000010800000},
+    {0xffffffff00000000, 0x01ffffffffffffff, 0xffff05ffffffff9f, 0x003fffffffffffff},
+    {0x000000007fffffff, 0x001f3fffffff0000, 0xffff0fffffffffff, 0x00000000000003ff},
+    {0xffffffff007fffff, 0x00000000001fffff, 0x0000008000000000, 0x0000000000000000},
+    {0x000fffffffffffe0, 0x0000000000001fe0, 0xfc00c001fffffff8, 0x0000003fffffffff},
+    {0x0000000fffffffff, 0x3ffffffffc00e000, 0xe7ffffffffff01ff, 0x046fde0000000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x0000000000000000},
+    {0xffffffff3f3fffff, 0x3fffffffaaff3f3f, 0x5fdfffffffffffff, 0x1fdc1fff0fcf1fdc},
+    {0x0000000000000000, 0x8002000000000000, 0x000000001fff0000, 0x0000000000000000},
+    {0xf3ffbd503e2ffc84, 0x00000000000043e0, 0x0000000000000018, 0x0000000000000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x000c781fffffffff},
+    {0xffff20bfffffffff, 0x000080ffffffffff, 0x7f7f7f7f007fffff, 0x000000007f7f7f7f},
+    {0x0000800000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x183e000000000060, 0xfffffffffffffffe, 0xfffffffee07fffff, 0xf7ffffffffffffff},
+    {0xfffeffffffffffe0, 0xffffffffffffffff, 0xffffffff00007fff, 0xffff000000000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0x0000000000001fff, 0x3fffffffffff0000},
+    {0x00000c00ffff1fff, 0x80007fffffffffff, 0xffffffff3fffffff, 0x0000003fffffffff},
+    {0xfffffffcff800000, 0xffffffffffffffff, 0xfffffffffffff9ff, 0xfffc000003eb07ff},
+    {0x00000007fffff7bb, 0x000fffffffffffff, 0x000ffffffffffffc, 0x68fc000000000000},
+    {0xffff003ffffffc00, 0x1fffffff0000007f, 0x0007fffffffffff0, 0x7c00ffdf00008000},
+    {0x000001ffffffffff, 0xc47fffff00000ff7, 0x3e62ffffffffffff, 0x001c07ff38000005},
+    {0xffff7f7f007e7e7e, 0xffff03fff7ffffff, 0xffffffffffffffff, 0x00000007ffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffff000fffffffff, 0x0ffffffffffff87f},
+    {0xffffffffffffffff, 0xffff3fffffffffff, 0xffffffffffffffff, 0x0000000003ffffff},
+    {0x5f7ffdffa0f8007f, 0xffffffffffffffdb, 0x0003ffffffffffff, 0xfffffffffff80000},
+    {0x3fffffffffffffff, 0xffffffffffff0000, 0xfffffffffffcffff, 0x0fff0000000000ff},
+    {0x0000000000000000, 0xffdf000000000000, 0xffffffffffffffff, 0x1fffffffffffffff},
+    {0x07fffffe00000000, 0xffffffc007fffffe, 0x7fffffffffffffff, 0x000000001cfcfcfc},
+    {0xb7ffff7fffffefff, 0x000000003fff3fff, 0xffffffffffffffff, 0x07ffffffffffffff},
+    {0x0000000000000000, 0x0000000000000000, 0xffffffff1fffffff, 0x000000000001ffff},
+    {0xffffe000ffffffff, 0x003fffffffff03fd, 0xffffffff3fffffff, 0x000000000000ff0f},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffff00003fffffff, 0x0fffffffff0fffff},
+    {0xffff00ffffffffff, 0xf7ff000fffffffff, 0x1bfbfffbffb7f7ff, 0x0000000000000000},
+    {0x007fffffffffffff, 0x000000ff003fffff, 0x07fdffffffffffbf, 0x0000000000000000},
+    {0x91bffffffffffd3f, 0x007fffff003fffff, 0x000000007fffffff, 0x0037ffff00000000},
+    {0x03ffffff003fffff, 0x0000000000000000, 0xc0ffffffffffffff, 0x0000000000000000},
+    {0x003ffffffeef0001, 0x1fffffff00000000, 0x000000001fffffff, 0x0000001ffffffeff},
+    {0x003fffffffffffff, 0x0007ffff003fffff, 0x000000000003ffff, 0x0000000000000000},
+    {0xffffffffffffffff, 0x00000000000001ff, 0x0007ffffffffffff, 0x0007ffffffffffff},
+    {0x0000000fffffffff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x000303ffffffffff, 0x0000000000000000},
+    {0xffff00801fffffff, 0xffff00000000003f, 0xffff000000000003, 0x007fffff0000001f},
+    {0x00fffffffffffff8, 0x0026000000000000, 0x0000fffffffffff8, 0x000001ffffff0000},
+    {0x0000007ffffffff8, 0x0047ffffffff0090, 0x0007fffffffffff8, 0x000000001400001e},
+    {0x00000ffffffbffff, 0x0000000000000000, 0xffff01ffbfffbd7f, 0x000000007fffffff},
+    {0x23edfdfffff99fe0, 0x00000003e0010000, 0x0000000000000000, 0x0000000000000000},
+    {0x001fffffffffffff, 0x0000000380000780, 0x0000ffffffffffff, 0x00000000000000b0},
+    {0x0000000000000000, 0x0000000000000000, 0x00007fffffffffff, 0x000000000f000000},
+    {0x0000ffffffffffff, 0x0000000000000010, 0x010007ffffffffff, 0x0000000000000000},
+    {0x0000000007ffffff, 0x000000000000007f, 0x0000000000000000, 0x0000000000000000},
+    {0x00000fffffffffff, 0x0000000000000000, 0xffffffff00000000, 0x80000000ffffffff},
+    {0x8000ffffff6ff27f, 0x0000000000000002, 0xfffffcff00000000, 0x0000000a0001ffff},
+    {0x0407fffffffff801, 0xfffffffff0010000, 0xffff0000200003ff, 0x01ffffffffffffff},
+    {0x00007ffffffffdff, 0xfffc000000000001, 0x000000000000ffff, 0x0000000000000000},
+    {0x0001fffffffffb7f, 0xfffffdbf00000040, 0x00000000010003ff, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0007ffff00000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0001000000000000, 0x0000000000000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0x0000000003ffffff, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0x000000000000000f, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0xffffffffffff0000, 0x0001ffffffffffff},
+    {0x00007fffffffffff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0xffffffffffffffff, 0x000000000000007f, 0x0000000000000000, 0x0000000000000000},
+    {0x01ffffffffffffff, 0xffff00007fffffff, 0x7fffffffffffffff, 0x00003fffffff0000},
+    {0x0000ffffffffffff, 0xe0fffff80000000f, 0x000000000000ffff, 0x0000000000000000},
+    {0x0000000000000000, 0xffffffffffffffff, 0x0000000000000000, 0x0000000000000000},
+    {0xffffffffffffffff, 0x00000000000107ff, 0x00000000fff80000, 0x0000000b00000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x00ffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x00000000003fffff},
+    {0x00000000000001ff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x6fef000000000000},
+    {0x00000007ffffffff, 0xffff00f000070000, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x0fffffffffffffff},
+    {0xffffffffffffffff, 0x1fff07ffffffffff, 0x0000000003ff01ff, 0x0000000000000000},
+    {0xffffffffffffffff, 0xffffffffffdfffff, 0xebffde64dfffffff, 0xffffffffffffffef},
+    {0x7bffffffdfdfe7bf, 0xfffffffffffdfc5f, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffff3fffffffff, 0xf7fffffff7fffffd},
+    {0xffdfffffffdfffff, 0xffff7fffffff7fff, 0xfffffdfffffffdff, 0x0000000000000ff7},
+    {0x000000007fffffff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x3f801fffffffffff, 0x0000000000004000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x00003fffffff0000, 0x00000fffffffffff},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x7fff6f7f00000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x000000000000001f},
+    {0xffffffffffffffff, 0x000000000000080f, 0x0000000000000000, 0x0000000000000000},
+    {0x0af7fe96ffffffef, 0x5ef7f796aa96ea84, 0x0ffffbee0ffffbff, 0x0000000000000000},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x00000000ffffffff},
+    {0x01ffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffff3fffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffff0003ffffffff, 0xffffffffffffffff},
+    {0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff, 0x00000001ffffffff},
+    {0x000000003fffffff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0xffffffffffffffff, 0x00000000000007ff, 0x0000000000000000, 0x0000000000000000},
+};
+
+const uint8_t MARK_BLOCK_INDEX[TABLE_BLOCKS] = {
+    0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+    14, 0, 0, 15, 0, 0, 0, 16, 17, 18, 19, 20, 21, 22, 0, 0,
+    23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 24, 25, 0, 0,
+    26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 27, 0, 28, 29, 30, 31, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32, 0, 0, 33, 0,
+    0, 34, 35, 36, 0, 0, 0, 0, 0, 0, 37, 0, 0, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 0, 52, 53, 54, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 55, 56, 0, 0, 0, 57,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 59,
+    0, 60, 61, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0, 0, 0,
+    63, 56, 64, 0, 0, 0, 0, 0, 65, 66, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+const uint64_t MARK_BLOCKS[][4] = {
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0xffffffffffffffff, 0x0000ffffffffffff, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x00000000000003f8, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0xbffffffffffe0000, 0x00000000000000b6},
+    {0x0000000007ff0000, 0x00010000fffff800, 0x0000000000000000, 0x00003d9f9fc00000},
+    {0xffff000000020000, 0x00000000000007ff, 0x0001ffc000000000, 0x200ff80000000000},
+    {0x00003eeffbc00000, 0x000000000e000000, 0x00000000ff000000, 0xfffffffbfffffc00},
+    {0xdc0000000000000f, 0x0000000c00feffff, 0xd00000000000000e, 0x4000000c0080399f},
+    {0xd00000000000000e, 0x0023000000023987, 0xd00000000000000e, 0xfc00000c00003bbf},
+    {0xd00000000000000e, 0x0000000c00e0399f, 0xc000000000000004, 0x0000000000803dc7},
+    {0xd00000000000001f, 0x0000000c00603ddf, 0xd00000000000000e, 0x0000000c00603ddf},
+    {0xd80000000000000f, 0x0000000c00803ddf, 0x000000000000000e, 0x000c0000ff5f8400},
+    {0x07f2000000000000, 0x0000000000007f80, 0x1ff2000000000000, 0x0000000000003f00},
+    {0xc2a0000003000000, 0xfffe000000000000, 0x1ffffffffeffe0df, 0x0000000000000040},
+    {0x7ffff80000000000, 0x001e3f9dc3c00000, 0x000000003c00bffc, 0x0000000000000000},
+    {0x0000000000000000, 0x00000000e0000000, 0x0000000000000000, 0x0000000000000000},
+    {0x001c0000003c0000, 0x000c0000000c0000, 0xfff0000000000000, 0x00000000200fffff},
+    {0x000000000000b800, 0x0000000000000000, 0x0000020000000060, 0x0000000000000000},
+    {0x0fff0fff00000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x000000000f800000, 0x9fffffff7fe00000, 0xffff000000000000, 0x0000000000007fff},
+    {0xfff000000000001f, 0x000ff8000000001f, 0x00003ffe00000007, 0x000fffc000000000},
+    {0x00fffff000000000, 0x0000000000000000, 0x0000000000000000, 0x039021fffff70000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xffffffffffffffff},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0001ffffffff0000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0003800000000000},
+    {0x0000000000000000, 0x8000000000000000, 0x0000000000000000, 0xffffffff00000000},
+    {0x0000fc0000000000, 0x0000000000000000, 0x0000000006000000, 0x0000000000000000},
+    {0x0000000000000000, 0x3ff7800000000000, 0x00000000c0000000, 0x0003000000000000},
+    {0x000010f800000844, 0x0000000000000000, 0xfff0000000000003, 0x8003ffff0000003f},
+    {0x00003fc000000000, 0x00000000000fff80, 0xfff800000000000f, 0x0000002000000001},
+    {0x007ffe0000000000, 0x3800000000003008, 0xc19d000000000000, 0x0060f80000000002},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x000037f800000000},
+    {0x0000000040000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000ffff0000ffff, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000100000000},
+    {0x0000000000000000, 0x07c0000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x870000000000f06e, 0x0000000000000000, 0x0000000000000000, 0x0000006000000000},
+    {0x000000f000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000180000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x000000000001ffc0, 0x000000000000003c, 0x0000000000000000},
+    {0xff00000000000007, 0x801900000000007f, 0x07ff000000000007, 0x0000000000000004},
+    {0x001fff8000000007, 0x0008000000000060, 0xfff8000000000007, 0x000000000000de01},
+    {0x40fff00000000000, 0x0000000000000000, 0x0000000000000000, 0x000007ff80000000},
+    {0xd80000000000000f, 0x001f1fcc0080399f, 0x0000000000000000, 0x0000000000000000},
+    {0xffe0000000000000, 0x000000004000007f, 0xffff000000000000, 0x000000000000000f},
+    {0x0000000000000000, 0x0000000000000000, 0xff3f800000000000, 0x0000000030000001},
+    {0xffff000000000000, 0x0000000000000001, 0x00fff80000000000, 0x0000000000000000},
+    {0x00000fffe0000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x07fff00000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x79bf000000000000, 0x000000000000000d, 0x0000000000000000, 0x00000011fcfe0000},
+    {0x7bf80000000007fe, 0x000000000ffe0080, 0x0000000003fffc00, 0x0000000000000000},
+    {0xff7f800000000000, 0x0000000000000000, 0x007ffefffffc0000, 0x0000000000000000},
+    {0xb47e000000000000, 0x00000000000000bf, 0x0000000000fb7c00, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0078000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x001f000000000000},
+    {0x007f000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0xfffffffffffe8000, 0x00000000000780ff, 0x0003001000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000060000000, 0x0000000000000000},
+    {0xffff3fffffffffff, 0x000000000000007f, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0xf807e3e000000000, 0x00003c0000000fe7, 0x0000000000000000},
+    {0x0000000000000000, 0x000000000000001c, 0x0000000000000000, 0x0000000000000000},
+    {0xf87fffffffffffff, 0x00201fffffffffff, 0x0000fffef8000010, 0x0000000000000000},
+    {0x000007dbf9ffff7f, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000400000000000, 0x0000f00000000000},
+    {0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x00000000007f0000},
+    {0x0000000000000000, 0x00000000000007f0, 0x0000000000000000, 0x0000000000000000},
+};
+
+inline bool lookup(const uint8_t* index, const uint64_t (*blocks)[4], uint32_t codePoint) {
+    if (codePoint >= TABLE_LIMIT) {
+        return false;
+    }
+    const uint64_t* block = blocks[index[codePoint >> 8]];
+    return (block[(codePoint >> 6) & 3] >> (codePoint & 63)) & 1;
+}
+
+inline bool isAsciiLetter(unsigned char c) {
+    return static_cast<unsigned char>((c | 0x20) - 'a') < 26;
+}
+
+inline bool isAsciiSpace(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isContinuation(unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+// Decodes the sequence starting at p[0] (a non-ASCII byte) per Table 3-7 of
+// the Unicode standard: no overlong forms, surrogates or values past U+10FFFF.
+// Returns its length, or 0 if it is ill-formed.
+size_t decode(const unsigned char* p, size_t available, uint32_t& codePoint) {
+    unsigned char lead = p[0];
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        if (available < 2 || !isContinuation(p[1])) {
+            return 0;
+        }
+        codePoint = (uint32_t(lead & 0x1F) << 6) | (p[1] & 0x3F);
+        return 2;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        unsigned char low = lead == 0xE0 ? 0xA0 : 0x80;
+        unsigned char high = lead == 0xED ? 0x9F : 0xBF;
+        if (available < 3 || p[1] < low || p[1] > high || !isContinuation(p[2])) {
+            return 0;
+        }
+        codePoint = (uint32_t(lead & 0x0F) << 12) | (uint32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        return 3;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        unsigned char low = lead == 0xF0 ? 0x90 : 0x80;
+        unsigned char high = lead == 0xF4 ? 0x8F : 0xBF;
+        if (available < 4 || p[1] < low || p[1] > high || !isContinuation(p[2]) || !isContinuation(p[3])) {
+            return 0;
+        }
+        codePoint = (uint32_t(lead & 0x07) << 18) | (uint32_t(p[1] & 0x3F) << 12) |
+                    (uint32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        return 4;
+    }
+    return 0;
+}
+
+#ifdef CLEARBALLOT_X86_SIMD
+// For 16 bytes: which are non-ASCII, and which are ASCII letters or whitespace
+inline void classifyAscii(const char* p, unsigned& nonAscii, unsigned& allowed, unsigned& letters) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i letter = AsciiVector::letters(v);
+    nonAscii = static_cast<unsigned>(_mm_movemask_epi8(v));
+    letters = static_cast<unsigned>(_mm_movemask_epi8(letter));
+    allowed = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(letter, AsciiVector::spaces(v))));
+}
+#endif
+
+} // namespace
+
+bool Utf8Name::isLetter(uint32_t codePoint) {
+    return lookup(LETTER_BLOCK_INDEX, LETTER_BLOCKS, codePoint);
+}
+
+bool Utf8Name::isMark(uint32_t codePoint) {
+    return lookup(MARK_BLOCK_INDEX, MARK_BLOCKS, codePoint);
+}
+
+Utf8Name::Status Utf8Name::scan(std::string_view name, size_t& characters) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(name.data());
+    size_t size = name.size();
+    size_t i = 0;
+    Status status = Status::Valid;
+    bool afterLetter = false;   // A mark may only follow a letter (or another mark)
+    characters = 0;
+    
+    auto fail = [&status](Status problem) {
+        if (problem > status) {
+            status = problem;
+        }
+    };
+    
+    while (i < size) {
+#ifdef CLEARBALLOT_X86_SIMD
+        // Whole 16-byte runs of ASCII in one step
+        while (i + 16 <= size) {
+            unsigned nonAscii, allowed, letters;
+            classifyAscii(name.data() + i, nonAscii, allowed, letters);
+            if (nonAscii) {
+                break;
+            }
+            if (allowed != 0xFFFF) {
+                fail(Status::NotALetter);
+            }
+            afterLetter = (letters >> 15) & 1;
+            i += 16;
+            characters += 16;
+        }
+        if (i == size) {
+            break;
+        }
+#endif
+        // Shorter ASCII runs byte by byte, without branching per byte
+        if (p[i] < 0x80) {
+            size_t start = i;
+            bool notAllowed = false;
+            do {
+                notAllowed |= !(isAsciiLetter(p[i]) | isAsciiSpace(p[i]));
+                ++i;
+            } while (i < size && p[i] < 0x80);
+            if (notAllowed) {
+                fail(Status::NotALetter);
+            }
+            afterLetter = isAsciiLetter(p[i - 1]);
+            characters += i - start;
+            continue;
+        }
+        
+        uint32_t codePoint;
+        size_t length = decode(p + i, size - i, codePoint);
+        if (length == 0) {
+            fail(Status::IllFormed);
+            afterLetter = false;
+            ++i;
+            ++characters;
+            continue;
+        }
+        if (isLetter(codePoint)) {
+            afterLetter = true;
+        } else if (!(afterLetter && isMark(codePoint))) {
+            fail(Status::NotALetter);
+            afterLetter = false;
+        }
+        i += length;
+        ++characters;
+    }
+    return status;
+}
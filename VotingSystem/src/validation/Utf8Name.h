@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Names as UTF-8 text. A valid name is well-formed UTF-8 in which every
+// character is a letter (Unicode category L), a combining mark (category M)
+// following a letter, or ASCII whitespace. Runs of ASCII are classified 16
+// bytes at a time; other characters are decoded and looked up in two-stage
+// bitmap tables, so names in any script cost little more than ASCII ones.
+class Utf8Name {
+public:
+    enum class Status { Valid, NotALetter, IllFormed };
+
+    // Scans the whole name, counting its characters (code points; each byte of
+    // an ill-formed sequence counts as one). IllFormed outranks NotALetter.
+    static Status scan(std::string_view name, size_t& characters);
+
+    static bool isLetter(uint32_t codePoint);
+    static bool isMark(uint32_t codePoint);
+};
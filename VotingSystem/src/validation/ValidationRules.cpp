@@ -0,0 +1,35 @@
+#include "ValidationRules.h"
+
+namespace {
+
+const JurisdictionRules<StandardRules> standardRules;
+const JurisdictionRules<YouthVoteRules> youthVoteRules;
+
+// Adding a jurisdiction: a Rules struct in ValidationRules.h and a line here
+const ValidationRules* const REGISTERED_RULES[] = {
+    &standardRules,
+    &youthVoteRules
+};
+
+} // namespace
+
+const ValidationRules& ValidationRules::standard() {
+    return standardRules;
+}
+
+const ValidationRules* ValidationRules::find(std::string_view name) {
+    for (const ValidationRules* rules : REGISTERED_RULES) {
+        if (name == rules->getName()) {
+            return rules;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> ValidationRules::getNames() {
+    std::vector<std::string> names;
+    for (const ValidationRules* rules : REGISTERED_RULES) {
+        names.push_back(rules->getName());
+    }
+    return names;
+}
@@ -0,0 +1,315 @@
+#pragma once
+#include "InputValidator.h"
+#include "Utf8Name.h"
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ASCII-only classification; the C locale gives the same answers as
+// std::isdigit/std::isalpha/std::isspace without the per-call locale lookup
+struct AsciiClass {
+    static bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+    static bool isAlpha(char c) { return static_cast<unsigned char>((c | 0x20) - 'a') < 26; }
+    static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    static bool allDigits(std::string_view text) {
+        for (char c : text) {
+            if (!isDigit(c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Digits only, so the sole way to fail is overflow
+    static bool parseInt(std::string_view digits, int& value) {
+        auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+        return result.ec == std::errc() && result.ptr == digits.data() + digits.size();
+    }
+};
+
+// A jurisdiction's registration rules as compile-time constants. Each
+// jurisdiction derives from the standard rules and overrides what differs;
+// RuleValidator<Rules> then compiles to checks with the limits folded in.
+struct StandardRules : InputValidator::ValidationConfig {
+    static constexpr const char* NAME = "standard";
+};
+
+// Registration from 16, as where the voting age has been lowered
+struct YouthVoteRules : StandardRules {
+    static constexpr const char* NAME = "youth-16";
+    static const int MIN_AGE = 16;
+};
+
+// The checks of InputValidator for one set of rules. All static and inline, so
+// a caller that knows its Rules pays no more than for hand-written checks.
+template <typename Rules>
+class RuleValidator {
+public:
+    using Field = InputValidator::Field;
+    using Problem = InputValidator::Problem;
+    using Failures = InputValidator::Failures;
+
+    // Voter IDs are held in 32 bits (see Voter)
+    static_assert(Rules::UNIQUE_ID_LENGTH <= 9, "unique IDs must fit in an int");
+    static_assert(Rules::MIN_NAME_LENGTH > 0 && Rules::MIN_ADDRESS_LENGTH > 0,
+                  "an empty value has a problem of its own");
+
+    // Letters of any script; lengths count characters, not bytes
+    static Problem checkName(std::string_view name) {
+        name = InputValidator::trimView(name);
+        if (name.empty()) {
+            return Problem::Empty;
+        }
+        // ASCII names, the common case, stay in this loop; the first other
+        // byte hands the whole name to the UTF-8 scan
+        size_t characters = name.size();
+        Utf8Name::Status status = Utf8Name::Status::Valid;
+        for (char c : name) {
+            if (static_cast<unsigned char>(c) >= 0x80) {
+                status = Utf8Name::scan(name, characters);
+                break;
+            }
+            if (!AsciiClass::isAlpha(c) && !AsciiClass::isSpace(c)) {
+                status = Utf8Name::Status::NotALetter;
+            }
+        }
+        if (characters < Rules::MIN_NAME_LENGTH) {
+            return Problem::TooShort;
+        }
+        if (characters > Rules::MAX_NAME_LENGTH) {
+            return Problem::TooLong;
+        }
+        switch (status) {
+            case Utf8Name::Status::IllFormed: return Problem::InvalidEncoding;
+            case Utf8Name::Status::NotALetter: return Problem::InvalidCharacters;
+            default: return Problem::None;
+        }
+    }
+
+    static Problem checkPhoneNumber(std::string_view phone) {
+        return checkDigits(InputValidator::trimView(phone), Rules::PHONE_NUMBER_LENGTH);
+    }
+
+    static Problem checkUniqueId(std::string_view id, int* value = nullptr) {
+        id = InputValidator::trimView(id);
+        Problem problem = checkDigits(id, Rules::UNIQUE_ID_LENGTH);
+        if (problem == Problem::None && value) {
+            AsciiClass::parseInt(id, *value);   // Always fits, as asserted above
+        }
+        return problem;
+    }
+
+    static Problem checkAddress(std::string_view address) {
+        return checkLength(InputValidator::trimView(address), Rules::MIN_ADDRESS_LENGTH, Rules::MAX_ADDRESS_LENGTH);
+    }
+
+    static Problem checkAge(std::string_view ageStr, int* value = nullptr) {
+        ageStr = InputValidator::trimView(ageStr);
+        if (ageStr.empty()) {
+            return Problem::Empty;
+        }
+        if (!AsciiClass::allDigits(ageStr)) {
+            return Problem::InvalidCharacters;
+        }
+        int age;
+        if (!AsciiClass::parseInt(ageStr, age)) {
+            return Problem::Overflow;
+        }
+        if (age < Rules::MIN_AGE) {
+            return Problem::BelowMinimum;
+        }
+        if (age > Rules::MAX_AGE) {
+            return Problem::AboveMaximum;
+        }
+        if (value) {
+            *value = age;
+        }
+        return Problem::None;
+    }
+
+    // Column-at-a-time checkName for bulk loads; see InputValidator::checkNames
+    static InputValidator::RowBitmap checkNames(const std::string_view* values, size_t rows) {
+        return InputValidator::checkNames(values, rows, Rules::MIN_NAME_LENGTH, Rules::MAX_NAME_LENGTH, &checkName);
+    }
+
+    static Failures checkVoterInput(std::string_view firstName, std::string_view lastName,
+                                    std::string_view phone, std::string_view address,
+                                    std::string_view idStr, std::string_view ageStr,
+                                    int* uniqueId = nullptr, int* age = nullptr) {
+        Failures failures = checkVoterFields(phone, address, idStr, ageStr, uniqueId, age);
+        failures.set(Field::FirstName, checkName(firstName));
+        failures.set(Field::LastName, checkName(lastName));
+        return failures;
+    }
+
+    // checkVoterInput without the names, for rows whose names passed checkNames
+    static Failures checkVoterFields(std::string_view phone, std::string_view address,
+                                     std::string_view idStr, std::string_view ageStr,
+                                     int* uniqueId = nullptr, int* age = nullptr) {
+        Failures failures;
+        failures.set(Field::Phone, checkPhoneNumber(phone));
+        failures.set(Field::Address, checkAddress(address));
+        failures.set(Field::UniqueId, checkUniqueId(idStr, uniqueId));
+        failures.set(Field::Age, checkAge(ageStr, age));
+        return failures;
+    }
+
+    // "[ERROR] ..." text quoting these rules' limits; empty for Problem::None
+    static std::string describe(Field field, Problem problem) {
+        if (problem == Problem::None) {
+            return "";
+        }
+        switch (field) {
+            case Field::FirstName:
+            case Field::LastName:
+                return describeName(field == Field::FirstName ? "First name" : "Last name", problem);
+            case Field::Phone:
+                switch (problem) {
+                    case Problem::Empty: return "[ERROR] Phone number cannot be empty.";
+                    case Problem::WrongLength:
+                        return "[ERROR] Phone number must be exactly " + std::to_string(Rules::PHONE_NUMBER_LENGTH) +
+                               " digits long.";
+                    default: return "[ERROR] Phone number must contain only numeric digits.";
+                }
+            case Field::UniqueId:
+                switch (problem) {
+                    case Problem::Empty: return "[ERROR] Unique ID cannot be empty.";
+                    case Problem::WrongLength:
+                        return "[ERROR] Unique ID must be exactly " + std::to_string(Rules::UNIQUE_ID_LENGTH) +
+                               " digits long.";
+                    default: return "[ERROR] Unique ID must contain only numeric digits.";
+                }
+            case Field::Address:
+                switch (problem) {
+                    case Problem::Empty: return "[ERROR] Address cannot be empty.";
+                    case Problem::TooShort:
+                        return "[ERROR] Address must be at least " + std::to_string(Rules::MIN_ADDRESS_LENGTH) +
+                               " characters long.";
+                    default:
+                        return "[ERROR] Address must not exceed " + std::to_string(Rules::MAX_ADDRESS_LENGTH) +
+                               " characters.";
+                }
+            case Field::Age:
+                switch (problem) {
+                    case Problem::Empty: return "[ERROR] Age cannot be empty.";
+                    case Problem::InvalidCharacters: return "[ERROR] Age must be a valid number (digits only).";
+                    case Problem::BelowMinimum:
+                        return "[ERROR] You must be at least " + std::to_string(Rules::MIN_AGE) +
+                               " years old to register.";
+                    case Problem::AboveMaximum:
+                        return "[ERROR] Age must not exceed " + std::to_string(Rules::MAX_AGE) + " years.";
+                    default: return "[ERROR] Age contains invalid characters or is too large.";
+                }
+        }
+        return "[ERROR] Invalid input.";
+    }
+
+    // One "[ERROR] ..." line per failing field
+    static std::string describe(const Failures& failures) {
+        std::string errors;
+        for (size_t i = 0; i < InputValidator::FIELD_COUNT; ++i) {
+            Field field = static_cast<Field>(i);
+            if (failures.get(field) != Problem::None) {
+                errors += describe(field, failures.get(field));
+                errors += "\n";
+            }
+        }
+        return errors;
+    }
+
+    static std::string describeName(const std::string& fieldName, Problem problem) {
+        switch (problem) {
+            case Problem::None:
+                return ""; // No errors
+            case Problem::Empty:
+                return "[ERROR] " + fieldName + " cannot be empty.";
+            case Problem::TooShort:
+                return "[ERROR] " + fieldName + " must be at least " +
+                       std::to_string(Rules::MIN_NAME_LENGTH) + " characters long.";
+            case Problem::TooLong:
+                return "[ERROR] " + fieldName + " must not exceed " +
+                       std::to_string(Rules::MAX_NAME_LENGTH) + " characters.";
+            case Problem::InvalidEncoding:
+                return "[ERROR] " + fieldName + " is not valid UTF-8 text.";
+            default:
+                return "[ERROR] " + fieldName + " must contain only alphabetic characters and spaces.";
+        }
+    }
+
+private:
+    static Problem checkDigits(std::string_view text, size_t length) {
+        if (text.empty()) {
+            return Problem::Empty;
+        }
+        if (text.size() != length) {
+            return Problem::WrongLength;
+        }
+        return AsciiClass::allDigits(text) ? Problem::None : Problem::InvalidCharacters;
+    }
+
+    static Problem checkLength(std::string_view text, size_t min, size_t max) {
+        if (text.empty()) {
+            return Problem::Empty;
+        }
+        if (text.size() < min) {
+            return Problem::TooShort;
+        }
+        return text.size() > max ? Problem::TooLong : Problem::None;
+    }
+};
+
+// The rules an election registers voters under, chosen at runtime by name.
+// Each registered jurisdiction is a RuleValidator behind one virtual call per
+// record, so the registration loop runs the specialized checks rather than
+// reading limits from a table.
+class ValidationRules {
+public:
+    virtual ~ValidationRules() = default;
+
+    virtual const char* getName() const = 0;
+    virtual InputValidator::Failures checkVoterInput(std::string_view firstName, std::string_view lastName,
+                                                     std::string_view phone, std::string_view address,
+                                                     std::string_view idStr, std::string_view ageStr,
+                                                     int* uniqueId = nullptr, int* age = nullptr) const = 0;
+    // For bulk loads: the names of many rows at once, then the other fields of each row
+    virtual InputValidator::RowBitmap checkNames(const std::string_view* values, size_t rows) const = 0;
+    virtual InputValidator::Failures checkVoterFields(std::string_view phone, std::string_view address,
+                                                      std::string_view idStr, std::string_view ageStr,
+                                                      int* uniqueId = nullptr, int* age = nullptr) const = 0;
+    virtual std::string describe(const InputValidator::Failures& failures) const = 0;
+
+    // Registry of the jurisdictions compiled in
+    static const ValidationRules& standard();
+    static const ValidationRules* find(std::string_view name);  // nullptr if unknown
+    static std::vector<std::string> getNames();
+};
+
+template <typename Rules>
+class JurisdictionRules final : public ValidationRules {
+public:
+    const char* getName() const override { return Rules::NAME; }
+
+    InputValidator::Failures checkVoterInput(std::string_view firstName, std::string_view lastName,
+                                             std::string_view phone, std::string_view address,
+                                             std::string_view idStr, std::string_view ageStr,
+                                             int* uniqueId, int* age) const override {
+        return RuleValidator<Rules>::checkVoterInput(firstName, lastName, phone, address, idStr, ageStr,
+                                                     uniqueId, age);
+    }
+
+    InputValidator::RowBitmap checkNames(const std::string_view* values, size_t rows) const override {
+        return RuleValidator<Rules>::checkNames(values, rows);
+    }
+
+    InputValidator::Failures checkVoterFields(std::string_view phone, std::string_view address,
+                                              std::string_view idStr, std::string_view ageStr,
+                                              int* uniqueId, int* age) const override {
+        return RuleValidator<Rules>::checkVoterFields(phone, address, idStr, ageStr, uniqueId, age);
+    }
+
+    std::string describe(const InputValidator::Failures& failures) const override {
+        return RuleValidator<Rules>::describe(failures);
+    }
+};
@@ -1,6 +1,7 @@
 #include "Election.h"
 #include <iostream>
 #include <cassert>
+#include <cstdio>
 #include <memory>
 #include <functional>
 
@@ -109,6 +110,50 @@ public:
         
         return isRegistered && !isNotRegistered;
     }
+    
+    static bool testArenaObjectsOutliveElection() {
+        std::shared_ptr<Region> region;
+        const Voter* firstVoter = nullptr;
+        bool addressesStable = false;
+        {
+            Election election("Arena Election");
+            election.registerVoter("First", "Voter", "5555550001", "1 Arena Road", "300000000", "30");
+            firstVoter = election.getVoters()[0];
+            for (int i = 1; i < 500; ++i) {
+                election.registerVoter("Next", "Voter", "5555550001", "1 Arena Road", std::to_string(300000000 + i), "30");
+            }
+            addressesStable = election.getVoters().size() == 500 && election.getVoters()[0] == firstVoter &&
+                              firstVoter->getUniqueId() == 300000000;
+            region = election.createRegion("Kept District", "KEPT");
+            election.addCandidate("Global Candidate");
+            election.addCandidateToRegion("Kept Candidate", region);
+            election.registerVoterInRegion("Kept", "Voter", "5555550002", "2 Arena Road", "300001000", "40", region);
+        }
+        // The region still holds its voter and candidate after the election is gone
+        return addressesStable && region->getVoters().size() == 1 &&
+               region->getVoters()[0]->getFullName() == "Kept Voter" &&
+               region->getCandidates().size() == 1 && region->getCandidates()[0]->getName() == "Kept Candidate";
+    }
+    
+    static bool testPackedVoterFields() {
+        // Leading zeros survive packing; numbers that are not all digits stay as text
+        Election election("Packed Fields");
+        election.importVoter("Zero", "Lead", "0012345678", "1 Packed Road", 100000001, 120, false);
+        election.importVoter("Dash", "Ed", "555-0100", "2 Packed Road", 100000002, 18, false);
+        const Voter& packed = *election.getVoters()[0];
+        const Voter& text = *election.getVoters()[1];
+        Voter::PhoneDigits digits;
+        bool phones = packed.getPhoneNumber() == "0012345678" && text.getPhoneNumber() == "555-0100" &&
+                      packed.getPersonalDetails(digits).phoneNumber == "0012345678" &&
+                      VoterPiiStore::packPhoneNumber(std::string(18, '9')) == 0 &&
+                      VoterPiiStore::packPhoneNumber("") == 0;
+        
+        election.registerVoter("Nina", "Nine", "0987654321", "9 Packed Road", "999999999", "120");
+        const Voter* voter = election.getVoters()[2];
+        return phones && packed.getAge() == 120 && packed.getUniqueId() == 100000001 &&
+               voter->getUniqueId() == 999999999 && voter->getAge() == 120 &&
+               voter->getPhoneNumber() == "0987654321" && election.isVoterRegistered(999999999);
+    }
 };
 
 // Regional Voting Tests
@@ -229,6 +274,33 @@ public:
         
         return validName && !tooShort;
     }
+    
+    static bool testPerElectionValidationRules() {
+        Election standard("Standard Rules");
+        Election youth("Youth Vote Rules");
+        if (youth.setValidationRules("no-such-rules") || !youth.setValidationRules("youth-16")) {
+            return false;
+        }
+        
+        // Same applicant, different jurisdictions
+        bool standardAccepts = standard.registerVoter("Young", "Voter", "1234567890", "123 Main St", "123456789", "16");
+        bool youthAccepts = youth.registerVoter("Young", "Voter", "1234567890", "123 Main St", "123456789", "16");
+        bool youthRejects = !youth.registerVoter("Younger", "Voter", "1234567891", "123 Main St", "123456788", "15");
+        std::string message = RuleValidator<YouthVoteRules>::describe(InputValidator::Field::Age,
+                                                                      InputValidator::Problem::BelowMinimum);
+        
+        // The choice is saved with the election
+        const std::string filename = "test_validation_rules_snapshot.txt";
+        youth.saveCompleteElectionData(filename);
+        Election reloaded("Reloaded");
+        bool loaded = reloaded.loadCompleteElectionData(filename);
+        std::remove(filename.c_str());
+        
+        return !standardAccepts && youthAccepts && youthRejects &&
+               message == "[ERROR] You must be at least 16 years old to register." &&
+               loaded && std::string(reloaded.getValidationRules().getName()) == "youth-16" &&
+               std::string(standard.getValidationRules().getName()) == "standard";
+    }
 };
 
 int main() {
@@ -246,6 +318,8 @@ int main() {
     runner.runTest("Voter Registration Validation", ElectionCoreTests::testVoterRegistrationValidation);
     runner.runTest("Duplicate Voter Prevention", ElectionCoreTests::testDuplicateVoterPrevention);
     runner.runTest("Voter Registration Check", ElectionCoreTests::testVoterRegistrationCheck);
+    runner.runTest("Arena Objects Outlive Election", ElectionCoreTests::testArenaObjectsOutliveElection);
+    runner.runTest("Packed Voter Fields", ElectionCoreTests::testPackedVoterFields);
     
     // Regional Voting Tests
     std::cout << "\n--- Regional Voting Tests ---\n";
@@ -260,6 +334,7 @@ int main() {
     runner.runTest("ID Validation", ValidationTests::testIdValidation);
     runner.runTest("Age Validation", ValidationTests::testAgeValidation);
     runner.runTest("Name Validation", ValidationTests::testNameValidation);
+    runner.runTest("Per-Election Validation Rules", ValidationTests::testPerElectionValidationRules);
     
     runner.printSummary();
     
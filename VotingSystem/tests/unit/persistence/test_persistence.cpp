@@ -0,0 +1,754 @@
+#include "Election.h"
+#include "CsvExportEngine.h"
+#include "CsvScanner.h"
+#include "CsvVoterImporter.h"
+#include "VoterPiiStore.h"
+#include "Crc32c.h"
+#include "SnapshotVerifier.h"
+#include "LzBlockFile.h"
+#include "LzCodec.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <functional>
+
+// Simple test framework
+class PersistenceTestRunner {
+private:
+    int testsRun = 0;
+    int testsPassed = 0;
+
+public:
+    void runTest(const std::string& testName, std::function<bool()> testFunc) {
+        testsRun++;
+        std::cout << "Running test: " << testName << "... ";
+
+        try {
+            if (testFunc()) {
+                testsPassed++;
+                std::cout << "PASSED\n";
+            } else {
+                std::cout << "FAILED\n";
+            }
+        } catch (const std::exception& e) {
+            std::cout << "FAILED (Exception: " << e.what() << ")\n";
+        }
+    }
+
+    void printSummary() {
+        std::cout << "\n=== Persistence Test Summary ===\n";
+        std::cout << "Tests run: " << testsRun << "\n";
+        std::cout << "Tests passed: " << testsPassed << "\n";
+        std::cout << "Tests failed: " << (testsRun - testsPassed) << "\n";
+        std::cout << "Success rate: " << (testsRun > 0 ? (testsPassed * 100.0 / testsRun) : 0) << "%\n";
+    }
+
+    bool allTestsPassed() const {
+        return testsRun > 0 && testsPassed == testsRun;
+    }
+};
+
+static std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// CSV Export Tests
+class CsvExportTests {
+public:
+    static bool testQuotingDetection() {
+        return !CsvExportEngine::needsQuoting("Plain Name") &&
+               !CsvExportEngine::needsQuoting("") &&
+               CsvExportEngine::needsQuoting("Smith, John") &&
+               CsvExportEngine::needsQuoting("Line\nBreak") &&
+               CsvExportEngine::needsQuoting("A \"quoted\" word") &&
+               CsvExportEngine::needsQuoting("a long field without specials until the end,");
+    }
+
+    static bool testFieldEscaping() {
+        const std::string filename = "test_csv_escaping.csv";
+        {
+            BufferedFileWriter out(filename);
+            CsvExportEngine::writeField(out, "plain");
+            out.put('|');
+            CsvExportEngine::writeField(out, "12 \"Main\" St, Apt 4");
+            out.put('|');
+            CsvExportEngine::writeField(out, "forced", true);
+            out.close();
+        }
+        std::string contents = readFile(filename);
+        std::remove(filename.c_str());
+        return contents == "plain|\"12 \"\"Main\"\" St, Apt 4\"|\"forced\"";
+    }
+
+    static bool testElectionExport() {
+        Election election("CSV Export Test");
+        auto party = election.createParty("Unity Party");
+        election.addCandidate("Alice Johnson", party);
+        election.addCandidate("Bob Smith");
+        election.registerVoter("Carol", "Green", "5555551234", "12 \"Elm\" St, Springfield", "123456789", "30");
+        election.registerVoter("David", "Brown", "5555555678", "34 Oak Avenue", "987654321", "45");
+        election.castVote(123456789, 0);
+        election.castVote(987654321, 0);
+
+        election.exportToCSV("test_csv_export");
+
+        std::string candidates = readFile("test_csv_export_candidates.csv");
+        std::string voters = readFile("test_csv_export_voters.csv");
+        std::string parties = readFile("test_csv_export_parties.csv");
+        std::remove("test_csv_export_candidates.csv");
+        std::remove("test_csv_export_voters.csv");
+        std::remove("test_csv_export_parties.csv");
+
+        return candidates == "Index,Name,Party,Votes,VotePercentage\n"
+                             "0,Alice Johnson,Unity Party,2,100.00\n"
+                             "1,Bob Smith,Independent,0,0.00\n" &&
+               voters == "UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted\n"
+                         "123456789,Carol,Green,30,5555551234,\"12 \"\"Elm\"\" St, Springfield\",Yes\n"
+                         "987654321,David,Brown,45,5555555678,\"34 Oak Avenue\",Yes\n" &&
+               parties == "PartyName,MemberCount,Members\n"
+                          "Unity Party,1,\"Alice Johnson\"\n";
+    }
+
+    static bool testPercentageRounding() {
+        Election election("Rounding Test");
+        election.addCandidate("First");
+        election.addCandidate("Second");
+        election.registerVoter("Ann", "One", "5555550001", "1 First Street", "100000001", "30");
+        election.registerVoter("Ben", "Two", "5555550002", "2 First Street", "100000002", "30");
+        election.registerVoter("Cat", "Three", "5555550003", "3 First Street", "100000003", "30");
+        election.castVote(100000001, 0);
+        election.castVote(100000002, 0);
+        election.castVote(100000003, 1);
+
+        CsvExportEngine engine(election);
+        bool written = engine.writeCandidates("test_csv_rounding.csv");
+        std::string candidates = readFile("test_csv_rounding.csv");
+        std::remove("test_csv_rounding.csv");
+
+        return written &&
+               candidates.find("0,First,Independent,2,66.67\n") != std::string::npos &&
+               candidates.find("1,Second,Independent,1,33.33\n") != std::string::npos;
+    }
+};
+
+// CSV Import Tests
+class CsvImportTests {
+public:
+    static bool testSimdClassificationMatchesScalar() {
+        std::string block = "12,\"Smith, J\"\r\nabcdefghijklmnopqrstuvwxyz,0123456789\n\"\",,,end of block..";
+        block.resize(64, 'x');
+        uint64_t scalar = CsvScanner::classifyBlock(block.data(), CsvScanner::SimdLevel::Scalar);
+        uint64_t sse2 = CsvScanner::classifyBlock(block.data(), CsvScanner::SimdLevel::SSE2);
+        uint64_t avx2 = CsvScanner::classifyBlock(block.data(), CsvScanner::SimdLevel::AVX2);
+        std::cout << "[" << CsvScanner::simdLevelName(CsvScanner::activeSimdLevel()) << "] ";
+        return scalar != 0 && scalar == sse2 && scalar == avx2;
+    }
+
+    static bool testScannerQuotedFields() {
+        std::string csv = "a,\"b,c\",\"say \"\"hi\"\"\"\r\n"
+                          "\"multi\nline\",,last\n"
+                          "tail";
+        CsvScanner scanner(csv);
+        std::vector<std::string_view> fields;
+
+        bool row1 = scanner.nextRow(fields) && fields.size() == 3 &&
+                    fields[0] == "a" && fields[1] == "b,c" && fields[2] == "say \"hi\"";
+        bool row2 = scanner.nextRow(fields) && fields.size() == 3 &&
+                    fields[0] == "multi\nline" && fields[1].empty() && fields[2] == "last";
+        bool row3 = scanner.nextRow(fields) && fields.size() == 1 && fields[0] == "tail";
+        bool done = !scanner.nextRow(fields);
+        return row1 && row2 && row3 && done;
+    }
+
+    static bool testExportImportRoundTrip() {
+        Election source("Round Trip Source");
+        source.addCandidate("Alice Johnson");
+        source.registerVoter("Carol", "Green", "5555551234", "12 \"Elm\" St, Springfield", "123456789", "30");
+        source.registerVoter("David", "Brown", "5555555678", "34 Oak Avenue", "987654321", "45");
+        // A second quoted field needing unescaping, in the same import batch as the first
+        source.registerVoter("Erin", "White", "5555559012", "56 \"Pine\" Road", "555666777", "52");
+        source.castVote(987654321, 0);
+        source.exportToCSV("test_csv_roundtrip");
+
+        Election target("Round Trip Target");
+        CsvVoterImporter importer(target);
+        CsvVoterImporter::Result result = importer.importFile("test_csv_roundtrip_voters.csv");
+        std::remove("test_csv_roundtrip_candidates.csv");
+        std::remove("test_csv_roundtrip_voters.csv");
+        std::remove("test_csv_roundtrip_parties.csv");
+
+        const auto& voters = target.getVoters();
+        return result.fileOpened && result.rowsRead == 3 && result.imported == 3 &&
+               voters.size() == 3 &&
+               voters[0]->getAddress() == "12 \"Elm\" St, Springfield" &&
+               voters[2]->getAddress() == "56 \"Pine\" Road" &&
+               !voters[0]->hasVoted() && voters[1]->hasVoted() &&
+               target.isVoterRegistered(123456789) && target.hasVoterVoted(987654321);
+    }
+
+    static bool testInvalidRowsRejected() {
+        std::string csv = "UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted\n"
+                          "111222333,Ann,Lee,30,5555550001,\"1 Main Street\",No\n"
+                          "12345,Bad,Id,30,5555550002,\"2 Main Street\",No\n"
+                          "111222334,Kid,Young,12,5555550003,\"3 Main Street\",No\n"
+                          "111222333,Dup,Licate,40,5555550004,\"4 Main Street\",No\n"
+                          "111222335,Short,Row\n";
+        Election election("Import Validation");
+        CsvVoterImporter importer(election);
+        CsvVoterImporter::Result result = importer.importBuffer(csv);
+        return result.rowsRead == 5 && result.imported == 1 && result.rejected == 4 &&
+               result.errors.size() == 4 && election.getVoters().size() == 1;
+    }
+
+    static bool testReorderedHeader() {
+        std::string csv = "FirstName,LastName,UniqueId,Phone,Age,HasVoted,Address\n"
+                          "Maria,Lopez,444555666,5555550009,52,Yes,9 River Road\n";
+        Election election("Header Mapping");
+        CsvVoterImporter importer(election);
+        CsvVoterImporter::Result result = importer.importBuffer(csv);
+        const auto& voters = election.getVoters();
+        return result.imported == 1 && voters.size() == 1 &&
+               voters[0]->getUniqueId() == 444555666 && voters[0]->getAge() == 52 &&
+               voters[0]->getAddress() == "9 River Road" && voters[0]->hasVoted();
+    }
+
+    static bool testStagedImport() {
+        std::string csv = "UniqueId,FirstName,LastName,Age,Phone,Address,HasVoted\n";
+        for (int i = 0; i < 5000; ++i) {
+            csv += std::to_string(300000000 + i) + ",Staged,Voter,40,5555550010,\"10 Stage Street\",No\n";
+        }
+        csv += "300000000,Dup,Licate,40,5555550011,\"11 Stage Street\",No\n";
+        csv += "300009999,Teen,Voter,17,5555550012,\"12 Stage Street\",No\n";
+        csv += "12345,Bad,Id,30,5555550013,\"13 Stage Street\",No\n";
+
+        // Staged under the standard rules; the election moves to youth rules before
+        // the rows are applied, so they are checked again and the 17-year-old is accepted
+        Election election("Staged Import");
+        std::vector<std::pair<size_t, size_t>> stageReports, applyReports;
+        CsvVoterImporter::StagedRoll roll;
+        CsvVoterImporter::stageBuffer(roll, csv, election.getValidationRules(),
+                                      [&stageReports](size_t done, size_t total) {
+                                          stageReports.emplace_back(done, total);
+                                      });
+        bool youth = election.setValidationRules("youth-16");
+        bool untouched = election.getVoters().empty();
+        CsvVoterImporter importer(election);
+        CsvVoterImporter::Result result = importer.apply(roll, [&applyReports](size_t done, size_t total) {
+            applyReports.emplace_back(done, total);
+        });
+
+        auto advances = [](const std::vector<std::pair<size_t, size_t>>& reports) {
+            bool ok = reports.size() > 1 && reports.back().first == reports.back().second;
+            for (size_t i = 1; i < reports.size(); ++i) {
+                ok = ok && reports[i - 1].first <= reports[i].first;
+            }
+            return ok;
+        };
+        return youth && untouched && advances(stageReports) && stageReports.back().second == csv.size() &&
+               advances(applyReports) && result.rowsRead == 5003 && result.imported == 5001 &&
+               result.rejected == 2 && result.errors.size() == 2 &&
+               result.errors[0] == "Row 5002: voter ID already registered" &&
+               result.errors[1] == "Row 5004: invalid unique ID" && election.isVoterRegistered(300009999);
+    }
+};
+
+// Region Snapshot Tests
+class RegionSnapshotTests {
+public:
+    static void buildRegionalElection(Election& election) {
+        auto party = election.createParty("River Party");
+        auto north = election.createRegion("North District", "NORTH");
+        auto south = election.createRegion("South District", "SOUTH");
+        election.addCandidateToRegion("Nora North", party, north);
+        election.addCandidateToRegion("Ned North", north);
+        election.addCandidateToRegion("Sam South", south);
+        election.registerVoterInRegion("Anna", "Avery", "5555550101", "1 North Road", "200000001", "30", north);
+        election.registerVoterInRegion("Bill", "Brooks", "5555550102", "2 North Road", "200000002", "41", north);
+        election.registerVoterInRegion("Cara", "Cole", "5555550103", "3 South Road", "200000003", "52", south);
+        election.castVoteInRegion(200000001, 0, north);
+        election.castVoteInRegion(200000003, 0, south);
+    }
+
+    static bool testRegionRoundTrip() {
+        const std::string filename = "test_region_snapshot.txt";
+        {
+            Election source("Regional Snapshot");
+            buildRegionalElection(source);
+            source.saveCompleteElectionData(filename);
+        }
+
+        Election loaded("Empty");
+        bool ok = loaded.loadCompleteElectionData(filename);
+        auto north = loaded.getRegionByCode("NORTH");
+        std::remove(filename.c_str());
+        if (!ok || !north) {
+            return false;
+        }
+        const auto& candidates = north->getCandidates();
+        return north->getName() == "North District" &&
+               candidates.size() == 2 &&
+               candidates[0]->getName() == "Nora North" && candidates[0]->getVoteCount() == 1 &&
+               candidates[0]->getParty() && candidates[0]->getParty()->getName() == "River Party" &&
+               !candidates[1]->getParty() &&
+               north->getVoters().size() == 2 &&
+               north->getVoters()[0]->hasVoted() && !north->getVoters()[1]->hasVoted() &&
+               north->getVoters()[1]->getAddress() == "2 North Road" &&
+               loaded.isVoterInRegion(200000002, north);
+    }
+
+    static bool testRegionsLoadOnDemand() {
+        const std::string filename = "test_region_lazy.txt";
+        {
+            Election source("Lazy Regions");
+            buildRegionalElection(source);
+            source.saveCompleteElectionData(filename);
+        }
+
+        Election loaded("Empty");
+        loaded.loadCompleteElectionData(filename);
+        bool allPending = loaded.getPendingRegionCount() == 2 &&
+                          !loaded.isRegionLoaded("NORTH") && !loaded.isRegionLoaded("SOUTH");
+
+        auto south = loaded.getRegionByCode("SOUTH");
+        bool onlySouth = south && south->getVoters().size() == 1 &&
+                         loaded.isRegionLoaded("SOUTH") && !loaded.isRegionLoaded("NORTH") &&
+                         loaded.getPendingRegionCount() == 1;
+
+        // A new registration must see IDs held in regions that are still on disk,
+        // which the region index answers without reading their blocks
+        bool duplicateRejected = !loaded.registerVoter("Dan", "Dupe", "5555550104", "4 Any Road",
+                                                       "200000001", "33") &&
+                                 loaded.isVoterRegistered(200000002) && !loaded.isRegionLoaded("NORTH");
+        // Looking up a voter reads only the block of the voter's region
+        bool ownerLoaded = loaded.hasVoterVoted(200000001) && loaded.isRegionLoaded("NORTH") &&
+                           loaded.getPendingRegionCount() == 0;
+        std::remove(filename.c_str());
+
+        return allPending && onlySouth && duplicateRejected && ownerLoaded;
+    }
+
+    static bool testResaveOverSourceSnapshot() {
+        const std::string filename = "test_region_resave.txt";
+        {
+            Election source("Resave Regions");
+            buildRegionalElection(source);
+            source.saveCompleteElectionData(filename);
+        }
+        {
+            // Saving over the file the pending blocks live in must not lose them
+            Election middle("Empty");
+            middle.loadCompleteElectionData(filename);
+            middle.saveCompleteElectionData(filename);
+        }
+
+        Election loaded("Empty");
+        loaded.loadCompleteElectionData(filename);
+        auto north = loaded.getRegionByCode("NORTH");
+        auto south = loaded.getRegionByCode("SOUTH");
+        std::remove(filename.c_str());
+
+        return north && south &&
+               north->getVoters().size() == 2 && south->getVoters().size() == 1 &&
+               south->getCandidates().size() == 1 && south->getCandidates()[0]->getVoteCount() == 1;
+    }
+};
+
+// Voter PII Store Tests
+class VoterPiiStoreTests {
+public:
+    static bool testArenaRecords() {
+        VoterPiiStore store;
+        std::string longAddress(400, 'a');
+        auto first = store.append("Ann", "Lee", "5555550001", "1 Main Street");
+        size_t singleRecordBytes = store.arenaBytes();
+        std::vector<VoterPiiStore::Ref> refs;
+        for (int i = 0; i < 500; ++i) {
+            refs.push_back(store.append("Name" + std::to_string(i), "", "5555550002", longAddress));
+        }
+
+        // All-digit phone numbers are packed and come back through the digits buffer
+        VoterPiiStore::PhoneDigits digits, lastDigits, textDigits;
+        VoterPiiStore::Record record = store.get(first, digits);
+        VoterPiiStore::Record last = store.get(refs.back(), lastDigits);
+        VoterPiiStore::Record text = store.get(store.append("Tex", "Tee", "555-0100", "2 Main Street"), textDigits);
+        return singleRecordBytes < 64 &&
+               record.firstName == "Ann" && record.lastName == "Lee" &&
+               record.phoneNumber == "5555550001" && record.address == "1 Main Street" &&
+               last.firstName == "Name499" && last.lastName.empty() && last.address == longAddress &&
+               last.phoneNumber == "5555550002" && text.phoneNumber == "555-0100" &&
+               text.address == "2 Main Street" && store.get(refs[0], digits).firstName == "Name0";
+    }
+
+    static bool testLoadedDetailsSurviveResave() {
+        const std::string filename = "test_pii_snapshot.txt";
+        {
+            Election source("PII Snapshot");
+            source.registerVoter("Carol", "Green", "5555551234", "12 Elm Street", "123456789", "30");
+            source.registerVoter("David", "Brown", "5555555678", "34 Oak Avenue", "987654321", "45");
+            source.castVote(987654321, 0);
+            source.saveCompleteElectionData(filename);
+        }
+
+        Election loaded("Empty");
+        loaded.loadCompleteElectionData(filename);
+        // Replacing the snapshot must not disturb details still read from the old file
+        loaded.saveCompleteElectionData(filename);
+        const auto& voters = loaded.getVoters();
+        bool intact = voters.size() == 2 &&
+                      voters[0]->getFullName() == "Carol Green" &&
+                      voters[0]->getPhoneNumber() == "5555551234" &&
+                      voters[1]->getAddress() == "34 Oak Avenue" &&
+                      voters[1]->getUniqueId() == 987654321 && voters[1]->getAge() == 45;
+
+        Election reloaded("Empty");
+        reloaded.loadCompleteElectionData(filename);
+        std::remove(filename.c_str());
+        return intact && reloaded.getVoters().size() == 2 &&
+               reloaded.getVoters()[1]->getLastName() == "Brown";
+    }
+
+    static bool testReorderedVoterLines() {
+        const std::string filename = "test_pii_reordered.txt";
+        {
+            std::ofstream file(filename);
+            file << "COMPLETE_ELECTION_DATA\n\n[ELECTION_INFO]\nTitle=Hand Edited\n\n[VOTERS]\n"
+                 << "Voter0_UniqueId=111222333\nVoter0_LastName=Lee\nVoter0_FirstName=Ann\n"
+                 << "Voter0_Age=30\nVoter0_Address=1 Main Street\nVoter0_Phone=5555550001\n"
+                 << "Voter0_HasVoted=1\n";
+        }
+        Election loaded("Empty");
+        loaded.loadCompleteElectionData(filename);
+        std::remove(filename.c_str());
+
+        const auto& voters = loaded.getVoters();
+        return voters.size() == 1 && voters[0]->getFirstName() == "Ann" &&
+               voters[0]->getLastName() == "Lee" && voters[0]->getAddress() == "1 Main Street" &&
+               voters[0]->getPhoneNumber() == "5555550001" && voters[0]->hasVoted();
+    }
+};
+
+// Checksum Tests
+class ChecksumTests {
+public:
+    static void writeFile(const std::string& filename, const std::string& contents) {
+        std::ofstream file(filename, std::ios::binary);
+        file << contents;
+    }
+
+    static bool testCrc32cKnownValues() {
+        const std::string check = "123456789";
+        uint32_t whole = Crc32c::compute(check.data(), check.size());
+        uint32_t first = Crc32c::compute(check.data(), 5);
+        uint32_t second = Crc32c::compute(check.data() + 5, 4);
+        std::cout << "[" << (Crc32c::isHardwareAccelerated() ? "hardware" : "software") << "] ";
+        return whole == 0xE3069283 &&
+               Crc32c::compute(check.data() + 5, 4, first) == whole &&
+               Crc32c::combine(first, second, 4) == whole &&
+               Crc32c::compute("", 0) == 0;
+    }
+
+    static bool testSnapshotVerifies() {
+        const std::string filename = "test_checksum_snapshot.txt";
+        Election election("Checksum Test");
+        RegionSnapshotTests::buildRegionalElection(election);
+        election.registerVoter("Carol", "Green", "5555551234", "12 Elm Street", "123456789", "30");
+        election.saveCompleteElectionData(filename);
+
+        SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(filename);
+        // Tiny chunks force the parallel split-and-combine path
+        SnapshotVerifier::Options options;
+        options.threads = 4;
+        options.chunkSize = 64;
+        SnapshotVerifier::Report chunked = SnapshotVerifier(options).verifyFile(filename);
+        std::remove(filename.c_str());
+
+        // Five sections, the region index and two region blocks
+        return report.ok() && report.blocksChecked == 8 && report.blocksUnchecked == 0 &&
+               chunked.ok() && chunked.blocksChecked == 8;
+    }
+
+    static bool testCorruptSectionRejected() {
+        const std::string filename = "test_checksum_corrupt.txt";
+        {
+            Election source("Corrupt Test");
+            source.registerVoter("Carol", "Green", "5555551234", "12 Elm Street", "123456789", "30");
+            source.saveCompleteElectionData(filename);
+        }
+        std::string contents = readFile(filename);
+        contents[contents.find("Voter0_Age=30") + 11] = '9';
+        writeFile(filename, contents);
+
+        SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(filename);
+        Election target("Keep Me");
+        target.registerVoter("David", "Brown", "5555555678", "34 Oak Avenue", "987654321", "45");
+        bool loaded = target.loadCompleteElectionData(filename);
+        std::remove(filename.c_str());
+
+        return !report.ok() && report.failures.size() == 1 && report.failures[0].name == "VOTERS" &&
+               !loaded && target.getTitle() == "Keep Me" && target.getVoters().size() == 1;
+    }
+
+    static bool testTruncatedSnapshotRejected() {
+        const std::string filename = "test_checksum_truncated.txt";
+        {
+            Election source("Truncation Test");
+            for (int i = 0; i < 20; ++i) {
+                source.importVoter("Tess", "Torn", "5555550100", "1 Torn Road", 400000000 + i, 30, false);
+            }
+            source.saveCompleteElectionData(filename);
+        }
+        std::string contents = readFile(filename);
+        size_t votersEnd = contents.find("Checksum=", contents.find("[VOTERS]"));
+        size_t afterVoters = contents.find('\n', votersEnd) + 1;
+
+        // Cut inside the voters, then exactly at a block boundary
+        bool allRejected = true;
+        for (size_t length : {contents.find("Voter10_FirstName"), afterVoters}) {
+            writeFile(filename, contents.substr(0, length));
+            SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(filename);
+            Election target("Keep Me");
+            bool loaded = target.loadCompleteElectionData(filename);
+            allRejected = allRejected && !report.ok() && !report.failures.empty() &&
+                          report.failures.back().truncated && !loaded && target.getTitle() == "Keep Me";
+        }
+        std::remove(filename.c_str());
+        return allRejected;
+    }
+
+    static bool testCorruptRegionBlockNotLoaded() {
+        const std::string filename = "test_checksum_region.txt";
+        {
+            Election source("Region Corruption");
+            RegionSnapshotTests::buildRegionalElection(source);
+            source.saveCompleteElectionData(filename);
+        }
+        std::string contents = readFile(filename);
+        size_t south = contents.find("[REGION:SOUTH]");
+        contents[contents.find("3 South Road", south)] = '8';
+        writeFile(filename, contents);
+
+        Election loaded("Empty");
+        bool ok = loaded.loadCompleteElectionData(filename);
+        auto north = loaded.getRegionByCode("NORTH");
+        auto southRegion = loaded.getRegionByCode("SOUTH");
+        std::remove(filename.c_str());
+
+        return ok && north && north->getVoters().size() == 2 &&
+               southRegion && southRegion->getVoters().empty();
+    }
+
+    static bool testUnchecksummedSnapshotAccepted() {
+        const std::string filename = "test_checksum_legacy.txt";
+        writeFile(filename, "COMPLETE_ELECTION_DATA\n\n[ELECTION_INFO]\nTitle=Legacy\n\n"
+                            "[CANDIDATES]\nCandidate0_Name=Old Timer\nCandidate0_Votes=3\n"
+                            "Candidate0_Party=Independent\n");
+        SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(filename);
+        Election loaded("Empty");
+        bool ok = loaded.loadCompleteElectionData(filename);
+        std::remove(filename.c_str());
+
+        return report.ok() && report.blocksChecked == 0 && report.blocksUnchecked == 2 &&
+               ok && loaded.getTitle() == "Legacy" && loaded.getCandidates().size() == 1;
+    }
+};
+
+// Compression Tests
+class CompressionTests {
+public:
+    static bool roundTrips(const std::string& input) {
+        std::string compressed;
+        LzCodec::compress(input, compressed);
+        std::string output(input.size(), '\0');
+        return compressed.size() <= LzCodec::maxCompressedSize(input.size()) &&
+               LzCodec::decompress(compressed, &output[0], output.size()) && output == input;
+    }
+
+    static void registerManyVoters(Election& election, int count) {
+        for (int i = 0; i < count; ++i) {
+            std::string id = std::to_string(300000000 + i);
+            std::string phone = std::to_string(5550000000LL + i);
+            election.registerVoter("Voter", "Number", phone, std::to_string(i) + " Long Street", id, "40");
+        }
+    }
+
+    static bool testCodecRoundTrip() {
+        std::string repetitive;
+        for (int i = 0; i < 5000; ++i) {
+            repetitive += "Voter" + std::to_string(i) + "_FirstName=Anna\n";
+        }
+        std::string noise;
+        uint32_t state = 12345;
+        for (int i = 0; i < 100000; ++i) {
+            state = state * 1103515245u + 12345u;
+            noise += static_cast<char>(state >> 24);
+        }
+        std::string compressed;
+        LzCodec::compress(repetitive, compressed);
+
+        return roundTrips("") && roundTrips("a") && roundTrips("short text") &&
+               roundTrips(std::string(100000, 'x')) && roundTrips(repetitive) && roundTrips(noise) &&
+               compressed.size() * 4 < repetitive.size();
+    }
+
+    static bool testMalformedInputRejected() {
+        std::string input(50000, 'z');
+        input += "tail of the block";
+        std::string compressed;
+        LzCodec::compress(input, compressed);
+        std::string output(input.size(), '\0');
+
+        std::string truncated = compressed.substr(0, compressed.size() / 2);
+        std::string badOffset = compressed;
+        badOffset[2] = static_cast<char>(0xFF);   // First match points before the output
+        badOffset[3] = static_cast<char>(0xFF);
+        return !LzCodec::decompress(truncated, &output[0], output.size()) &&
+               !LzCodec::decompress(badOffset, &output[0], output.size()) &&
+               !LzCodec::decompress(compressed, &output[0], output.size() - 1);
+    }
+
+    static bool testCompressedSnapshotRoundTrip() {
+        const std::string plainFile = "test_compressed_snapshot.txt";
+        const std::string compressedFile = "test_compressed_snapshot.txt.cblz";
+        {
+            Election source("Compressed Snapshot");
+            RegionSnapshotTests::buildRegionalElection(source);
+            registerManyVoters(source, 2000);   // Spans several container blocks
+            source.saveCompleteElectionData(plainFile);
+            source.saveCompleteElectionData(compressedFile);
+        }
+        std::string plain = readFile(plainFile);
+        std::string compressed = readFile(compressedFile);
+
+        Election loaded("Empty");
+        bool ok = loaded.loadCompleteElectionData(compressedFile);
+        auto south = loaded.getRegionByCode("SOUTH");
+        SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(compressedFile);
+        std::string decoded;
+        bool decodedOk = LzBlockFile::decompress(compressed, decoded);
+        std::remove(plainFile.c_str());
+        std::remove(compressedFile.c_str());
+
+        // The voter list holds the three regional voters after the 2000 global ones
+        return ok && LzBlockFile::isCompressed(compressed) && compressed.size() * 3 < plain.size() &&
+               decodedOk && decoded == plain &&
+               loaded.getVoters().size() == 2003 &&
+               loaded.getVoters()[1999]->getAddress() == "1999 Long Street" &&
+               south && south->getVoters().size() == 1 && south->getVoters()[0]->getFirstName() == "Cara" &&
+               report.ok() && report.compressed && report.blocksChecked == 8;
+    }
+
+    static bool testDamagedCompressedSnapshotRejected() {
+        const std::string filename = "test_damaged_snapshot.cblz";
+        {
+            Election source("Damaged");
+            registerManyVoters(source, 100);
+            source.saveCompleteElectionData(filename);
+        }
+        std::string compressed = readFile(filename);
+        std::string flipped = compressed;
+        flipped[flipped.size() / 2] ^= 0x20;
+
+        Election target("Keep Me");
+        target.registerVoter("David", "Brown", "5555555678", "34 Oak Avenue", "987654321", "45");
+        ChecksumTests::writeFile(filename, flipped);
+        bool loadedFlipped = target.loadCompleteElectionData(filename);
+        ChecksumTests::writeFile(filename, compressed.substr(0, compressed.size() - 12));
+        bool loadedTruncated = target.loadCompleteElectionData(filename);
+        SnapshotVerifier::Report report = SnapshotVerifier().verifyFile(filename);
+        std::remove(filename.c_str());
+
+        // A header claiming a block larger than BLOCK_SIZE is refused, even with an intact CRC
+        std::string oversized(LzBlockFile::BLOCK_SIZE + 1, 'x');
+        std::string forged(LzBlockFile::MAGIC);
+        for (uint32_t field : {static_cast<uint32_t>(oversized.size()),
+                               static_cast<uint32_t>(oversized.size()) | LzBlockFile::STORED_FLAG,
+                               Crc32c::compute(oversized.data(), oversized.size())}) {
+            for (int i = 0; i < 4; ++i) {
+                forged += static_cast<char>(field >> (8 * i));
+            }
+        }
+        forged += oversized;
+        LzBlockFile::appendEndMarker(forged);
+        std::string decoded;
+        bool forgedDecoded = LzBlockFile::decompress(forged, decoded);
+
+        return !loadedFlipped && !loadedTruncated && !report.ok() && !forgedDecoded &&
+               target.getTitle() == "Keep Me" && target.getVoters().size() == 1;
+    }
+
+    static bool testCompressedCsvExportImport() {
+        Election source("Compressed Export");
+        registerManyVoters(source, 300);
+        source.exportToCSV("test_compressed_export", true);
+
+        std::string voters = readFile("test_compressed_export_voters.csv.cblz");
+        Election target("Import Target");
+        CsvVoterImporter importer(target);
+        CsvVoterImporter::Result result = importer.importFile("test_compressed_export_voters.csv.cblz");
+        std::remove("test_compressed_export_candidates.csv.cblz");
+        std::remove("test_compressed_export_voters.csv.cblz");
+        std::remove("test_compressed_export_parties.csv.cblz");
+
+        return LzBlockFile::isCompressed(voters) && result.imported == 300 && result.rejected == 0 &&
+               target.getVoters().size() == 300;
+    }
+};
+
+int main() {
+    std::cout << "=== ClearBallot Persistence Tests ===\n\n";
+
+    PersistenceTestRunner runner;
+
+    // CSV Export Tests
+    std::cout << "--- CSV Export Tests ---\n";
+    runner.runTest("Quoting Detection", CsvExportTests::testQuotingDetection);
+    runner.runTest("Field Escaping", CsvExportTests::testFieldEscaping);
+    runner.runTest("Election Export", CsvExportTests::testElectionExport);
+    runner.runTest("Percentage Rounding", CsvExportTests::testPercentageRounding);
+
+    // CSV Import Tests
+    std::cout << "\n--- CSV Import Tests ---\n";
+    runner.runTest("SIMD Classification Matches Scalar", CsvImportTests::testSimdClassificationMatchesScalar);
+    runner.runTest("Scanner Quoted Fields", CsvImportTests::testScannerQuotedFields);
+    runner.runTest("Export/Import Round Trip", CsvImportTests::testExportImportRoundTrip);
+    runner.runTest("Invalid Rows Rejected", CsvImportTests::testInvalidRowsRejected);
+    runner.runTest("Reordered Header", CsvImportTests::testReorderedHeader);
+    runner.runTest("Staged Import", CsvImportTests::testStagedImport);
+
+    // Region Snapshot Tests
+    std::cout << "\n--- Region Snapshot Tests ---\n";
+    runner.runTest("Region Round Trip", RegionSnapshotTests::testRegionRoundTrip);
+    runner.runTest("Regions Load On Demand", RegionSnapshotTests::testRegionsLoadOnDemand);
+    runner.runTest("Resave Over Source Snapshot", RegionSnapshotTests::testResaveOverSourceSnapshot);
+
+    // Voter PII Store Tests
+    std::cout << "\n--- Voter PII Store Tests ---\n";
+    runner.runTest("Arena Records", VoterPiiStoreTests::testArenaRecords);
+    runner.runTest("Loaded Details Survive Resave", VoterPiiStoreTests::testLoadedDetailsSurviveResave);
+    runner.runTest("Reordered Voter Lines", VoterPiiStoreTests::testReorderedVoterLines);
+
+    // Checksum Tests
+    std::cout << "\n--- Checksum Tests ---\n";
+    runner.runTest("CRC32C Known Values", ChecksumTests::testCrc32cKnownValues);
+    runner.runTest("Snapshot Verifies", ChecksumTests::testSnapshotVerifies);
+    runner.runTest("Corrupt Section Rejected", ChecksumTests::testCorruptSectionRejected);
+    runner.runTest("Truncated Snapshot Rejected", ChecksumTests::testTruncatedSnapshotRejected);
+    runner.runTest("Corrupt Region Block Not Loaded", ChecksumTests::testCorruptRegionBlockNotLoaded);
+    runner.runTest("Unchecksummed Snapshot Accepted", ChecksumTests::testUnchecksummedSnapshotAccepted);
+
+    // Compression Tests
+    std::cout << "\n--- Compression Tests ---\n";
+    runner.runTest("Codec Round Trip", CompressionTests::testCodecRoundTrip);
+    runner.runTest("Malformed Input Rejected", CompressionTests::testMalformedInputRejected);
+    runner.runTest("Compressed Snapshot Round Trip", CompressionTests::testCompressedSnapshotRoundTrip);
+    runner.runTest("Damaged Compressed Snapshot Rejected", CompressionTests::testDamagedCompressedSnapshotRejected);
+    runner.runTest("Compressed CSV Export Import", CompressionTests::testCompressedCsvExportImport);
+
+    runner.printSummary();
+
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -298,6 +298,27 @@ public:
         
         return true; // System should handle voter region consistency
     }
+    
+    static bool testRegionalVotersInElectionVoterList() {
+        auto election = createTestElection();
+        auto northRegion = election->getRegionByCode("NORTH");
+        election->addCandidate("Global Candidate");
+        election->addCandidateToRegion("North Candidate", northRegion);
+        election->registerVoter("Global", "Voter", "5551110000", "1 Global Road", "410000001", "30");
+        election->registerVoterInRegion("North", "Voter", "5551110001", "2 North Road", "410000002", "40", northRegion);
+        
+        // Regional voters appear wherever the election lists or looks up voters
+        const auto& voters = election->getVoters();
+        bool listed = voters.size() == 2 && voters[1]->getUniqueId() == 410000002 &&
+                      voters[1]->getRegion() == northRegion &&
+                      election->isVoterRegistered(410000002) && !election->hasVoterVoted(410000002);
+        
+        // A regional voter votes in their region only, and the vote is seen from the election
+        bool globalBallotRejected = !election->castVote(410000002, 0);
+        bool regionalBallot = election->castVoteInRegion(410000002, 0, northRegion);
+        return listed && globalBallotRejected && regionalBallot && election->hasVoterVoted(410000002) &&
+               northRegion->getVoters().size() == 1 && northRegion->getVoters()[0] == voters[1];
+    }
 };
 
 // Complex Regional Scenarios
@@ -435,6 +456,7 @@ int main() {
     runner.runTest("Voter Can Only Vote In Assigned Region", VoterRegionTests::testVoterCanOnlyVoteInAssignedRegion);
     runner.runTest("Cross Region Voting Prevention", VoterRegionTests::testCrossRegionVotingPrevention);
     runner.runTest("Voter Region Reassignment", VoterRegionTests::testVoterRegionReassignment);
+    runner.runTest("Regional Voters In Election Voter List", VoterRegionTests::testRegionalVotersInElectionVoterList);
     
     // Complex Regional Tests
     std::cout << "\n--- Complex Regional Tests ---\n";
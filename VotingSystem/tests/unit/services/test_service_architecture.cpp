@@ -1,11 +1,32 @@
 #include "ClearBallotService.h"
 #include "ServiceClient.h"
+#include "RpcProtocol.h"
+#include "RpcServer.h"
+#include "HttpServer.h"
+#include "WorkStealingExecutor.h"
+#include "VoteBatcher.h"
+#include "AdmissionController.h"
+#include "BackgroundJobs.h"
+#include "ElectionDirectory.h"
+#include "HttpApi.h"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <atomic>
 #include <functional>
+#include <future>
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
 
 // Simple test framework
 class ServiceTestRunner {
@@ -166,6 +187,216 @@ public:
         
         return response1.success && response2.success && hasElection;
     }
+    
+    static bool testElectionDirectoryLookups() {
+        ElectionDirectory directory;
+        const int total = static_cast<int>(ElectionDirectory::CHUNK_SIZE * 3 + 5);   // Spans several chunks
+        std::atomic<bool> done{false};
+        std::atomic<bool> consistent{true};
+        
+        // Readers race the writer; every entry they see must be complete
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&, r]() {
+                while (!done.load()) {
+                    for (int id = 1 + r; id <= total; id += 97) {
+                        ElectionDirectory::Entry* entry = directory.find(id);
+                        if (entry && (entry->id != id || !entry->election)) {
+                            consistent = false;
+                        }
+                    }
+                }
+            });
+        }
+        for (int id = 1; id <= total; ++id) {
+            directory.add(id, std::make_shared<Election>("Directory " + std::to_string(id)));
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        
+        int visited = 0;
+        directory.forEach([&](ElectionDirectory::Entry&) { ++visited; });
+        bool duplicateRefused = directory.add(7, std::make_shared<Election>("Again")) == nullptr;
+        bool outOfRange = !directory.find(0) && !directory.find(-3) && !directory.find(total + 1) &&
+                          !directory.find(ElectionDirectory::MAX_ID + 1) &&
+                          !directory.add(ElectionDirectory::MAX_ID + 1, std::make_shared<Election>("Too far"));
+        return consistent.load() && visited == total && directory.getHighestId() == total &&
+               directory.find(total)->election->getTitle() == "Directory " + std::to_string(total) &&
+               duplicateRefused && outOfRange;
+    }
+    
+    static bool testColdElectionsEvictedAndReloaded() {
+        std::vector<std::string> spillFiles;
+        bool reloadedCorrectly = false;
+        bool stopFailed = false;
+        ClearBallotService::ResidencyStats squeezed;
+        ClearBallotService::ResidencyStats after;
+        {
+            ClearBallotService service;
+            service.startService();
+            std::vector<int> ids;
+            for (int e = 0; e < 4; ++e) {
+                int id = service.createElection("Municipal " + std::to_string(e));
+                service.addCandidate(id, "Mayor " + std::to_string(e));
+                for (int v = 0; v < 50; ++v) {
+                    service.registerVoter(id, VoterRegistrationData("Cold", "Voter", "5555550109", "9 Spill Way",
+                                                                    std::to_string(830000000 + e * 100 + v), "39"));
+                }
+                service.castVote(id, 830000000 + e * 100, 0);
+                ids.push_back(id);
+                spillFiles.push_back("./election_" + std::to_string(id) + "_evicted.txt");
+            }
+            
+            // A budget smaller than two elections leaves only the most recently used resident
+            size_t oneElection = service.getResidencyStats().residentBytes / 4;
+            ClearBallotService::EvictionOptions options;
+            options.memoryBudgetBytes = oneElection + oneElection / 2;
+            service.setEvictionOptions(options);
+            service.getCandidates(ids[3]);
+            squeezed = service.getResidencyStats();
+            
+            // The oldest election comes back on its next request with its votes intact
+            bool voted = service.castVote(ids[0], 830000001, 0).success;
+            ServiceResponse results = service.getElectionResults(ids[0]);
+            after = service.getResidencyStats();
+            reloadedCorrectly = voted && results.success && results.data.size() == 1 &&
+                                results.data[0] == "Mayor 0: 2 votes" &&
+                                service.checkVoterRegistration(ids[0], 830000049).success;
+            
+            // An evicted election whose spill file is gone fails its shutdown save
+            // instead of leaving an empty snapshot behind
+            int lost = 0;
+            for (int id : ids) {
+                ServiceResponse usage = service.getMemoryUsage(id);
+                if (usage.success && !usage.data.empty() && usage.data[0] == "Resident: No") {
+                    lost = id;
+                }
+            }
+            std::remove(("./election_" + std::to_string(lost) + "_evicted.txt").c_str());
+            std::string lostSnapshot = "election_" + std::to_string(lost) + "_shutdown.txt";
+            std::remove(lostSnapshot.c_str());   // Left by an earlier run
+            stopFailed = lost != 0 && !service.stopService() && !std::ifstream(lostSnapshot).good() &&
+                         !std::ifstream(lostSnapshot + ".tmp").good();
+            for (int id : ids) {
+                std::remove(("election_" + std::to_string(id) + "_shutdown.txt").c_str());
+            }
+        }
+        
+        bool spillsRemoved = true;
+        for (const auto& file : spillFiles) {
+            spillsRemoved = spillsRemoved && !std::ifstream(file).good();
+        }
+        return squeezed.evicted >= 2 && squeezed.resident >= 1 && squeezed.evictions >= 2 &&
+               after.reloads >= 1 && reloadedCorrectly && stopFailed && spillsRemoved;
+    }
+    
+    static bool testPerElectionMemoryAccounting() {
+        auto bytesOf = [](const ServiceResponse& usage, const std::string& category) -> long long {
+            for (const auto& line : usage.data) {
+                if (line.compare(0, category.size() + 2, category + ": ") == 0) {
+                    return std::stoll(line.substr(category.size() + 2));
+                }
+            }
+            return -1;
+        };
+        
+        ClearBallotService service;
+        service.startService();
+        int small = service.createElection("Memory Small");
+        int large = service.createElection("Memory Large");
+        for (int v = 0; v < 200; ++v) {
+            service.registerVoter(large, VoterRegistrationData("Counted", "Voter", "5555550110", "10 Ledger Lane",
+                                                               std::to_string(840000000 + v), "41"));
+        }
+        
+        ServiceResponse smallUsage = service.getMemoryUsage(small);
+        ServiceResponse largeUsage = service.getMemoryUsage(large);
+        long long sum = 0;
+        for (const char* category : {"Voters", "Personal details", "Candidates", "Regions", "Indexes", "Other"}) {
+            sum += bytesOf(largeUsage, category);
+        }
+        bool accounted = smallUsage.success && largeUsage.success &&
+                         bytesOf(largeUsage, "Voters") > bytesOf(smallUsage, "Voters") &&
+                         bytesOf(largeUsage, "Personal details") > bytesOf(smallUsage, "Personal details") &&
+                         bytesOf(largeUsage, "Indexes") > bytesOf(smallUsage, "Indexes") &&
+                         bytesOf(largeUsage, "Total") == sum &&
+                         service.getMemoryUsage(9999).success == false;
+        
+        // Once evicted the election is reported from disk without being reloaded
+        ClearBallotService::EvictionOptions options;
+        options.memoryBudgetBytes = 1;
+        service.setEvictionOptions(options);
+        service.getCandidates(small);
+        uint64_t reloads = service.getResidencyStats().reloads;
+        ServiceResponse evicted = service.getMemoryUsage(large);
+        bool reportedEvicted = evicted.success && !evicted.data.empty() && evicted.data[0] == "Resident: No" &&
+                               bytesOf(evicted, "On disk") > 0 &&
+                               service.getElectionTitle(large) == "Memory Large" &&
+                               service.getResidencyStats().reloads == reloads;
+        
+        service.stopService();
+        std::remove(("election_" + std::to_string(small) + "_shutdown.txt").c_str());
+        std::remove(("election_" + std::to_string(large) + "_shutdown.txt").c_str());
+        return accounted && reportedEvicted;
+    }
+    
+    static bool testParallelShutdownPersistence() {
+        auto service = std::make_unique<ClearBallotService>();
+        ShutdownCoordinator::Options options;
+        options.workerThreads = 3;
+        options.deadline = std::chrono::seconds(10);
+        service->setShutdownOptions(options);
+        service->startService();
+        
+        std::vector<int> electionIds;
+        for (int i = 0; i < 6; ++i) {
+            electionIds.push_back(service->createElection("Shutdown Election " + std::to_string(i)));
+        }
+        
+        bool stopped = service->stopService();
+        
+        // Every election must have been flushed to its shutdown snapshot
+        bool allSaved = true;
+        for (int electionId : electionIds) {
+            std::string filename = "election_" + std::to_string(electionId) + "_shutdown.txt";
+            std::ifstream file(filename);
+            allSaved = allSaved && file.is_open();
+            file.close();
+            std::remove(filename.c_str());
+        }
+        
+        // Intake is closed once shutdown has begun
+        auto rejected = service->castVote(electionIds.front(), 123456789, 0);
+        
+        return stopped && allSaved && !service->isAcceptingRequests() && !rejected.success;
+    }
+    
+    static bool testFailedShutdownSaveKeepsSnapshot() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.createElection("Unsaved");
+        std::string filename = "election_" + std::to_string(electionId) + "_shutdown.txt";
+        std::string tempFilename = filename + ".tmp";
+        
+        // A good snapshot from an earlier run with a stale temporary beside it; the
+        // save itself writes through tempFilename + ".tmp", which a directory blocks
+        std::ofstream(filename) << "Earlier snapshot\n";
+        std::ofstream(tempFilename) << "Stale\n";
+        std::string blocked = tempFilename + ".tmp";
+        mkdir(blocked.c_str(), 0700);
+        
+        bool stopped = service.stopService();
+        std::ifstream snapshot(filename);
+        std::string kept;
+        std::getline(snapshot, kept);
+        bool tempRemoved = !std::ifstream(tempFilename).good();
+        rmdir(blocked.c_str());
+        std::remove(filename.c_str());
+        std::remove(tempFilename.c_str());
+        return !stopped && kept == "Earlier snapshot" && tempRemoved;
+    }
 };
 
 // ServiceClient Tests
@@ -269,6 +500,1068 @@ public:
     }
 };
 
+// RPC socket server and remote ServiceClient Tests
+class RpcTests {
+public:
+    static bool testProtocolRoundTrip() {
+        ServiceResponse original(true, "Voter status retrieved.");
+        original.data = {"Registered: Yes", "", "Has Voted: No"};
+        original.retryAfterMs = 250;
+        std::string frame;
+        RpcProtocol::encodeResponse(42, original, frame);
+        
+        std::string_view payload;
+        size_t frameSize = 0;
+        bool complete = RpcProtocol::nextFrame(frame, payload, frameSize) == RpcProtocol::FrameStatus::Complete;
+        ServiceResponse decoded;
+        uint32_t requestId = 0;
+        bool roundTrip = complete && frameSize == frame.size() &&
+                         RpcProtocol::decodeResponse(payload, requestId, decoded) && requestId == 42 &&
+                         decoded.success && decoded.message == original.message && decoded.data == original.data &&
+                         decoded.retryAfterMs == 250;
+        
+        // A partial frame waits for more bytes; a cut payload does not decode
+        std::string_view partial(frame.data(), frame.size() - 1);
+        bool waits = RpcProtocol::nextFrame(partial, payload, frameSize) == RpcProtocol::FrameStatus::Incomplete;
+        ServiceResponse truncated;
+        bool rejectsCut = !RpcProtocol::decodeResponse(std::string_view(frame).substr(4, frame.size() - 6),
+                                                       requestId, truncated);
+        
+        // Request IDs are stamped into finished frames just before sending
+        std::string requestFrame = RpcWriter(RpcOp::CastVote).add(7).add(-1).add("VA").finish();
+        RpcProtocol::setRequestId(requestFrame, 0x01020304);
+        RpcReader reader(std::string_view(requestFrame).substr(4));
+        uint32_t stamped = 0;
+        RpcOp op;
+        int32_t voterId = 0;
+        int32_t candidate = 0;
+        std::string region;
+        bool request = reader.read(stamped) && stamped == 0x01020304 && reader.read(op) && op == RpcOp::CastVote && reader.read(voterId) && reader.read(candidate) &&
+                       reader.read(region) && reader.atEnd() && voterId == 7 && candidate == -1 && region == "VA";
+        
+        return roundTrip && waits && rejectsCut && request;
+    }
+    
+    static bool testRemoteClientsShareElection() {
+        const std::string socketPath = "rpc_test_shared.sock";
+        ClearBallotService service;
+        service.startService();
+        RpcServer server(service);
+        if (!server.start(socketPath)) {
+            return false;
+        }
+        
+        ServiceClient admin;
+        ServiceClient kiosk;
+        bool connected = admin.connectToService(socketPath) && kiosk.connectToService(socketPath);
+        
+        // Both consoles land on the service's one seeded default election, so the vote below can succeed
+        auto candidates = kiosk.getCandidates(-1);
+        bool seeded = candidates.success;
+        bool registered = admin.registerVoter(-1, "Remote", "Voter", "5555550101", "1 Socket Way",
+                                              "424242424", "40").success;
+        bool voted = kiosk.castVote(-1, 424242424, 1).success;
+        auto status = admin.checkVoterRegistration(-1, 424242424);
+        bool seen = status.success && status.data.size() == 2 &&
+                    status.data[0] == "Registered: Yes" && status.data[1] == "Has Voted: Yes";
+        
+        // Regional operations and explicit election IDs travel the same way
+        int electionId = admin.createElection("Remote Regional Election");
+        bool regional = electionId > 0 && kiosk.electionExists(electionId) &&
+                        admin.createRegion(electionId, "North District", "ND").success &&
+                        admin.addCandidateToRegion(electionId, "Nora North", "North Party", "ND").success &&
+                        kiosk.registerVoterInRegion(electionId, "Nils", "Norden", "5555550102", "2 North Rd",
+                                                    "515151515", "33", "ND").success &&
+                        kiosk.castVoteInRegion(electionId, 515151515, 0, "ND").success;
+        auto regions = kiosk.getRegions(electionId);
+        auto results = admin.getRegionalResults(electionId, "ND");
+        bool listed = regions.success && regions.data.size() == 1 && results.success &&
+                      results.data.size() == 1 && results.data[0] == "Nora North: 1 votes";
+        
+        bool remoteHasNoElectionObject = admin.getElection(-1) == nullptr;
+        size_t served = server.getRequestsServed();
+        
+        admin.disconnect();
+        kiosk.disconnect();
+        server.stop();
+        bool cleanedUp = !server.isRunning() && ::access(socketPath.c_str(), F_OK) != 0;
+        service.stopService();
+        
+        return connected && seeded && registered && voted && seen && regional && listed &&
+               remoteHasNoElectionObject && served == 14 && cleanedUp;
+    }
+    
+    static bool testMalformedFramesAreContained() {
+        const std::string socketPath = "rpc_test_malformed.sock";
+        ClearBallotService service;
+        service.startService();
+        RpcServer server(service);
+        if (!server.start(socketPath)) {
+            return false;
+        }
+        
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, socketPath.c_str());
+        auto rawConnect = [&]() {
+            int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            return fd;
+        };
+        uint32_t nextId = 1;
+        auto exchange = [&nextId](int fd, std::string frame, ServiceResponse& response) {
+            uint32_t sentId = nextId++;
+            RpcProtocol::setRequestId(frame, sentId);
+            if (::send(fd, frame.data(), frame.size(), 0) != static_cast<ssize_t>(frame.size())) {
+                return false;
+            }
+            char header[4];
+            size_t length = 0;
+            if (::recv(fd, header, 4, MSG_WAITALL) != 4 || !RpcProtocol::payloadLength(header, length)) {
+                return false;
+            }
+            std::string payload(length, '\0');
+            uint32_t echoedId = 0;
+            return ::recv(fd, &payload[0], length, MSG_WAITALL) == static_cast<ssize_t>(length) &&
+                   RpcProtocol::decodeResponse(payload, echoedId, response) && echoedId == sentId;
+        };
+        
+        // Unknown operations and missing or extra arguments get error responses on a live connection
+        int fd = rawConnect();
+        ServiceResponse unknown, missing, extra, valid;
+        bool answered = exchange(fd, RpcWriter().add(0u).add(false).add(1).finish(), unknown) && !unknown.success &&
+                        exchange(fd, RpcWriter(RpcOp::CastVote).add(1).finish(), missing) && !missing.success &&
+                        exchange(fd, RpcWriter(RpcOp::GetDefaultElection).add(5).finish(), extra) && !extra.success &&
+                        exchange(fd, RpcWriter(RpcOp::GetDefaultElection).finish(), valid) && valid.success;
+        ::close(fd);
+        
+        // An oversized length prefix only drops that connection
+        int hostile = rawConnect();
+        const char oversized[4] = {'\xff', '\xff', '\xff', '\x7f'};
+        ::send(hostile, oversized, sizeof(oversized), 0);
+        char byte;
+        bool dropped = ::recv(hostile, &byte, 1, 0) == 0;
+        ::close(hostile);
+        
+        ServiceClient client;
+        bool stillServing = client.connectToService(socketPath) && client.getCandidates(-1).success;
+        client.disconnect();
+        server.stop();
+        service.stopService();
+        
+        return answered && unknown.message.find("Unknown operation") != std::string::npos &&
+               missing.message.find("Malformed") != std::string::npos && dropped && stillServing;
+    }
+    
+    static bool testAsyncVotesShareOneConnection() {
+        const std::string socketPath = "rpc_test_async.sock";
+        const int voters = 300;
+        ClearBallotService service;
+        service.startService();
+        RpcServer server(service);
+        if (!server.start(socketPath)) {
+            return false;
+        }
+        
+        ServiceClient aggregator;
+        bool connected = aggregator.connectToService(socketPath);
+        
+        // Every registration, then every vote, is in flight before the first answer is read
+        std::vector<std::future<ServiceResponse>> registrations;
+        for (int i = 0; i < voters; ++i) {
+            registrations.push_back(aggregator.registerVoterAsync(-1, "Kiosk", "Voter", "5555550103", "3 Queue St",
+                                                                  std::to_string(600000000 + i), "25"));
+        }
+        bool registered = true;
+        for (auto& registration : registrations) {
+            registered = registration.get().success && registered;
+        }
+        
+        std::vector<std::future<ServiceResponse>> votes;
+        for (int i = 0; i < voters / 2; ++i) {
+            votes.push_back(aggregator.castVoteAsync(-1, 600000000 + i, 0));
+        }
+        std::atomic<int> acknowledged{0};
+        std::promise<void> allAcknowledged;
+        for (int i = voters / 2; i < voters; ++i) {
+            aggregator.castVoteAsync(-1, 600000000 + i, 0, [&](const ServiceResponse& response) {
+                if (response.success && ++acknowledged == voters - voters / 2) {
+                    allAcknowledged.set_value();
+                }
+            });
+        }
+        bool voted = true;
+        for (auto& vote : votes) {
+            voted = vote.get().success && voted;
+        }
+        bool callbacksRan = allAcknowledged.get_future().wait_for(std::chrono::seconds(10)) ==
+                            std::future_status::ready;
+        
+        // A second vote from the same voter is still refused, asynchronously
+        bool duplicateRefused = !aggregator.castVoteAsync(-1, 600000000, 0).get().success;
+        auto results = aggregator.getElectionResultsAsync(-1).get();
+        int counted = 0;
+        for (const auto& line : results.data) {
+            size_t colon = line.rfind(": ");
+            counted += colon == std::string::npos ? 0 : std::stoi(line.substr(colon + 2));
+        }
+        
+        aggregator.disconnect();
+        bool refusedAfterDisconnect = !aggregator.castVoteAsync(-1, 600000000, 0).get().success;
+        server.stop();
+        service.stopService();
+        
+        return connected && registered && voted && callbacksRan && duplicateRefused &&
+               results.success && counted == voters && refusedAfterDisconnect;
+    }
+    
+    static bool testResponsesMatchedByRequestId() {
+        const std::string socketPath = "rpc_test_reorder.sock";
+        ::unlink(socketPath.c_str());
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, socketPath.c_str());
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 1) != 0) {
+            ::close(listener);
+            return false;
+        }
+        
+        // A stand-in server that reads four requests, answers the first three
+        // newest-first with their argument as the message, then hangs up
+        std::thread fakeServer([listener]() {
+            int fd = ::accept(listener, nullptr, nullptr);
+            std::vector<std::pair<uint32_t, int32_t>> requests;
+            while (requests.size() < 4) {
+                char header[4];
+                size_t length = 0;
+                if (::recv(fd, header, 4, MSG_WAITALL) != 4 || !RpcProtocol::payloadLength(header, length)) {
+                    break;
+                }
+                std::string payload(length, '\0');
+                ::recv(fd, &payload[0], length, MSG_WAITALL);
+                RpcReader reader(payload);
+                uint32_t requestId = 0;
+                RpcOp op;
+                int32_t argument = 0;
+                reader.read(requestId) && reader.read(op) && reader.read(argument);
+                requests.emplace_back(requestId, argument);
+            }
+            for (size_t i = std::min<size_t>(3, requests.size()); i-- > 0;) {
+                std::string frame;
+                RpcProtocol::encodeResponse(requests[i].first, ServiceResponse(true, std::to_string(requests[i].second)),
+                                            frame);
+                ::send(fd, frame.data(), frame.size(), 0);
+            }
+            ::close(fd);
+        });
+        
+        RpcChannel channel;
+        bool connected = channel.connect(socketPath);
+        std::vector<std::future<ServiceResponse>> replies;
+        for (int argument = 1; argument <= 4; ++argument) {
+            replies.push_back(channel.callAsync(RpcWriter(RpcOp::ElectionExists).add(argument).finish()));
+        }
+        bool matched = true;
+        for (int i = 0; i < 3; ++i) {
+            ServiceResponse reply = replies[i].get();
+            matched = reply.success && reply.message == std::to_string(i + 1) && matched;
+        }
+        // The unanswered request fails once the connection drops, instead of hanging
+        ServiceResponse orphaned = replies[3].get();
+        fakeServer.join();
+        bool failedOnHangUp = !orphaned.success && orphaned.message.find("Lost connection") != std::string::npos &&
+                              !channel.isOpen() && channel.getPendingCount() == 0;
+        channel.close();
+        ::close(listener);
+        ::unlink(socketPath.c_str());
+        
+        return connected && matched && failedOnHangUp;
+    }
+    
+    static bool testSharedMemoryTransport() {
+        const std::string socketPath = "rpc_test_shm.sock";
+        ClearBallotService service;
+        service.startService();
+        RpcServer server(service);
+        if (!server.start(socketPath)) {
+            return false;
+        }
+        
+        // Remote clients attach shared memory by default and behave exactly as over the socket
+        ServiceClient kiosk;
+        bool connected = kiosk.connectToService(socketPath);
+        bool registered = kiosk.registerVoter(-1, "Ring", "Voter", "5555550104", "4 Memory Ln",
+                                              "737373737", "52").success;
+        bool voted = kiosk.castVoteAsync(-1, 737373737, 0).get().success;
+        auto status = kiosk.checkVoterRegistration(-1, 737373737);
+        bool seen = status.success && status.data.size() == 2 && status.data[1] == "Has Voted: Yes";
+        
+        RpcChannel channel;
+        bool attached = channel.connect(socketPath) && channel.attachSharedMemory() && channel.usesSharedMemory();
+        uint64_t servedBefore = server.getRequestsServed();
+        // A request larger than a ring streams through it in pieces
+        std::string longTitle(3 * SharedMemoryRing::CAPACITY, 'T');
+        ServiceResponse created = channel.call(RpcWriter(RpcOp::CreateElection).add(longTitle).finish());
+        bool streamed = created.success && server.getRequestsServed() == servedBefore + 1;
+        // Attaching twice, or attaching through the ring itself, is refused
+        bool noReattach = !channel.call(RpcWriter(RpcOp::AttachSharedMemory).add("/clearballot-x").finish()).success;
+        
+        // Segment names are unlinked once both sides have them mapped
+        std::ifstream leftover("/dev/shm/clearballot-" + std::to_string(::getpid()) + "-1");
+        bool unlinked = !leftover.good();
+        
+        // The service going away fails the ring client instead of leaving it blocked
+        kiosk.disconnect();
+        server.stop();
+        ServiceResponse afterStop = channel.call(RpcWriter(RpcOp::GetDefaultElection).finish());
+        bool failedCleanly = !afterStop.success && !channel.isOpen();
+        service.stopService();
+        
+        return connected && registered && voted && seen && attached && streamed && noReattach &&
+               unlinked && failedCleanly;
+    }
+    
+    static bool testCorruptRingPositionsRejected() {
+        // The counters live in memory the other process can write to
+        auto shared = std::make_unique<SharedMemoryRing::Shared>();
+        SharedMemoryRing ring(*shared);
+        char buffer[16] = {};
+        
+        shared->head.store(SharedMemoryRing::CAPACITY + 1);
+        bool readRefused = !ring.read(buffer, sizeof(buffer)) && ring.isClosed();
+        
+        auto other = std::make_unique<SharedMemoryRing::Shared>();
+        SharedMemoryRing writer(*other);
+        other->tail.store(1);   // The reader claims to be ahead of everything written
+        bool writeRefused = !writer.write(buffer, sizeof(buffer)) && writer.isClosed();
+        
+        return readRefused && writeRefused;
+    }
+};
+
+// Work-stealing executor Tests
+class ExecutorTests {
+public:
+    static bool testHomeWorkerAffinity() {
+        WorkStealingExecutor::Options options;
+        options.workerThreads = 4;
+        WorkStealingExecutor executor(options);
+        
+        // With nothing else queued, every keyed task runs on its key's home worker
+        bool home = true;
+        for (uint64_t key = 1; key <= 12; ++key) {
+            std::promise<int> ranOn;
+            executor.submit(key, [&]() { ranOn.set_value(executor.currentWorker()); });
+            home = ranOn.get_future().get() == static_cast<int>(executor.homeWorker(key)) && home;
+        }
+        
+        // Unkeyed work submitted from a worker stays on that worker
+        std::promise<bool> stayed;
+        executor.submit(2, [&]() {
+            int parent = executor.currentWorker();
+            executor.submit([&, parent]() { stayed.set_value(executor.currentWorker() == parent); });
+        });
+        
+        return home && stayed.get_future().get() && executor.currentWorker() == -1 &&
+               executor.getWorkerCount() == 4 && executor.getTasksStolen() == 0;
+    }
+    
+    static bool testStealingUnderImbalance() {
+        WorkStealingExecutor::Options options;
+        options.workerThreads = 4;
+        WorkStealingExecutor executor(options);
+        
+        // Hold the home worker of key 7 and pile more work behind it
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::promise<void> holding;
+        executor.submit(7, [&]() {
+            holding.set_value();
+            released.wait();
+        });
+        holding.get_future().wait();
+        
+        const int backlog = 20;
+        std::atomic<int> done{0};
+        std::promise<void> allDone;
+        for (int i = 0; i < backlog; ++i) {
+            executor.submit(7, [&]() {
+                if (++done == backlog) {
+                    allDone.set_value();
+                }
+            });
+        }
+        bool stolen = allDone.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+        release.set_value();
+        executor.shutdown();
+        
+        return stolen && executor.getTasksStolen() >= static_cast<uint64_t>(backlog) &&
+               executor.getTasksExecuted() == static_cast<uint64_t>(backlog) + 1;
+    }
+    
+    static bool testShutdownRunsQueuedTasks() {
+        WorkStealingExecutor::Options options;
+        options.workerThreads = 3;
+        std::atomic<int> ran{0};
+        WorkStealingExecutor executor(options);
+        for (int i = 0; i < 1000; ++i) {
+            executor.submit(static_cast<uint64_t>(i), [&]() { ++ran; });
+        }
+        executor.submit(1, []() { throw std::runtime_error("contained"); });
+        executor.shutdown();
+        bool refused = !executor.submit([&]() { ++ran; });
+        return ran.load() == 1000 && refused && executor.getTasksExecuted() == 1001;
+    }
+    
+    static bool testRpcServerOnExecutor() {
+        const std::string socketPath = "rpc_test_executor.sock";
+        ClearBallotService service;
+        service.startService();
+        WorkStealingExecutor::Options options;
+        options.workerThreads = 4;
+        WorkStealingExecutor executor(options);
+        RpcServer server(service, &executor);
+        if (!server.start(socketPath)) {
+            return false;
+        }
+        
+        // Three elections over one connection, socket and shared-memory clients alike
+        ServiceClient viaSocket;
+        ServiceClient viaRing;
+        bool connected = viaSocket.connectToService(socketPath, ServiceClient::Transport::Socket) &&
+                         viaRing.connectToService(socketPath);
+        std::vector<int> elections;
+        for (int e = 0; e < 3; ++e) {
+            int id = viaSocket.createElection("Executor Election " + std::to_string(e));
+            viaSocket.addCandidate(id, "Candidate " + std::to_string(e));
+            elections.push_back(id);
+        }
+        
+        const int votersPerElection = 60;
+        std::vector<std::future<ServiceResponse>> pending;
+        for (int e = 0; e < 3; ++e) {
+            for (int v = 0; v < votersPerElection; ++v) {
+                pending.push_back(viaSocket.registerVoterAsync(elections[e], "Pool", "Voter", "5555550105",
+                                                               "5 Worker Way", std::to_string(700000000 + v), "44"));
+            }
+        }
+        bool registered = true;
+        for (auto& response : pending) {
+            registered = response.get().success && registered;
+        }
+        pending.clear();
+        for (int e = 0; e < 3; ++e) {
+            ServiceClient& client = e % 2 == 0 ? viaSocket : viaRing;
+            for (int v = 0; v < votersPerElection; ++v) {
+                pending.push_back(client.castVoteAsync(elections[e], 700000000 + v, 0));
+            }
+        }
+        bool voted = true;
+        for (auto& response : pending) {
+            voted = response.get().success && voted;
+        }
+        bool tallied = true;
+        for (int e = 0; e < 3; ++e) {
+            auto results = viaRing.getElectionResults(elections[e]);
+            tallied = results.success && results.data.size() == 1 &&
+                      results.data[0] == "Candidate " + std::to_string(e) + ": " +
+                                         std::to_string(votersPerElection) + " votes" && tallied;
+        }
+        
+        viaSocket.disconnect();
+        viaRing.disconnect();
+        server.stop();
+        service.stopService();
+        
+        return connected && registered && voted && tallied &&
+               executor.getTasksExecuted() >= static_cast<uint64_t>(6 * votersPerElection);
+    }
+};
+
+// Vote micro-batching Tests
+class VoteBatchingTests {
+public:
+    static bool testConcurrentBallotsShareBatches() {
+        VoteBatcher batcher(8);
+        std::mutex applyMutex;
+        std::vector<int> applied;
+        std::atomic<int> concurrentApplies{0};
+        std::atomic<bool> overlapped{false};
+        auto apply = [&](const std::vector<VoteBatcher::Ballot*>& batch) {
+            if (++concurrentApplies > 1) {
+                overlapped = true;
+            }
+            // Slow enough that the other callers pile up behind this batch
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::lock_guard<std::mutex> lock(applyMutex);
+            for (auto* ballot : batch) {
+                applied.push_back(ballot->voterId);
+                ballot->response = ServiceResponse(true, "vote " + std::to_string(ballot->voterId));
+            }
+            --concurrentApplies;
+        };
+        
+        const int threads = 8;
+        const int votesPerThread = 10;
+        std::atomic<int> answeredCorrectly{0};
+        std::vector<std::thread> voters;
+        for (int t = 0; t < threads; ++t) {
+            voters.emplace_back([&, t]() {
+                for (int v = 0; v < votesPerThread; ++v) {
+                    int voterId = t * 1000 + v;
+                    ServiceResponse response = batcher.submit(voterId, 0, apply);
+                    if (response.success && response.message == "vote " + std::to_string(voterId)) {
+                        ++answeredCorrectly;
+                    }
+                }
+            });
+        }
+        for (auto& voter : voters) {
+            voter.join();
+        }
+        
+        // Every caller got its own answer, batches never ran concurrently or over the limit
+        return answeredCorrectly.load() == threads * votesPerThread &&
+               applied.size() == static_cast<size_t>(threads * votesPerThread) && !overlapped.load() &&
+               batcher.getBallotCount() == static_cast<uint64_t>(threads * votesPerThread) &&
+               batcher.getBatchCount() < batcher.getBallotCount() &&
+               batcher.getLargestBatch() > 1 && batcher.getLargestBatch() <= 8;
+    }
+    
+    static bool testServiceCountsBatchedVotes() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.createElection("Batched Election");
+        service.addCandidate(electionId, "Batch Candidate");
+        const int threads = 4;
+        const int votersPerThread = 40;
+        for (int i = 0; i < threads * votersPerThread; ++i) {
+            service.registerVoter(electionId, VoterRegistrationData("Batch", "Voter", "5555550106", "6 Combine Ct",
+                                                                    std::to_string(800000000 + i), "61"));
+        }
+        
+        // Every voter votes twice from different threads; exactly one vote each must count
+        std::atomic<int> accepted{0};
+        std::vector<std::thread> kiosks;
+        for (int t = 0; t < threads; ++t) {
+            kiosks.emplace_back([&, t]() {
+                for (int round = 0; round < 2; ++round) {
+                    for (int i = 0; i < votersPerThread; ++i) {
+                        int voter = ((t + round) % threads) * votersPerThread + i;
+                        if (service.castVote(electionId, 800000000 + voter, 0).success) {
+                            ++accepted;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& kiosk : kiosks) {
+            kiosk.join();
+        }
+        
+        auto results = service.getElectionResults(electionId);
+        auto stats = service.getVoteBatchStats();
+        bool missingElection = !service.castVote(9999, 800000000, 0).success;
+        service.stopService();
+        
+        return accepted.load() == threads * votersPerThread && results.data.size() == 1 &&
+               results.data[0] == "Batch Candidate: " + std::to_string(threads * votersPerThread) + " votes" &&
+               stats.votes == static_cast<uint64_t>(2 * threads * votersPerThread) && missingElection;
+    }
+};
+
+// Admission Control Tests
+class AdmissionTests {
+public:
+    static bool testVotesKeepReservedCapacity() {
+        AdmissionController::Options options;
+        options.read = {8, 0};
+        options.vote = {8, 0};
+        options.capacity = 4;
+        options.voteReserve = 2;
+        AdmissionController controller(options);
+        
+        // Reads fill the shared slots, then are refused at once with a hint
+        auto firstRead = controller.admit(1, OperationClass::Read);
+        auto secondRead = controller.admit(1, OperationClass::Read);
+        auto thirdRead = controller.admit(2, OperationClass::Read);
+        bool readsCapped = firstRead && secondRead && !thirdRead && thirdRead.getRetryAfterMs() > 0;
+        
+        // Votes still get the reserved slots, up to the overall capacity
+        auto firstVote = controller.admit(1, OperationClass::Vote);
+        auto secondVote = controller.admit(2, OperationClass::Vote);
+        auto thirdVote = controller.admit(1, OperationClass::Vote);
+        bool votesReserved = firstVote && secondVote && !thirdVote;
+        
+        // Released tickets free their slots
+        firstRead = AdmissionController::Ticket();
+        auto readAgain = controller.admit(2, OperationClass::Read);
+        return readsCapped && votesReserved && readAgain && controller.getRunning() == 4 &&
+               controller.getStats(OperationClass::Read).rejected == 1 &&
+               controller.getStats(OperationClass::Vote).rejected == 1;
+    }
+    
+    static bool testBoundedQueueWaitsThenRejects() {
+        AdmissionController::Options options;
+        options.bulk = {1, 1};
+        options.maxQueueWait = std::chrono::milliseconds(2000);
+        AdmissionController controller(options);
+        
+        auto running = controller.admit(7, OperationClass::Bulk);
+        std::atomic<bool> queuedAdmitted{false};
+        std::thread waiter([&]() {
+            auto ticket = controller.admit(7, OperationClass::Bulk);
+            queuedAdmitted = static_cast<bool>(ticket);
+        });
+        // Once the waiter holds the only queue slot, the next request is refused at once
+        for (int i = 0; i < 400 && controller.getQueued() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        auto refused = controller.admit(7, OperationClass::Bulk);
+        bool queueFull = !refused && refused.getRetryAfterMs() > 0;
+        // Other elections have their own lanes
+        auto otherElection = controller.admit(8, OperationClass::Bulk);
+        bool separateLane = static_cast<bool>(otherElection);
+        
+        running = AdmissionController::Ticket();
+        waiter.join();
+        // Lanes go away once idle, so a stream of made-up election IDs leaves nothing behind
+        otherElection = AdmissionController::Ticket();
+        for (int electionId = 1000; electionId < 1100; ++electionId) {
+            controller.admit(electionId, OperationClass::Bulk);
+        }
+        bool lanesDropped = controller.getLaneCount() == 0;
+        return queueFull && separateLane && queuedAdmitted.load() && lanesDropped &&
+               controller.getStats(OperationClass::Bulk).queued == 1;
+    }
+    
+    static bool testEventLoopThreadsNeverQueue() {
+        AdmissionController::Options options;
+        options.bulk = {1, 4};
+        options.maxQueueWait = std::chrono::milliseconds(2000);
+        AdmissionController controller(options);
+        
+        // A thread serving many connections is refused at once where another would wait
+        auto running = controller.admit(7, OperationClass::Bulk);
+        auto started = std::chrono::steady_clock::now();
+        AdmissionController::Ticket refused;
+        {
+            AdmissionController::NoQueueScope noQueue;
+            refused = controller.admit(7, OperationClass::Bulk);
+        }
+        auto waited = std::chrono::steady_clock::now() - started;
+        bool refusedAtOnce = !refused && refused.getRetryAfterMs() > 0 && waited < std::chrono::milliseconds(500);
+        
+        // Outside the scope the thread queues again
+        std::thread releaser([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            running = AdmissionController::Ticket();
+        });
+        auto queued = controller.admit(7, OperationClass::Bulk);
+        releaser.join();
+        return refusedAtOnce && static_cast<bool>(queued) &&
+               controller.getStats(OperationClass::Bulk).queued == 1;
+    }
+    
+    static bool testServiceRejectsWithRetryAfter() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.createElection("Admission Election");
+        service.addCandidate(electionId, "Steady Candidate");
+        service.registerVoter(electionId, VoterRegistrationData("Admit", "Voter", "5555550107", "7 Gate Rd",
+                                                                "810000000", "52"));
+        
+        // Saturated lanes (no slots at all here) refuse bulk and read work...
+        AdmissionController::Options options = service.getAdmissionOptions();
+        options.bulk = {0, 0};
+        options.read = {0, 0};
+        service.setAdmissionOptions(options);
+        ServiceResponse voters = service.getVoters(electionId);
+        bool bulkRefused = !voters.success && voters.retryAfterMs > 0;
+        
+        HttpRequest request;
+        request.method = "GET";
+        request.path = "/elections/" + std::to_string(electionId) + "/results";
+        HttpResponse http = HttpApi(service).handle(request);
+        bool retryHeader = false;
+        for (const auto& header : http.headers) {
+            retryHeader = retryHeader || (header.first == "Retry-After" && header.second == "1");
+        }
+        
+        // ...while votes keep flowing
+        bool voted = service.castVote(electionId, 810000000, 0).success;
+        service.setAdmissionOptions(AdmissionController::Options());
+        ServiceResponse results = service.getElectionResults(electionId);
+        service.stopService();
+        
+        return bulkRefused && http.status == 503 && retryHeader && voted && results.success &&
+               results.data.size() == 1 && results.data[0] == "Steady Candidate: 1 votes";
+    }
+};
+
+// Background Job Tests
+class BackgroundJobTests {
+public:
+    static bool testJobsQueueRunAndCancel() {
+        BackgroundJobs::Options options;
+        options.maxQueued = 2;
+        BackgroundJobs pool(options);
+        
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<bool> started{false};
+        int running = pool.submit(1, "blocking", [&](std::atomic<int>& progress) {
+            progress.store(40);
+            started = true;
+            released.wait();
+            return ServiceResponse(true, "done");
+        });
+        for (int i = 0; i < 400 && !started.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        auto idle = [](std::atomic<int>&) { return ServiceResponse(true, "idle"); };
+        int queuedA = pool.submit(1, "queued", idle);
+        int queuedB = pool.submit(2, "queued", idle);
+        int refused = pool.submit(2, "over the limit", idle);
+        
+        BackgroundJobs::Status status;
+        bool runningSeen = pool.getStatus(running, status) && status.state == BackgroundJobs::State::Running &&
+                           status.progress == 40;
+        bool queuedSeen = pool.getStatus(queuedA, status) && status.state == BackgroundJobs::State::Queued;
+        size_t cancelled = pool.cancelQueued();
+        bool cancelledSeen = pool.getStatus(queuedB, status) && status.state == BackgroundJobs::State::Cancelled;
+        
+        release.set_value();
+        bool finished = false;
+        for (int i = 0; i < 400 && !finished; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            finished = pool.getStatus(running, status) && status.state == BackgroundJobs::State::Succeeded;
+        }
+        pool.shutdown();
+        
+        return started.load() && refused == -1 && runningSeen && queuedSeen && cancelled == 2 && cancelledSeen &&
+               finished && status.progress == 100 && status.result.message == "done" &&
+               pool.submit(1, "after shutdown", idle) == -1;
+    }
+    
+    static bool testExportJobWhileVoting() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.createElection("Background Export Election");
+        service.addCandidate(electionId, "Export Candidate");
+        const int voters = 200;
+        for (int i = 0; i < voters; ++i) {
+            service.registerVoter(electionId, VoterRegistrationData("Job", "Voter", "5555550108", "8 Queue St",
+                                                                    std::to_string(820000000 + i), "47"));
+        }
+        
+        const std::string base = "background_job_export";
+        ServiceResponse started = service.startBulkJob(electionId, BulkOperation::ExportCsv, base);
+        int jobId = started.success && started.data.size() == 1 ? std::stoi(started.data[0].substr(8)) : -1;
+        
+        // Votes keep being answered while the export is queued or running; the
+        // election is only locked while the rows are rendered, not for the file I/O
+        int accepted = 0;
+        auto slowestVote = std::chrono::steady_clock::duration::zero();
+        for (int i = 0; i < voters; ++i) {
+            auto before = std::chrono::steady_clock::now();
+            if (service.castVote(electionId, 820000000 + i, 0).success) {
+                ++accepted;
+            }
+            slowestVote = std::max(slowestVote, std::chrono::steady_clock::now() - before);
+        }
+        bool votesStayedFast = slowestVote < std::chrono::milliseconds(100);
+        
+        ServiceResponse status;
+        for (int i = 0; i < 1000; ++i) {
+            status = service.getJobStatus(electionId, jobId);
+            if (!status.success || status.data.empty() ||
+                (status.data[0] != "State: Queued" && status.data[0] != "State: Running")) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        bool succeeded = status.success && status.data.size() >= 4 && status.data[0] == "State: Succeeded" &&
+                         status.data[1] == "Progress: 100%";
+        bool otherElection = !service.getJobStatus(electionId + 1, jobId).success;
+        bool unknownOperation = !service.startBulkJob(electionId, static_cast<BulkOperation>(99), base).success;
+        service.stopService();
+        
+        bool filesWritten = true;
+        for (const char* suffix : {"_candidates.csv", "_voters.csv", "_parties.csv"}) {
+            std::string filename = base + suffix;
+            filesWritten = filesWritten && std::ifstream(filename).good();
+            std::remove(filename.c_str());
+        }
+        
+        return jobId > 0 && accepted == voters && votesStayedFast && succeeded && otherElection && unknownOperation &&
+               filesWritten;
+    }
+    
+    static bool testImportAndLoadJobs() {
+        ClearBallotService service;
+        service.startService();
+        
+        // A roll to import and a snapshot to load, written from elections of their own
+        int rollId = service.createElection("Roll Source");
+        const int rollVoters = 3000;
+        for (int i = 0; i < rollVoters; ++i) {
+            service.registerVoter(rollId, VoterRegistrationData("Roll", "Voter", "5555550109", "9 Roll Road",
+                                                                std::to_string(830000000 + i), "39"));
+        }
+        const std::string rollBase = "background_job_roll";
+        service.exportElectionToCSV(rollId, rollBase);
+        const std::string snapshot = "background_job_snapshot.txt";
+        int snapshotId = service.createElection("Snapshot Source");
+        service.addCandidate(snapshotId, "Snapshot Candidate");
+        service.saveCompleteElectionData(snapshotId, snapshot);
+        
+        int electionId = service.createElection("Background Import Election");
+        service.addCandidate(electionId, "Import Candidate");
+        const int voters = 200;
+        for (int i = 0; i < voters; ++i) {
+            service.registerVoter(electionId, VoterRegistrationData("Job", "Voter", "5555550110", "10 Queue St",
+                                                                    std::to_string(840000000 + i), "47"));
+        }
+        
+        auto startJob = [&service](int id, BulkOperation operation, const std::string& filename) {
+            ServiceResponse started = service.startBulkJob(id, operation, filename);
+            return started.success && started.data.size() == 1 ? std::stoi(started.data[0].substr(8)) : -1;
+        };
+        auto finish = [&service](int id, int jobId) {
+            ServiceResponse status;
+            for (int i = 0; i < 1000; ++i) {
+                status = service.getJobStatus(id, jobId);
+                if (!status.success || status.data.empty() ||
+                    (status.data[0] != "State: Queued" && status.data[0] != "State: Running")) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            return status;
+        };
+        
+        // The roll is read and validated without the election's lock, so votes
+        // wait at most for the rows to be registered
+        int importJob = startJob(electionId, BulkOperation::ImportVoters, rollBase + "_voters.csv");
+        int accepted = 0;
+        auto slowestVote = std::chrono::steady_clock::duration::zero();
+        for (int i = 0; i < voters; ++i) {
+            auto before = std::chrono::steady_clock::now();
+            if (service.castVote(electionId, 840000000 + i, 0).success) {
+                ++accepted;
+            }
+            slowestVote = std::max(slowestVote, std::chrono::steady_clock::now() - before);
+        }
+        bool votesStayedFast = slowestVote < std::chrono::milliseconds(100);
+        ServiceResponse imported = finish(electionId, importJob);
+        bool importSucceeded = imported.success && imported.data.size() >= 5 &&
+                               imported.data[0] == "State: Succeeded" && imported.data[1] == "Progress: 100%" &&
+                               std::find(imported.data.begin(), imported.data.end(),
+                                         "Imported: " + std::to_string(rollVoters)) != imported.data.end();
+        
+        // A load swaps in a freshly parsed election...
+        int loadedId = service.createElection("Placeholder");
+        ServiceResponse loaded = finish(loadedId, startJob(loadedId, BulkOperation::LoadData, snapshot));
+        bool loadSucceeded = loaded.success && !loaded.data.empty() && loaded.data[0] == "State: Succeeded" &&
+                             service.getElectionTitle(loadedId) == "Snapshot Source";
+        // ...except into an election handed out by getElection, which is reloaded in place
+        std::shared_ptr<Election> held = service.getElection(electionId);
+        bool heldReloaded = held && service.loadElectionData(electionId, snapshot).success &&
+                            service.getElection(electionId) == held && held->getTitle() == "Snapshot Source" &&
+                            held->getVoters().empty();
+        bool missingFileKept = !service.loadElectionData(loadedId, "background_job_missing.txt").success &&
+                               service.getElectionTitle(loadedId) == "Snapshot Source";
+        service.stopService();
+        
+        std::remove(snapshot.c_str());
+        for (const char* suffix : {"_candidates.csv", "_voters.csv", "_parties.csv"}) {
+            std::remove((rollBase + suffix).c_str());
+        }
+        
+        return importJob > 0 && accepted == voters && votesStayedFast && importSucceeded && loadSucceeded &&
+               heldReloaded && missingFileKept;
+    }
+};
+
+// HTTP API Tests
+class HttpTests {
+public:
+    static bool testRequestParsing() {
+        std::string pipelined =
+            "POST /elections/1/votes HTTP/1.1\r\nHost: x\r\ncontent-length: 7\r\n\r\n{\"a\":1}"
+            "GET /elections/1/results?verbose=1 HTTP/1.0\r\nConnection: keep-alive\r\n\r\n"
+            "GET /health HTTP/1.1\r\nConnection: close\r\n\r\n"
+            "GET /partial HTTP/1.1\r\nHost:";
+        std::string_view buffer(pipelined);
+        HttpRequest first, second, third, fourth;
+        size_t size = 0;
+        int error = 0;
+        bool ok = HttpProtocol::parseRequest(buffer, first, size, error) == HttpProtocol::ParseStatus::Complete &&
+                  first.method == "POST" && first.path == "/elections/1/votes" && first.body == "{\"a\":1}" &&
+                  first.keepAlive;
+        buffer.remove_prefix(size);
+        ok = ok && HttpProtocol::parseRequest(buffer, second, size, error) == HttpProtocol::ParseStatus::Complete &&
+             second.path == "/elections/1/results" && second.query == "verbose=1" && second.keepAlive;
+        buffer.remove_prefix(size);
+        ok = ok && HttpProtocol::parseRequest(buffer, third, size, error) == HttpProtocol::ParseStatus::Complete &&
+             third.path == "/health" && !third.keepAlive;
+        buffer.remove_prefix(size);
+        ok = ok && HttpProtocol::parseRequest(buffer, fourth, size, error) == HttpProtocol::ParseStatus::Incomplete;
+        
+        // Chunked bodies, oversized headers and garbage are refused with a status
+        int chunked = 0, oversized = 0, garbage = 0;
+        HttpRequest rejected;
+        HttpProtocol::parseRequest("POST /x HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", rejected, size, chunked);
+        HttpProtocol::parseRequest(std::string(HttpProtocol::MAX_HEADER_SIZE + 1, 'A'), rejected, size, oversized);
+        HttpProtocol::parseRequest("NONSENSE\r\n\r\n", rejected, size, garbage);
+        
+        std::string response;
+        HttpProtocol::writeResponse(HttpResponse(200, "{}"), false, response);
+        bool written = response == "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\n"
+                                   "Connection: close\r\n\r\n{}";
+        
+        return ok && chunked == 501 && oversized == 431 && garbage == 400 && written;
+    }
+    
+    static bool testPipelinedKeepAliveRequests() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.getDefaultElection();
+        service.registerVoter(electionId, VoterRegistrationData("Hana", "Http", "5555550103", "3 Web St",
+                                                                "616161616", "29"));
+        HttpServer server(service);
+        HttpServer::Options options;
+        options.port = 0;
+        options.workerThreads = 2;
+        if (!server.start(options)) {
+            return false;
+        }
+        
+        int fd = connectHttp(server.getPort());
+        std::string body = "{\"voterId\": 616161616, \"candidateIndex\": 2}";
+        std::string requests =
+            "POST /elections/default/votes HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) +
+            "\r\n\r\n" + body +
+            "GET /elections/default/voters/616161616 HTTP/1.1\r\n\r\n"
+            "GET /elections/" + std::to_string(electionId) + "/results HTTP/1.1\r\n\r\n"
+            "POST /elections/default/votes HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) +
+            "\r\n\r\n" + body +
+            "GET /elections/404/results HTTP/1.1\r\n\r\n";
+        ::send(fd, requests.data(), requests.size(), 0);
+        std::vector<std::string> responses = readHttpResponses(fd, 5);
+        
+        // Same connection, then an explicit close
+        std::string last = "GET /health HTTP/1.1\r\nConnection: close\r\n\r\n";
+        ::send(fd, last.data(), last.size(), 0);
+        std::vector<std::string> closing = readHttpResponses(fd, 1);
+        char byte;
+        bool closed = ::recv(fd, &byte, 1, 0) == 0;
+        ::close(fd);
+        server.stop();
+        service.stopService();
+        
+        return responses.size() == 5 &&
+               responses[0].find("HTTP/1.1 200") == 0 && responses[0].find("\"success\":true") != std::string::npos &&
+               responses[1].find("\"registered\":true,\"hasVoted\":true") != std::string::npos &&
+               responses[2].find("{\"candidate\":\"Carol Green\",\"votes\":1}") != std::string::npos &&
+               responses[3].find("HTTP/1.1 422") == 0 &&
+               responses[4].find("HTTP/1.1 404") == 0 &&
+               closing.size() == 1 && closing[0].find("Connection: close") != std::string::npos && closed;
+    }
+    
+    static bool testConcurrentVotesAcrossWorkers() {
+        ClearBallotService service;
+        service.startService();
+        int electionId = service.createElection("HTTP Concurrency Election");
+        service.addCandidate(electionId, "Only Candidate");
+        const int clients = 4;
+        const int votesPerClient = 50;
+        for (int i = 0; i < clients * votesPerClient; ++i) {
+            service.registerVoter(electionId, VoterRegistrationData("Con", "Current", "5555550104", "4 Thread Ln",
+                                                                    std::to_string(700000000 + i), "35"));
+        }
+        HttpServer server(service);
+        HttpServer::Options options;
+        options.port = 0;
+        options.workerThreads = 4;
+        if (!server.start(options)) {
+            return false;
+        }
+        
+        std::atomic<int> accepted{0};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c]() {
+                int fd = connectHttp(server.getPort());
+                std::string batch;
+                for (int v = 0; v < votesPerClient; ++v) {
+                    std::string body = "{\"voterId\":" + std::to_string(700000000 + c * votesPerClient + v) +
+                                       ",\"candidateIndex\":0}";
+                    batch += "POST /elections/" + std::to_string(electionId) + "/votes HTTP/1.1\r\n"
+                             "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+                }
+                ::send(fd, batch.data(), batch.size(), 0);
+                for (const auto& response : readHttpResponses(fd, votesPerClient)) {
+                    if (response.find("HTTP/1.1 200") == 0) {
+                        accepted++;
+                    }
+                }
+                ::close(fd);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        ServiceResponse results = service.getElectionResults(electionId);
+        server.stop();
+        service.stopService();
+        
+        return accepted.load() == clients * votesPerClient && results.data.size() == 1 &&
+               results.data[0] == "Only Candidate: " + std::to_string(clients * votesPerClient) + " votes";
+    }
+    
+private:
+    static int connectHttp(uint16_t port) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        return fd;
+    }
+    
+    // Reads count complete responses (headers and Content-Length body)
+    static std::vector<std::string> readHttpResponses(int fd, size_t count) {
+        std::vector<std::string> responses;
+        std::string buffer;
+        char chunk[4096];
+        while (responses.size() < count) {
+            size_t headerEnd = buffer.find("\r\n\r\n");
+            size_t lengthAt = buffer.find("Content-Length: ");
+            if (headerEnd != std::string::npos && lengthAt != std::string::npos && lengthAt < headerEnd) {
+                size_t total = headerEnd + 4 + std::stoul(buffer.substr(lengthAt + 16));
+                if (buffer.size() >= total) {
+                    responses.push_back(buffer.substr(0, total));
+                    buffer.erase(0, total);
+                    continue;
+                }
+            }
+            ssize_t bytes = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (bytes <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(bytes));
+        }
+        return responses;
+    }
+};
+
 int main() {
     std::cout << "=== ClearBallot Service Architecture Tests ===\n\n";
     
@@ -283,6 +1576,11 @@ int main() {
     runner.runTest("Invalid Election Handling", ServiceArchitectureTests::testInvalidElectionHandling);
     runner.runTest("Concurrent Election Access", ServiceArchitectureTests::testConcurrentElectionAccess);
     runner.runTest("Service Delegation", ServiceArchitectureTests::testServiceDelegation);
+    runner.runTest("Election Directory Lookups", ServiceArchitectureTests::testElectionDirectoryLookups);
+    runner.runTest("Cold Elections Evicted And Reloaded", ServiceArchitectureTests::testColdElectionsEvictedAndReloaded);
+    runner.runTest("Per-Election Memory Accounting", ServiceArchitectureTests::testPerElectionMemoryAccounting);
+    runner.runTest("Parallel Shutdown Persistence", ServiceArchitectureTests::testParallelShutdownPersistence);
+    runner.runTest("Failed Shutdown Save Keeps Snapshot", ServiceArchitectureTests::testFailedShutdownSaveKeepsSnapshot);
     
     // ServiceClient Tests
     std::cout << "\n--- ServiceClient Tests ---\n";
@@ -292,6 +1590,47 @@ int main() {
     runner.runTest("Backward Compatibility", ServiceClientTests::testBackwardCompatibility);
     runner.runTest("Multiple Client Connections", ServiceClientTests::testMultipleClientConnections);
     
+    // RPC Tests
+    std::cout << "\n--- RPC Tests ---\n";
+    runner.runTest("Protocol Round Trip", RpcTests::testProtocolRoundTrip);
+    runner.runTest("Remote Clients Share Election", RpcTests::testRemoteClientsShareElection);
+    runner.runTest("Malformed Frames Are Contained", RpcTests::testMalformedFramesAreContained);
+    runner.runTest("Async Votes Share One Connection", RpcTests::testAsyncVotesShareOneConnection);
+    runner.runTest("Responses Matched By Request ID", RpcTests::testResponsesMatchedByRequestId);
+    runner.runTest("Shared Memory Transport", RpcTests::testSharedMemoryTransport);
+    runner.runTest("Corrupt Ring Positions Rejected", RpcTests::testCorruptRingPositionsRejected);
+    
+    // Executor Tests
+    std::cout << "\n--- Work-Stealing Executor Tests ---\n";
+    runner.runTest("Home Worker Affinity", ExecutorTests::testHomeWorkerAffinity);
+    runner.runTest("Stealing Under Imbalance", ExecutorTests::testStealingUnderImbalance);
+    runner.runTest("Shutdown Runs Queued Tasks", ExecutorTests::testShutdownRunsQueuedTasks);
+    runner.runTest("RPC Server On Executor", ExecutorTests::testRpcServerOnExecutor);
+    
+    // Vote Batching Tests
+    std::cout << "\n--- Vote Batching Tests ---\n";
+    runner.runTest("Concurrent Ballots Share Batches", VoteBatchingTests::testConcurrentBallotsShareBatches);
+    runner.runTest("Service Counts Batched Votes", VoteBatchingTests::testServiceCountsBatchedVotes);
+    
+    // Admission Control Tests
+    std::cout << "\n--- Admission Control Tests ---\n";
+    runner.runTest("Votes Keep Reserved Capacity", AdmissionTests::testVotesKeepReservedCapacity);
+    runner.runTest("Bounded Queue Waits Then Rejects", AdmissionTests::testBoundedQueueWaitsThenRejects);
+    runner.runTest("Event Loop Threads Never Queue", AdmissionTests::testEventLoopThreadsNeverQueue);
+    runner.runTest("Service Rejects With Retry-After", AdmissionTests::testServiceRejectsWithRetryAfter);
+    
+    // Background Job Tests
+    std::cout << "\n--- Background Job Tests ---\n";
+    runner.runTest("Jobs Queue, Run And Cancel", BackgroundJobTests::testJobsQueueRunAndCancel);
+    runner.runTest("Export Job While Voting", BackgroundJobTests::testExportJobWhileVoting);
+    runner.runTest("Import And Load Jobs", BackgroundJobTests::testImportAndLoadJobs);
+    
+    // HTTP Tests
+    std::cout << "\n--- HTTP API Tests ---\n";
+    runner.runTest("Request Parsing", HttpTests::testRequestParsing);
+    runner.runTest("Pipelined Keep-Alive Requests", HttpTests::testPipelinedKeepAliveRequests);
+    runner.runTest("Concurrent Votes Across Workers", HttpTests::testConcurrentVotesAcrossWorkers);
+    
     runner.printSummary();
     
     return runner.allTestsPassed() ? 0 : 1;
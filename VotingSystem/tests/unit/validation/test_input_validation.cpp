@@ -1,4 +1,5 @@
 #include "InputValidator.h"
+#include "ValidationRules.h"
 #include <iostream>
 #include <vector>
 #include <functional>
@@ -76,6 +77,29 @@ public:
                !InputValidator::isValidName("John-Doe") &&   // Hyphen
                !InputValidator::isValidName("O'Connor");     // Apostrophe
     }
+    
+    static bool testUtf8Names() {
+        std::string fiftyCyrillic, fiftyOneCyrillic;
+        for (int i = 0; i < 50; ++i) {
+            fiftyCyrillic += "Ж";   // Two bytes each; lengths count characters
+        }
+        fiftyOneCyrillic = fiftyCyrillic + "Ж";
+        return InputValidator::isValidName("José") &&
+               InputValidator::isValidName("Zoë Ångström") &&
+               InputValidator::isValidName("Иван Петров") &&
+               InputValidator::isValidName("王小明") &&
+               InputValidator::isValidName("देवनागरी") &&          // Letters with combining vowel signs
+               InputValidator::isValidName("Jose\xCC\x81") &&      // e + combining acute
+               InputValidator::isValidName(fiftyCyrillic) &&
+               !InputValidator::isValidName(fiftyOneCyrillic) &&
+               !InputValidator::isValidName("É") &&                 // One character, two bytes
+               !InputValidator::isValidName("\xCC\x81Jose") &&      // Mark with no letter before it
+               !InputValidator::isValidName("Jo\xF0\x9F\x98\x80") && // Emoji
+               !InputValidator::isValidName("Ann\xC2\xA0Lee") &&    // No-break space
+               InputValidator::checkName("Jos\xC3") == InputValidator::Problem::InvalidEncoding &&        // Truncated
+               InputValidator::checkName("Jo\xC0\xAF" "e") == InputValidator::Problem::InvalidEncoding && // Overlong
+               InputValidator::checkName("Jo\xED\xA0\x80") == InputValidator::Problem::InvalidEncoding; // Surrogate
+    }
 };
 
 // Phone Validation Tests
@@ -256,11 +280,67 @@ public:
     
     static bool testUnicodeAndSpecialChars() {
         // Test unicode and special characters
-        return !InputValidator::isValidName("Jöhn") &&       // Unicode
-               !InputValidator::isValidName("José") &&       // Accent
+        return InputValidator::isValidName("Jöhn") &&        // Letters of any script are names
+               !InputValidator::isValidName("J\xF6hn") &&    // Latin-1, not UTF-8
                !InputValidator::isValidPhoneNumber("１２３４５６７８９０") && // Full-width numbers
                !InputValidator::isValidAddress("测试地址");    // Chinese characters
     }
+    
+    static bool testFailureMaskMatchesMessages() {
+        // The view checks report per field, and render the same text as the string API
+        using Field = InputValidator::Field;
+        using Problem = InputValidator::Problem;
+        int id = 0, age = 0;
+        InputValidator::Failures valid = InputValidator::checkVoterInput(
+            " John ", "Doe", "1234567890", "123 Main Street", "123456789", " 25 ", &id, &age);
+        if (!valid.ok() || id != 123456789 || age != 25 || !valid.describe().empty()) {
+            return false;
+        }
+        
+        InputValidator::Failures failures = InputValidator::checkVoterInput(
+            "J0hn", "", "12345", "123 Main Street", "12345678a", "99999999999");
+        return failures.get(Field::FirstName) == Problem::InvalidCharacters &&
+               failures.get(Field::LastName) == Problem::Empty &&
+               failures.get(Field::Phone) == Problem::WrongLength &&
+               failures.get(Field::Address) == Problem::None &&
+               failures.get(Field::UniqueId) == Problem::InvalidCharacters &&
+               failures.get(Field::Age) == Problem::Overflow &&
+               failures.describe() == InputValidator::validateVoterInput(
+                   "J0hn", "", "12345", "123 Main Street", "12345678a", "99999999999");
+    }
+    
+    // Narrower name limits than any registered jurisdiction, so the batch
+    // check is seen to take its limits from the rules
+    struct ShortNameRules : StandardRules {
+        static constexpr const char* NAME = "short-names";
+        static const size_t MIN_NAME_LENGTH = 3;
+        static const size_t MAX_NAME_LENGTH = 8;
+    };
+
+    static bool testBatchMatchesSingleChecks() {
+        // Enough rows for a partial second block, and the edge cases of a name
+        std::vector<std::string> samples = {
+            "", " ", "A", "Al", "Mary Ann", " John ", "J0hn", "José", "Tab\tName", "Иван Петров", "É", "Jo\xC0\xAF",
+            std::string(50, 'a'), std::string(51, 'a'), std::string(70, 'b'), "１２３", "123 Main Street"
+        };
+        std::vector<std::string_view> column;
+        for (int i = 0; i < 3; ++i) {
+            column.insert(column.end(), samples.begin(), samples.end());
+        }
+        
+        using Problem = InputValidator::Problem;
+        using Short = RuleValidator<ShortNameRules>;
+        InputValidator::RowBitmap names = InputValidator::checkNames(column.data(), column.size());
+        InputValidator::RowBitmap shortNames = Short::checkNames(column.data(), column.size());
+        for (size_t i = 0; i < column.size(); ++i) {
+            if (names.test(i) != (InputValidator::checkName(column[i]) == Problem::None) ||
+                shortNames.test(i) != (Short::checkName(column[i]) == Problem::None)) {
+                return false;
+            }
+        }
+        std::cout << "[" << InputValidator::batchSimdLevel() << "] ";
+        return names.count() == 3 * 7 && shortNames.count() == 3 * 4;
+    }
 };
 
 int main() {
@@ -274,6 +354,7 @@ int main() {
     runner.runTest("Invalid Names", NameValidationTests::testInvalidNames);
     runner.runTest("Name Boundary Conditions", NameValidationTests::testNameBoundaryConditions);
     runner.runTest("Name Special Cases", NameValidationTests::testNameSpecialCases);
+    runner.runTest("UTF-8 Names", NameValidationTests::testUtf8Names);
     
     // Phone Validation Tests
     std::cout << "\n--- Phone Validation Tests ---\n";
@@ -309,6 +390,8 @@ int main() {
     runner.runTest("Complete Invalid Data Set", ComprehensiveValidationTests::testCompleteInvalidDataSet);
     runner.runTest("Security Validation", ComprehensiveValidationTests::testSecurityValidation);
     runner.runTest("Unicode and Special Chars", ComprehensiveValidationTests::testUnicodeAndSpecialChars);
+    runner.runTest("Failure Mask Matches Messages", ComprehensiveValidationTests::testFailureMaskMatchesMessages);
+    runner.runTest("Batch Matches Single Checks", ComprehensiveValidationTests::testBatchMatchesSingleChecks);
     
     runner.printSummary();
     